@@ -0,0 +1,197 @@
+// Micro-benchmarks for one generated station header.
+//
+// Build with the header directory on the include path and the header name in
+// HARMOCLIMAT_BENCH_HEADER, e.g.
+//   g++ -std=c++20 -O3 -march=native -Igenerated/templates -DHARMOCLIMAT_BENCH_HEADER='"fr_bourges.hpp"' cpp/bench/bench_templates.cpp
+// Usage: bench_templates [min_seconds_per_case]
+// Prints one JSON object on stdout. `python main.py bench` drives it over every
+// header and flag set and merges the results.
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HARMOCLIMAT_BENCH_TSC 1
+#endif
+
+#ifndef HARMOCLIMAT_BENCH_HEADER
+#error "Define HARMOCLIMAT_BENCH_HEADER to the station header to benchmark"
+#endif
+#include HARMOCLIMAT_BENCH_HEADER
+
+namespace {
+
+constexpr std::size_t workload_size = 1 << 14;
+constexpr std::int64_t workload_start_unix = 1577836800;  // 2020-01-01T00:00:00Z
+
+struct Workload {
+    const char* name;
+    std::vector<double> day_utc;
+    std::vector<double> hour_utc;
+    std::vector<std::int64_t> unix_seconds;
+};
+
+// Uniform over twenty years, or one-minute steps from 2020-01-01.
+Workload make_workload(bool sequential){
+    Workload w{sequential ? "sequential" : "random", {}, {}, {}};
+    w.day_utc.resize(workload_size);
+    w.hour_utc.resize(workload_size);
+    w.unix_seconds.resize(workload_size);
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<std::int64_t> second(0, 20 * 365 * 86400LL);
+    for (std::size_t i = 0; i < workload_size; ++i) {
+        const std::int64_t offset = sequential ? static_cast<std::int64_t>(i) * 60 : second(rng);
+        w.unix_seconds[i] = workload_start_unix + offset;
+        const std::int64_t since_epoch = w.unix_seconds[i] - 946684800;
+        w.day_utc[i] = static_cast<double>(since_epoch / 86400);
+        w.hour_utc[i] = static_cast<double>(since_epoch % 86400) / 3600.0;
+    }
+    return w;
+}
+
+std::uint64_t ticks(){
+#if defined(HARMOCLIMAT_BENCH_TSC)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+volatile double sink;
+
+struct Result {
+    std::string name;
+    const char* mode;
+    const char* workload;
+    double ns_per_eval;
+    double cycles_per_eval;
+};
+
+// Repeats body (which performs evals_per_call evaluations) until min_seconds has
+// elapsed, five times, and keeps the fastest round.
+template <class Body>
+Result measure(const std::string& name, const char* mode, const char* workload, double min_seconds,
+               std::size_t evals_per_call, Body&& body){
+    using clock = std::chrono::steady_clock;
+    double best_ns = 1e300, best_cycles = 1e300;
+    for (int round = 0; round < 5; ++round) {
+        std::size_t calls = 0;
+        const auto start = clock::now();
+        const std::uint64_t start_ticks = ticks();
+        double elapsed = 0.0;
+        do {
+            body();
+            ++calls;
+            elapsed = std::chrono::duration<double>(clock::now() - start).count();
+        } while (elapsed < min_seconds / 5.0);
+        const double evals = static_cast<double>(calls * evals_per_call);
+        best_ns = std::min(best_ns, elapsed * 1e9 / evals);
+        best_cycles = std::min(best_cycles, static_cast<double>(ticks() - start_ticks) / evals);
+    }
+    return {name, mode, workload, best_ns, best_cycles};
+}
+
+// Scalar cases in two modes: "throughput" issues independent calls, "latency"
+// makes each input index depend on the previous result so calls serialise.
+template <class Eval>
+void scalar_cases(std::vector<Result>& out, const std::string& name, const Workload& w, double min_seconds, Eval eval){
+    out.push_back(measure(name, "throughput", w.name, min_seconds, workload_size, [&]{
+        double acc = 0.0;
+        for (std::size_t i = 0; i < workload_size; ++i) acc += eval(w.day_utc[i], w.hour_utc[i]);
+        sink = acc;
+    }));
+    out.push_back(measure(name, "latency", w.name, min_seconds, workload_size, [&]{
+        std::size_t i = 0;
+        double value = 0.0;
+        for (std::size_t n = 0; n < workload_size; ++n) {
+            value = eval(w.day_utc[i], w.hour_utc[i]);
+            i = (i + 1 + (value > 1e300 ? 1 : 0)) & (workload_size - 1);
+        }
+        sink = value;
+    }));
+}
+
+void run_workload(std::vector<Result>& out, const Workload& w, double min_seconds){
+    using namespace harmoclimat;
+    scalar_cases(out, "predict_temperature", w, min_seconds, [](double d, double h){ return predict_temperature(d, h); });
+    scalar_cases(out, "predict_specific_humidity", w, min_seconds,
+                 [](double d, double h){ return predict_specific_humidity(d, h); });
+    scalar_cases(out, "predict_pressure", w, min_seconds, [](double d, double h){ return predict_pressure(d, h); });
+    scalar_cases(out, "predict", w, min_seconds, [](double d, double h){
+        double t = 0.0, q = 0.0, p = 0.0;
+        predict(d, h, t, q, p);
+        return t + q + p;
+    });
+
+    std::vector<double> t(workload_size), q(workload_size), p(workload_size);
+    const auto batch = [&](const char* name, auto&& body){
+        out.push_back(measure(name, "throughput", w.name, min_seconds, workload_size, [&]{
+            body();
+            sink = t[workload_size / 2];
+        }));
+    };
+    batch("predict_batch", [&]{
+        predict_batch(w.day_utc.data(), w.hour_utc.data(), workload_size, t.data(), q.data(), p.data());
+    });
+    batch("predict_batch_unix", [&]{
+        predict_batch(w.unix_seconds.data(), workload_size, t.data(), q.data(), p.data());
+    });
+    const DayProfile profile = DayProfile::from_utc_day(w.day_utc[0]);
+    batch("day_profile_predict_batch", [&]{
+        profile.predict_batch(w.hour_utc.data(), workload_size, t.data(), q.data(), p.data());
+    });
+    // The stepper walks its own fixed-step timeline; the workload only sets its start.
+    batch("time_series_stepper_fill", [&]{
+        TimeSeriesStepper(w.day_utc[0], w.hour_utc[0], 1.0 / 60.0, workload_size).fill(t.data(), q.data(), p.data());
+    });
+    std::vector<double> durations(workload_size, 24.0 * 30.0);
+    batch("integrate_batch", [&]{
+        integrate_batch(w.day_utc.data(), w.hour_utc.data(), durations.data(), workload_size, t.data(), q.data(), p.data());
+    });
+}
+
+const char* simd_name(){
+#if defined(HARMOCLIMAT_DISABLE_SIMD)
+    return "scalar";
+#elif defined(__AVX512F__)
+    return "avx512";
+#elif defined(__AVX2__) && defined(__FMA__)
+    return "avx2";
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+}  // namespace
+
+int main(int argc, char** argv){
+    const double min_seconds = argc > 1 ? std::atof(argv[1]) : 0.25;
+    std::vector<Result> results;
+    for (bool sequential : {false, true}) run_workload(results, make_workload(sequential), min_seconds);
+
+    std::printf("{\n  \"header\": \"%s\",\n", HARMOCLIMAT_BENCH_HEADER);
+#if defined(__VERSION__)
+    std::printf("  \"compiler\": \"%s\",\n", __VERSION__);
+#endif
+    std::printf("  \"simd\": \"%s\",\n", simd_name());
+    std::printf("  \"cycles\": \"%s\",\n", ticks() ? "tsc" : "unavailable");
+    std::printf("  \"results\": [\n");
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        std::printf("    {\"name\": \"%s\", \"mode\": \"%s\", \"workload\": \"%s\", \"ns_per_eval\": %.4f, "
+                    "\"evals_per_s\": %.6g, \"cycles_per_eval\": ",
+                    r.name.c_str(), r.mode, r.workload, r.ns_per_eval, 1e9 / r.ns_per_eval);
+        if (ticks()) std::printf("%.4f}", r.cycles_per_eval);
+        else std::printf("null}");
+        std::printf("%s\n", i + 1 < results.size() ? "," : "");
+    }
+    std::printf("  ]\n}\n");
+    return 0;
+}
@@ -0,0 +1,18 @@
+// Proleptic Gregorian calendar arithmetic shared by the harmoclimat_grid tool
+// and the native archive ingester (header-only, C++17).
+#pragma once
+#include <cstdint>
+namespace harmoclimat {
+
+// Days since 1970-01-01 of a proleptic Gregorian date (Hinnant's days_from_civil).
+constexpr std::int64_t days_from_civil(std::int64_t year, unsigned month, unsigned day){
+    year -= month <= 2;
+    const std::int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(year - era * 400);
+    const unsigned doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<std::int64_t>(doe) - 719468;
+}
+static_assert(days_from_civil(1970, 1, 1) == 0 && days_from_civil(2000, 3, 1) == 11017, "civil day count");
+
+} // namespace harmoclimat
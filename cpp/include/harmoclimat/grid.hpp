@@ -0,0 +1,339 @@
+// Bulk T/Q/P (and RH) tables for many stations over a regular time range
+//
+// generate() cuts the station x time space into tiles and evaluates them on a
+// work-stealing pool of std::threads, straight into caller-owned columns: each
+// tile is one predict_batch(unix_seconds) call on a stack of timestamps, so the
+// only memory traffic is the output itself. write_binary() and write_csv()
+// store a table; CSV rows are formatted in parallel too.
+//
+// Stations are passed as predict_batch(unix_seconds) function pointers, e.g.
+// harmoclimat::stations[i].predict_batch_unix from harmoclimat_stations.hpp or
+// &harmoclimat::fr_bourges::predict_batch. The relative humidity column needs
+// harmoclimat_psychrometrics.hpp on the include path.
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+#if defined(__has_include) && !defined(HARMOCLIMAT_DISABLE_PSYCHROMETRICS)
+#if __has_include("harmoclimat_psychrometrics.hpp")
+#include "harmoclimat_psychrometrics.hpp"
+#endif
+#endif
+namespace harmoclimat {
+namespace grid {
+
+using PredictBatchUnix = void (*)(const std::int64_t*, std::size_t, double*, double*, double*);
+
+// Samples start_unix + n * step_seconds for n in [0, steps).
+struct TimeRange {
+    std::int64_t start_unix;
+    std::int64_t step_seconds;
+    std::size_t steps;
+    std::int64_t at(std::size_t n) const { return start_unix + static_cast<std::int64_t>(n) * step_seconds; }
+};
+
+// Station-major columns of station_count * steps values: station s at step n
+// is column[s * steps + n]. relative_humidity_percent may be null.
+struct Columns {
+    double* temperature_c;
+    double* specific_humidity_kg_kg;
+    double* pressure_hpa;
+    double* relative_humidity_percent;
+};
+
+struct Options {
+    unsigned threads = 0;          // 0: std::thread::hardware_concurrency()
+    std::size_t tile_steps = 2048; // samples per task
+};
+
+// Owning table; columns() views it.
+struct Table {
+    TimeRange range{};
+    std::size_t station_count = 0;
+    std::vector<double> temperature_c, specific_humidity_kg_kg, pressure_hpa, relative_humidity_percent;
+
+    Table() = default;
+    Table(std::size_t stations, const TimeRange& time, bool with_relative_humidity)
+        : range(time), station_count(stations), temperature_c(stations * time.steps),
+          specific_humidity_kg_kg(stations * time.steps), pressure_hpa(stations * time.steps),
+          relative_humidity_percent(with_relative_humidity ? stations * time.steps : 0) {}
+    Columns columns(){
+        return {temperature_c.data(), specific_humidity_kg_kg.data(), pressure_hpa.data(),
+                relative_humidity_percent.empty() ? nullptr : relative_humidity_percent.data()};
+    }
+};
+
+inline constexpr bool has_relative_humidity =
+#if defined(HARMOCLIMAT_PSYCHROMETRICS)
+    true;
+#else
+    false;
+#endif
+
+namespace detail {
+
+// Half-open range of tile indices packed into one word, so the owner taking
+// from the front and thieves taking the back half race on a single CAS.
+struct alignas(64) TileQueue {
+    std::atomic<std::uint64_t> bounds{0};
+};
+inline std::uint64_t pack_bounds(std::uint64_t begin, std::uint64_t end){ return (begin << 32) | end; }
+
+inline bool pop_front(TileQueue& queue, std::size_t& tile){
+    std::uint64_t bounds = queue.bounds.load(std::memory_order_relaxed);
+    for (;;) {
+        const std::uint64_t begin = bounds >> 32, end = bounds & 0xFFFFFFFFu;
+        if (begin >= end) return false;
+        if (queue.bounds.compare_exchange_weak(bounds, pack_bounds(begin + 1, end), std::memory_order_acq_rel)) {
+            tile = static_cast<std::size_t>(begin);
+            return true;
+        }
+    }
+}
+
+inline bool steal_half(TileQueue& victim, std::uint64_t& begin, std::uint64_t& end){
+    std::uint64_t bounds = victim.bounds.load(std::memory_order_relaxed);
+    for (;;) {
+        const std::uint64_t first = bounds >> 32, last = bounds & 0xFFFFFFFFu;
+        if (first >= last) return false;
+        const std::uint64_t middle = first + (last - first) / 2;
+        if (victim.bounds.compare_exchange_weak(bounds, pack_bounds(first, middle), std::memory_order_acq_rel)) {
+            begin = middle;
+            end = last;
+            return true;
+        }
+    }
+}
+
+inline unsigned resolve_threads(unsigned threads, std::size_t tile_count){
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    return static_cast<unsigned>(std::min<std::size_t>(threads, std::max<std::size_t>(tile_count, 1)));
+}
+
+// Calls body(tile) exactly once for every tile in [0, tile_count). Each worker
+// starts on a contiguous share and, once it runs dry, steals the back half of
+// another worker's range. A worker leaves after one scan finds every queue
+// empty; ranges in flight between two queues are finished by their thief.
+template <class Body>
+void run_tiles(std::size_t tile_count, unsigned threads, const Body& body){
+    if (tile_count > 0xFFFFFFFFu) throw std::length_error("harmoclimat::grid: too many tiles; raise tile_steps");
+    threads = resolve_threads(threads, tile_count);
+    std::vector<TileQueue> queues(threads);
+    for (unsigned w = 0; w < threads; ++w) {
+        queues[w].bounds.store(pack_bounds(tile_count * w / threads, tile_count * (w + 1) / threads));
+    }
+    const auto worker = [&](unsigned self){
+        for (;;) {
+            std::size_t tile = 0;
+            if (pop_front(queues[self], tile)) {
+                body(tile);
+                continue;
+            }
+            std::uint64_t begin = 0, end = 0;
+            bool stolen = false;
+            for (unsigned k = 1; k < threads && !stolen; ++k) stolen = steal_half(queues[(self + k) % threads], begin, end);
+            if (!stolen) return;
+            queues[self].bounds.store(pack_bounds(begin, end), std::memory_order_release);
+        }
+    };
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (unsigned w = 1; w < threads; ++w) pool.emplace_back(worker, w);
+    worker(0);
+    for (std::thread& thread : pool) thread.join();
+}
+
+inline std::size_t tiles_per_station(const TimeRange& range, std::size_t tile_steps){
+    return (range.steps + tile_steps - 1) / tile_steps;
+}
+
+} // namespace detail
+
+// Evaluates every station over range into columns (see Columns for the layout).
+inline void generate(const PredictBatchUnix* stations, std::size_t station_count, const TimeRange& range,
+                     const Columns& columns, const Options& options = {}){
+    if (columns.relative_humidity_percent && !has_relative_humidity) {
+        throw std::invalid_argument("harmoclimat::grid: relative humidity needs harmoclimat_psychrometrics.hpp");
+    }
+    const std::size_t tile_steps = std::max<std::size_t>(options.tile_steps, 1);
+    const std::size_t per_station = detail::tiles_per_station(range, tile_steps);
+    detail::run_tiles(station_count * per_station, options.threads, [&](std::size_t tile){
+        thread_local std::vector<std::int64_t> timestamps;
+        const std::size_t station = tile / per_station;
+        const std::size_t first = (tile % per_station) * tile_steps;
+        const std::size_t count = std::min(tile_steps, range.steps - first);
+        timestamps.resize(count);
+        for (std::size_t n = 0; n < count; ++n) timestamps[n] = range.at(first + n);
+        const std::size_t offset = station * range.steps + first;
+        stations[station](timestamps.data(), count, columns.temperature_c + offset,
+                          columns.specific_humidity_kg_kg + offset, columns.pressure_hpa + offset);
+#if defined(HARMOCLIMAT_PSYCHROMETRICS)
+        if (columns.relative_humidity_percent) {
+            thread_local std::vector<double> scratch;
+            scratch.resize(2 * count);
+            psychrometrics::derive_batch(columns.temperature_c + offset, columns.specific_humidity_kg_kg + offset,
+                                         columns.pressure_hpa + offset, count,
+                                         columns.relative_humidity_percent + offset, scratch.data(),
+                                         scratch.data() + count);
+        }
+#endif
+    });
+}
+
+inline Table generate(const PredictBatchUnix* stations, std::size_t station_count, const TimeRange& range,
+                      bool with_relative_humidity = false, const Options& options = {}){
+    Table table(station_count, range, with_relative_humidity);
+    generate(stations, station_count, range, table.columns(), options);
+    return table;
+}
+
+// ------------------------------------------------------------------ Files ---
+//
+// Binary layout (little-endian): a 64-byte FileHeader, station_count 16-byte
+// NUL-padded station codes, then column_count float64 columns of
+// station_count * steps values each (T, Q, P, then RH when present), laid out
+// as in Columns. numpy: np.fromfile(path, "<f8", offset=64 + 16 * stations).
+
+static constexpr char file_magic[8] = {'H', 'C', 'G', 'R', 'I', 'D', '\0', '\0'};
+static constexpr std::uint32_t format_version = 1;
+
+struct FileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t column_count;
+    std::uint64_t station_count;
+    std::uint64_t steps;
+    std::int64_t start_unix;
+    std::int64_t step_seconds;
+    std::uint8_t reserved[16];
+};
+static_assert(sizeof(FileHeader) == 64, "grid file header is 64 bytes");
+
+namespace detail {
+
+struct File {
+    std::FILE* handle;
+    explicit File(const std::string& path) : handle(std::fopen(path.c_str(), "wb")) {
+        if (!handle) throw std::runtime_error("harmoclimat::grid: cannot open " + path);
+    }
+    ~File(){ if (handle) std::fclose(handle); }
+    File(const File&) = delete;
+    File& operator=(const File&) = delete;
+    void write(const void* data, std::size_t bytes){
+        if (bytes && std::fwrite(data, 1, bytes, handle) != bytes) throw std::runtime_error("harmoclimat::grid: write failed");
+    }
+    void close(){
+        const int status = std::fclose(handle);
+        handle = nullptr;
+        if (status != 0) throw std::runtime_error("harmoclimat::grid: write failed");
+    }
+};
+
+inline void append_number(std::string& out, double value){
+    char buffer[32];
+    const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+inline void append_number(std::string& out, std::int64_t value){
+    char buffer[24];
+    const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+// A station code as a CSV field: quoted, with inner quotes doubled (RFC 4180),
+// when it holds a comma, a quote or a line break; verbatim otherwise.
+inline std::string csv_field(std::string_view code){
+    if (code.find_first_of(",\"\r\n") == std::string_view::npos) return std::string(code);
+    std::string field = "\"";
+    for (const char c : code) {
+        if (c == '"') field.push_back('"');
+        field.push_back(c);
+    }
+    field.push_back('"');
+    return field;
+}
+
+} // namespace detail
+
+inline void write_binary(const std::string& path, const std::string_view* codes, std::size_t station_count,
+                         const TimeRange& range, const Columns& columns){
+    FileHeader header{};
+    std::memcpy(header.magic, file_magic, sizeof(file_magic));
+    header.version = format_version;
+    header.column_count = columns.relative_humidity_percent ? 4 : 3;
+    header.station_count = station_count;
+    header.steps = range.steps;
+    header.start_unix = range.start_unix;
+    header.step_seconds = range.step_seconds;
+    detail::File file(path);
+    file.write(&header, sizeof(header));
+    for (std::size_t s = 0; s < station_count; ++s) {
+        char code[16] = {};
+        std::memcpy(code, codes[s].data(), std::min(codes[s].size(), sizeof(code)));
+        file.write(code, sizeof(code));
+    }
+    const double* data[4] = {columns.temperature_c, columns.specific_humidity_kg_kg, columns.pressure_hpa,
+                             columns.relative_humidity_percent};
+    for (std::uint32_t c = 0; c < header.column_count; ++c) file.write(data[c], station_count * range.steps * sizeof(double));
+    file.close();
+}
+
+// One row per station and step: station_code,unix_seconds,T,Q,P[,RH], with the
+// shortest round-trip decimal form of every value. Codes holding a comma, a
+// quote or a line break are quoted.
+inline void write_csv(const std::string& path, const std::string_view* codes, std::size_t station_count,
+                      const TimeRange& range, const Columns& columns, const Options& options = {}){
+    detail::File file(path);
+    const std::string_view header = "station_code,unix_seconds,temperature_c,specific_humidity_kg_kg,pressure_hpa";
+    file.write(header.data(), header.size());
+    if (columns.relative_humidity_percent) file.write(",relative_humidity_percent", 26);
+    file.write("\n", 1);
+
+    std::vector<std::string> fields(station_count);
+    for (std::size_t s = 0; s < station_count; ++s) fields[s] = detail::csv_field(codes[s]);
+    const std::size_t tile_steps = std::max<std::size_t>(options.tile_steps, 1);
+    const std::size_t per_station = detail::tiles_per_station(range, tile_steps);
+    const std::size_t tile_count = station_count * per_station;
+    const unsigned threads = detail::resolve_threads(options.threads, tile_count);
+    // Tiles are formatted in parallel a batch at a time and written in order.
+    std::vector<std::string> text(std::max<std::size_t>(4 * threads, 1));
+    for (std::size_t batch = 0; batch < tile_count; batch += text.size()) {
+        const std::size_t batch_size = std::min(text.size(), tile_count - batch);
+        detail::run_tiles(batch_size, threads, [&](std::size_t k){
+            const std::size_t tile = batch + k;
+            const std::size_t station = tile / per_station;
+            const std::size_t first = (tile % per_station) * tile_steps;
+            const std::size_t last = std::min(first + tile_steps, range.steps);
+            std::string& out = text[k];
+            out.clear();
+            for (std::size_t n = first; n < last; ++n) {
+                const std::size_t i = station * range.steps + n;
+                out.append(fields[station]);
+                out.push_back(',');
+                detail::append_number(out, range.at(n));
+                const double values[4] = {columns.temperature_c[i], columns.specific_humidity_kg_kg[i], columns.pressure_hpa[i],
+                                          columns.relative_humidity_percent ? columns.relative_humidity_percent[i] : 0.0};
+                for (int c = 0; c < (columns.relative_humidity_percent ? 4 : 3); ++c) {
+                    out.push_back(',');
+                    detail::append_number(out, values[c]);
+                }
+                out.push_back('\n');
+            }
+        });
+        for (std::size_t k = 0; k < batch_size; ++k) file.write(text[k].data(), text[k].size());
+    }
+    file.close();
+}
+
+} // namespace grid
+} // namespace harmoclimat
@@ -0,0 +1,333 @@
+// Runtime loader for HarmoClimate model packs (.hcpack)
+// Format : written by harmoclimate.model_pack (see its module docstring)
+//
+// The pack is memory-mapped read-only. Opening it validates the fixed-size
+// header only and find() is a single FNV-1a hash probe, so start-up cost does
+// not grow with the number of stations and nothing is parsed or allocated.
+#pragma once
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+namespace harmoclimat {
+namespace pack {
+static constexpr char file_magic[8] = {'H', 'C', 'P', 'A', 'C', 'K', '\0', '\0'};
+static constexpr std::uint32_t format_version = 2;
+// Written as a native uint32 by a little-endian writer; reads back byte-swapped
+// on a big-endian host.
+static constexpr std::uint32_t byte_order_mark = 0x01020304u;
+static constexpr int n_targets = 3;
+static constexpr int max_diurnal_terms = 16;
+static constexpr int max_basis_size = 33;
+static constexpr std::uint8_t absent_term = 0xFF;
+enum Target : int { temperature = 0, specific_humidity = 1, pressure = 2 };
+enum EnvelopeField : int { mae = 0, bias = 1, p05 = 2, p95 = 3 };
+
+struct FileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t station_count;
+    std::uint32_t annual_basis_size;
+    std::uint32_t diurnal_basis_size;
+    std::uint32_t coeff_stride;
+    std::uint32_t hash_slots;
+    std::uint64_t records_offset;
+    std::uint64_t hash_offset;
+    std::uint64_t coeffs_offset;
+    std::uint32_t byte_order;
+    std::uint8_t reserved[4];
+};
+static_assert(sizeof(FileHeader) == 64, "model pack header is 64 bytes");
+
+struct StationRecord {
+    char code[16];
+    char name[48];
+    double longitude_deg;
+    double latitude_deg;
+    double altitude_m;
+    double delta_utc_solar_h;
+    double error_envelope[n_targets][4];
+    std::uint8_t n_annual[n_targets][max_diurnal_terms];
+    std::uint32_t n_diurnal[n_targets];
+    std::uint32_t reserved;
+};
+static_assert(sizeof(StationRecord) == 256, "model pack station record is 256 bytes");
+
+namespace detail {
+static constexpr double two_pi = 6.2831853071795864769;
+static constexpr double solar_year_days = 365.242189;
+inline std::uint64_t fnv1a_64(std::string_view text){
+    std::uint64_t value = 0xCBF29CE484222325ull;
+    for (unsigned char byte : text) {
+        value ^= byte;
+        value *= 0x100000001B3ull;
+    }
+    return value;
+}
+inline double wrap(double x, double period){
+    x -= period * std::floor(x / period);
+    return x >= period ? 0.0 : x;  // rounding up to the period; NaN passes through
+}
+// [1, cos x, sin x, ..., cos nx, sin nx] for size = 2n + 1.
+inline void harmonic_basis(double angle, int size, double* basis){
+    basis[0] = 1.0;
+    if (size == 1) return;
+    basis[1] = std::cos(angle);
+    basis[2] = std::sin(angle);
+    for(int k = 2; 2*k < size; ++k){
+        basis[2*k - 1] = basis[2*k - 3] * basis[1] - basis[2*k - 2] * basis[2];
+        basis[2*k] = basis[2*k - 2] * basis[1] + basis[2*k - 3] * basis[2];
+    }
+}
+// T/Q/P of zero-padded [target][diurnal term][annual term] blocks `stride`
+// doubles apart. Same time convention as the generated headers: the solar day
+// only depends on day_utc.
+inline void evaluate_block(const double* coeffs, std::size_t stride, int annual_size, int diurnal_size,
+                           double delta_utc_solar_h, double day_utc, double hour_utc, double (&values)[n_targets]){
+    const double day_solar = wrap(day_utc + delta_utc_solar_h / 24.0, solar_year_days);
+    const double hour_solar = wrap(hour_utc + delta_utc_solar_h, 24.0);
+    double annual[max_basis_size], diurnal[max_basis_size];
+    harmonic_basis(two_pi / solar_year_days * day_solar, annual_size, annual);
+    harmonic_basis(two_pi / 24.0 * hour_solar, diurnal_size, diurnal);
+    for(int t = 0; t < n_targets; ++t){
+        const double* row = coeffs + t * stride;
+        double value = 0.0;
+        for(int p = 0; p < diurnal_size; ++p){
+            double inner = 0.0;
+            for(int j = 0; j < annual_size; ++j){
+                inner += row[p * annual_size + j] * annual[j];
+            }
+            value += inner * diurnal[p];
+        }
+        values[t] = value;
+    }
+}
+} // namespace detail
+
+// Non-owning view of one station inside a mapped pack.
+class Station {
+public:
+    Station(const FileHeader* header, const StationRecord* record, const double* coeffs)
+        : header_(header), record_(record), coeffs_(coeffs) {}
+
+    std::string_view code() const { return {record_->code, ::strnlen(record_->code, sizeof(record_->code))}; }
+    std::string_view name() const { return {record_->name, ::strnlen(record_->name, sizeof(record_->name))}; }
+    double longitude_deg() const { return record_->longitude_deg; }
+    double latitude_deg() const { return record_->latitude_deg; }
+    double altitude_m() const { return record_->altitude_m; }
+    double delta_utc_solar_h() const { return record_->delta_utc_solar_h; }
+    double error_envelope(Target target, EnvelopeField field) const { return record_->error_envelope[target][field]; }
+    int n_diurnal(Target target) const { return static_cast<int>(record_->n_diurnal[target]); }
+    // Annual order of diurnal term `term` (c0, a1, b1, ...), or -1 when the model omits it.
+    int n_annual(Target target, int term) const {
+        const std::uint8_t order = record_->n_annual[target][term];
+        return order == absent_term ? -1 : order;
+    }
+    int annual_basis_size() const { return static_cast<int>(header_->annual_basis_size); }
+    int diurnal_basis_size() const { return static_cast<int>(header_->diurnal_basis_size); }
+    // Zero-padded [diurnal term][annual term] block of one target.
+    const double* coefficients(Target target) const { return coeffs_ + target * header_->coeff_stride; }
+
+    void predict(double day_utc, double hour_utc, double& temperature_c, double& specific_humidity_kg_kg,
+                 double& pressure_hpa) const {
+        double values[n_targets];
+        evaluate(day_utc, hour_utc, values);
+        temperature_c = values[temperature];
+        specific_humidity_kg_kg = values[specific_humidity];
+        pressure_hpa = values[pressure];
+    }
+    double predict(Target target, double day_utc, double hour_utc) const {
+        double values[n_targets];
+        evaluate(day_utc, hour_utc, values);
+        return values[target];
+    }
+
+private:
+    void evaluate(double day_utc, double hour_utc, double (&values)[n_targets]) const {
+        detail::evaluate_block(coeffs_, header_->coeff_stride, annual_basis_size(), diurnal_basis_size(),
+                               record_->delta_utc_solar_h, day_utc, hour_utc, values);
+    }
+
+    const FileHeader* header_;
+    const StationRecord* record_;
+    const double* coeffs_;
+};
+
+// Read-only memory mapping of a model pack. Throws std::runtime_error when the
+// file cannot be mapped or its header does not describe a valid pack.
+class ModelPack {
+public:
+    explicit ModelPack(const std::string& path){
+        map(path);
+        try {
+            validate(path);
+        } catch (...) {
+            unmap();
+            throw;
+        }
+    }
+    ~ModelPack(){ unmap(); }
+    ModelPack(const ModelPack&) = delete;
+    ModelPack& operator=(const ModelPack&) = delete;
+    ModelPack(ModelPack&& other) noexcept { steal(other); }
+    ModelPack& operator=(ModelPack&& other) noexcept {
+        if (this != &other) {
+            unmap();
+            steal(other);
+        }
+        return *this;
+    }
+
+    std::size_t size() const { return header()->station_count; }
+    // Precondition: index < size().
+    Station station(std::size_t index) const {
+        assert(index < size());
+        const FileHeader* h = header();
+        const auto* records = reinterpret_cast<const StationRecord*>(data_ + h->records_offset);
+        const auto* coeffs = reinterpret_cast<const double*>(data_ + h->coeffs_offset);
+        return Station(h, records + index, coeffs + index * n_targets * h->coeff_stride);
+    }
+    std::optional<Station> find(std::string_view code) const {
+        const FileHeader* h = header();
+        const auto* slots = reinterpret_cast<const std::uint32_t*>(data_ + h->hash_offset);
+        const std::uint32_t mask = h->hash_slots - 1;
+        // The table is not covered by validate(): a probe stops after one lap
+        // and rejects slots pointing past the records.
+        std::uint32_t slot = static_cast<std::uint32_t>(detail::fnv1a_64(code)) & mask;
+        for (std::uint32_t probe = 0; probe < h->hash_slots; ++probe, slot = (slot + 1) & mask) {
+            const std::uint32_t entry = slots[slot];
+            if (entry == 0) return std::nullopt;
+            if (entry > h->station_count) throw std::runtime_error("corrupt model pack hash table");
+            Station candidate = station(entry - 1);
+            if (candidate.code() == code) return candidate;
+        }
+        return std::nullopt;
+    }
+
+private:
+    const FileHeader* header() const { return reinterpret_cast<const FileHeader*>(data_); }
+
+    void map(const std::string& path){
+#if defined(_WIN32)
+        file_ = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) throw std::runtime_error("cannot open model pack: " + path);
+        LARGE_INTEGER file_size;
+        if (!::GetFileSizeEx(file_, &file_size)) {
+            unmap();
+            throw std::runtime_error("cannot stat model pack: " + path);
+        }
+        size_ = static_cast<std::size_t>(file_size.QuadPart);
+        if (size_ < sizeof(FileHeader)) {
+            unmap();
+            throw std::runtime_error("model pack too small: " + path);
+        }
+        mapping_ = ::CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping_ == nullptr) {
+            unmap();
+            throw std::runtime_error("cannot map model pack: " + path);
+        }
+        data_ = static_cast<const unsigned char*>(::MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+        if (data_ == nullptr) {
+            unmap();
+            throw std::runtime_error("cannot map model pack: " + path);
+        }
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("cannot open model pack: " + path);
+        struct stat info;
+        if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(FileHeader)) {
+            ::close(fd);
+            throw std::runtime_error("model pack missing or too small: " + path);
+        }
+        size_ = static_cast<std::size_t>(info.st_size);
+        void* mapped = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED) throw std::runtime_error("cannot map model pack: " + path);
+        data_ = static_cast<const unsigned char*>(mapped);
+#endif
+    }
+
+    void validate(const std::string& path) const {
+        const FileHeader* h = header();
+        if (std::memcmp(h->magic, file_magic, sizeof(file_magic)) != 0) {
+            throw std::runtime_error("not a HarmoClimate model pack: " + path);
+        }
+        // Before the version, which a foreign-endian pack would misreport.
+        if (h->byte_order != byte_order_mark) {
+            throw std::runtime_error("model pack byte order does not match this host: " + path);
+        }
+        if (h->version != format_version) {
+            throw std::runtime_error("unsupported model pack version " + std::to_string(h->version) + ": " + path);
+        }
+        const std::uint64_t count = h->station_count;
+        const bool sizes_ok = h->annual_basis_size % 2 == 1 && h->annual_basis_size <= max_basis_size &&
+                              h->diurnal_basis_size % 2 == 1 && h->diurnal_basis_size <= max_diurnal_terms &&
+                              h->coeff_stride >= h->annual_basis_size * h->diurnal_basis_size;
+        const bool hash_ok = h->hash_slots > count && (h->hash_slots & (h->hash_slots - 1)) == 0;
+        if (!sizes_ok || !hash_ok) {
+            throw std::runtime_error("corrupt model pack header: " + path);
+        }
+        // Offsets come from the file: divide the space left rather than multiply
+        // the counts, so no product can wrap around.
+        const std::uint64_t station_coeff_bytes = std::uint64_t{n_targets} * h->coeff_stride * sizeof(double);
+        const bool sections_ok = h->records_offset % alignof(StationRecord) == 0 && h->records_offset <= size_ &&
+                                 count <= (size_ - h->records_offset) / sizeof(StationRecord) &&
+                                 h->hash_offset % alignof(std::uint32_t) == 0 && h->hash_offset <= size_ &&
+                                 h->hash_slots <= (size_ - h->hash_offset) / sizeof(std::uint32_t) &&
+                                 h->coeffs_offset % alignof(double) == 0 && h->coeffs_offset <= size_ &&
+                                 count <= (size_ - h->coeffs_offset) / station_coeff_bytes;
+        if (!sections_ok) {
+            throw std::runtime_error("corrupt model pack header: " + path);
+        }
+    }
+
+    void unmap(){
+#if defined(_WIN32)
+        if (data_ != nullptr) ::UnmapViewOfFile(data_);
+        if (mapping_ != nullptr) ::CloseHandle(mapping_);
+        if (file_ != INVALID_HANDLE_VALUE) ::CloseHandle(file_);
+        mapping_ = nullptr;
+        file_ = INVALID_HANDLE_VALUE;
+#else
+        if (data_ != nullptr) ::munmap(const_cast<unsigned char*>(data_), size_);
+#endif
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    void steal(ModelPack& other){
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+#if defined(_WIN32)
+        file_ = std::exchange(other.file_, INVALID_HANDLE_VALUE);
+        mapping_ = std::exchange(other.mapping_, nullptr);
+#endif
+    }
+
+    const unsigned char* data_ = nullptr;
+    std::size_t size_ = 0;
+#if defined(_WIN32)
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#endif
+};
+} // namespace pack
+} // namespace harmoclimat
@@ -0,0 +1,312 @@
+// Nearest-station index and virtual stations blended from a model pack
+//
+// StationIndex is a k-d tree over the stations' positions on the unit sphere.
+// Chord length grows with great-circle distance, so the k nearest points in
+// 3-D are the k nearest stations, with no special case at the antimeridian or
+// the poles.
+//
+// The model is linear in its coefficients, so an inverse-distance blend of the
+// neighbours' coefficient blocks is itself a model. blend() builds it once per
+// site. Each neighbour's block is first moved into the site's solar frame
+// (delta_utc_solar_h = longitude / 15, as in training): shifting solar time by
+// Δ hours is an exact rotation of every (cos kx, sin kx) pair, annual and
+// diurnal, so the blend equals the weighted mean of the neighbours' UTC
+// predictions. With a site altitude, each neighbour's mean temperature follows
+// a lapse rate and its pressure block is scaled hypsometrically before the
+// blend; specific humidity is blended as is. VirtualStation::predict() runs the
+// same evaluation as pack::Station::predict().
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "model_pack.hpp"
+
+namespace harmoclimat {
+namespace spatial {
+
+static constexpr double earth_radius_km = 6371.0088;
+static constexpr double standard_lapse_rate_k_per_m = 0.0065;
+static constexpr double gravity_m_s2 = 9.80665;
+static constexpr double dry_air_gas_constant = 287.05;  // J/(kg·K)
+static constexpr double coincident_km = 1e-3;           // closer neighbours are used alone
+
+struct Site {
+    double latitude_deg;
+    double longitude_deg;
+};
+
+struct Neighbour {
+    std::size_t index;   // station index in the pack (or in the sites given to the index)
+    double distance_km;  // great-circle distance
+};
+
+namespace detail {
+static constexpr double degree = 3.14159265358979323846 / 180.0;
+
+struct Point {
+    double xyz[3];
+    std::size_t index;
+};
+
+inline Point unit_vector(double latitude_deg, double longitude_deg, std::size_t index){
+    const double lat = latitude_deg * degree;
+    const double lon = longitude_deg * degree;
+    return {{std::cos(lat) * std::cos(lon), std::cos(lat) * std::sin(lon), std::sin(lat)}, index};
+}
+inline double squared_chord(const double (&a)[3], const double (&b)[3]){
+    const double dx = a[0] - b[0], dy = a[1] - b[1], dz = a[2] - b[2];
+    return dx * dx + dy * dy + dz * dz;
+}
+inline double chord_to_km(double squared){
+    return 2.0 * earth_radius_km * std::asin(std::min(1.0, std::sqrt(squared) / 2.0));
+}
+
+// Shifts a [diurnal term][annual term] block from solar time t to t + shift_h:
+// the returned block evaluated at t equals the input evaluated at t + shift_h.
+inline void shift_solar_time(double* block, int annual_size, int diurnal_size, double shift_h){
+    const auto rotate = [](double& cos_term, double& sin_term, double angle) {
+        const double c = std::cos(angle), s = std::sin(angle);
+        const double a = cos_term, b = sin_term;
+        cos_term = a * c + b * s;
+        sin_term = b * c - a * s;
+    };
+    for(int k = 1; 2*k < diurnal_size; ++k){
+        const double angle = k * pack::detail::two_pi / 24.0 * shift_h;
+        for(int j = 0; j < annual_size; ++j){
+            rotate(block[(2*k - 1) * annual_size + j], block[2*k * annual_size + j], angle);
+        }
+    }
+    for(int k = 1; 2*k < annual_size; ++k){
+        const double angle = k * pack::detail::two_pi / pack::detail::solar_year_days * (shift_h / 24.0);
+        for(int p = 0; p < diurnal_size; ++p){
+            rotate(block[p * annual_size + 2*k - 1], block[p * annual_size + 2*k], angle);
+        }
+    }
+}
+} // namespace detail
+
+// k-d tree over station positions; stations without finite coordinates are
+// left out.
+class StationIndex {
+public:
+    explicit StationIndex(const std::vector<Site>& sites){
+        for (std::size_t i = 0; i < sites.size(); ++i) add(sites[i].latitude_deg, sites[i].longitude_deg, i);
+        build(0, points_.size());
+    }
+    explicit StationIndex(const pack::ModelPack& pack){
+        for (std::size_t i = 0; i < pack.size(); ++i) {
+            const pack::Station station = pack.station(i);
+            add(station.latitude_deg(), station.longitude_deg(), i);
+        }
+        build(0, points_.size());
+    }
+    // Registry rows (harmoclimat::stations) or any array with latitude_deg/longitude_deg members.
+    template <class Entry, std::size_t N>
+    explicit StationIndex(const Entry (&entries)[N]){
+        for (std::size_t i = 0; i < N; ++i) add(entries[i].latitude_deg, entries[i].longitude_deg, i);
+        build(0, points_.size());
+    }
+
+    std::size_t size() const { return points_.size(); }
+
+    // Up to k stations, nearest first (ties by index).
+    std::vector<Neighbour> nearest(double latitude_deg, double longitude_deg, std::size_t k) const {
+        std::vector<std::pair<double, std::size_t>> heap;
+        if (k > 0 && std::isfinite(latitude_deg) && std::isfinite(longitude_deg)) {
+            heap.reserve(k + 1);
+            search(0, points_.size(), detail::unit_vector(latitude_deg, longitude_deg, 0), k, heap);
+        }
+        std::sort_heap(heap.begin(), heap.end());
+        std::vector<Neighbour> found;
+        found.reserve(heap.size());
+        for (const auto& [squared, index] : heap) found.push_back({index, detail::chord_to_km(squared)});
+        return found;
+    }
+
+private:
+    void add(double latitude_deg, double longitude_deg, std::size_t index){
+        if (std::isfinite(latitude_deg) && std::isfinite(longitude_deg)) {
+            points_.push_back(detail::unit_vector(latitude_deg, longitude_deg, index));
+        }
+    }
+
+    // Implicit tree: the node of [lo, hi) is its middle element, split on the
+    // axis of largest spread.
+    void build(std::size_t lo, std::size_t hi){
+        if (axes_.size() != points_.size()) axes_.assign(points_.size(), 0);
+        if (hi - lo < 2) return;
+        double low[3], high[3];
+        for (int a = 0; a < 3; ++a) low[a] = high[a] = points_[lo].xyz[a];
+        for (std::size_t i = lo + 1; i < hi; ++i) {
+            for (int a = 0; a < 3; ++a) {
+                low[a] = std::min(low[a], points_[i].xyz[a]);
+                high[a] = std::max(high[a], points_[i].xyz[a]);
+            }
+        }
+        int axis = 0;
+        for (int a = 1; a < 3; ++a) {
+            if (high[a] - low[a] > high[axis] - low[axis]) axis = a;
+        }
+        const std::size_t mid = lo + (hi - lo) / 2;
+        std::nth_element(points_.begin() + lo, points_.begin() + mid, points_.begin() + hi,
+                         [axis](const detail::Point& a, const detail::Point& b) { return a.xyz[axis] < b.xyz[axis]; });
+        axes_[mid] = static_cast<unsigned char>(axis);
+        build(lo, mid);
+        build(mid + 1, hi);
+    }
+
+    void search(std::size_t lo, std::size_t hi, const detail::Point& query, std::size_t k,
+                std::vector<std::pair<double, std::size_t>>& heap) const {
+        if (lo >= hi) return;
+        const std::size_t mid = lo + (hi - lo) / 2;
+        const detail::Point& node = points_[mid];
+        const std::pair<double, std::size_t> candidate{detail::squared_chord(query.xyz, node.xyz), node.index};
+        if (heap.size() < k) {
+            heap.push_back(candidate);
+            std::push_heap(heap.begin(), heap.end());
+        } else if (candidate < heap.front()) {
+            std::pop_heap(heap.begin(), heap.end());
+            heap.back() = candidate;
+            std::push_heap(heap.begin(), heap.end());
+        }
+        const double gap = query.xyz[axes_[mid]] - node.xyz[axes_[mid]];
+        const bool left_first = gap < 0.0;
+        search(left_first ? lo : mid + 1, left_first ? mid : hi, query, k, heap);
+        if (heap.size() < k || gap * gap <= heap.front().first) {
+            search(left_first ? mid + 1 : lo, left_first ? hi : mid, query, k, heap);
+        }
+    }
+
+    std::vector<detail::Point> points_;
+    std::vector<unsigned char> axes_;
+};
+
+struct BlendOptions {
+    std::size_t neighbours = 4;
+    double power = 2.0;  // inverse-distance weight exponent
+    double lapse_rate_k_per_m = standard_lapse_rate_k_per_m;
+};
+
+// Owning coefficient block of a site between stations; same queries as pack::Station.
+class VirtualStation {
+public:
+    double latitude_deg() const { return latitude_deg_; }
+    double longitude_deg() const { return longitude_deg_; }
+    double altitude_m() const { return altitude_m_; }  // NaN when blended without altitude adjustment
+    double delta_utc_solar_h() const { return delta_utc_solar_h_; }
+    int n_diurnal(pack::Target target) const { return n_diurnal_[target]; }
+    // Largest annual order of term `term` among the neighbours, or -1 when none has it.
+    int n_annual(pack::Target target, int term) const { return n_annual_[target][term]; }
+    int annual_basis_size() const { return annual_size_; }
+    int diurnal_basis_size() const { return diurnal_size_; }
+    const double* coefficients(pack::Target target) const { return coeffs_.data() + target * stride(); }
+    const std::vector<Neighbour>& neighbours() const { return neighbours_; }
+    const std::vector<double>& weights() const { return weights_; }
+
+    void predict(double day_utc, double hour_utc, double& temperature_c, double& specific_humidity_kg_kg,
+                 double& pressure_hpa) const {
+        double values[pack::n_targets];
+        evaluate(day_utc, hour_utc, values);
+        temperature_c = values[pack::temperature];
+        specific_humidity_kg_kg = values[pack::specific_humidity];
+        pressure_hpa = values[pack::pressure];
+    }
+    double predict(pack::Target target, double day_utc, double hour_utc) const {
+        double values[pack::n_targets];
+        evaluate(day_utc, hour_utc, values);
+        return values[target];
+    }
+
+private:
+    friend VirtualStation blend(const pack::ModelPack&, const StationIndex&, double, double, double,
+                                const BlendOptions&);
+
+    std::size_t stride() const { return static_cast<std::size_t>(annual_size_) * diurnal_size_; }
+    void evaluate(double day_utc, double hour_utc, double (&values)[pack::n_targets]) const {
+        pack::detail::evaluate_block(coeffs_.data(), stride(), annual_size_, diurnal_size_, delta_utc_solar_h_,
+                                     day_utc, hour_utc, values);
+    }
+
+    double latitude_deg_ = 0.0, longitude_deg_ = 0.0, altitude_m_ = 0.0, delta_utc_solar_h_ = 0.0;
+    int annual_size_ = 1, diurnal_size_ = 1;
+    int n_diurnal_[pack::n_targets] = {};
+    int n_annual_[pack::n_targets][pack::max_diurnal_terms] = {};
+    std::vector<double> coeffs_;
+    std::vector<Neighbour> neighbours_;
+    std::vector<double> weights_;
+};
+
+// Blends the options.neighbours stations of `index` nearest to the site
+// (index built from `pack`). A finite altitude_m adjusts each neighbour from
+// its own altitude first. Throws std::invalid_argument for a non-finite site
+// or zero neighbours and std::runtime_error when the index is empty.
+inline VirtualStation blend(const pack::ModelPack& pack, const StationIndex& index, double latitude_deg,
+                            double longitude_deg, double altitude_m = std::numeric_limits<double>::quiet_NaN(),
+                            const BlendOptions& options = {}){
+    if (!std::isfinite(latitude_deg) || !std::isfinite(longitude_deg) || options.neighbours == 0) {
+        throw std::invalid_argument("virtual station needs finite coordinates and at least one neighbour");
+    }
+    VirtualStation site;
+    site.neighbours_ = index.nearest(latitude_deg, longitude_deg, options.neighbours);
+    if (site.neighbours_.empty()) throw std::runtime_error("no station with coordinates to blend");
+    if (site.neighbours_.front().distance_km <= coincident_km) {
+        site.neighbours_.resize(1);
+        site.weights_.assign(1, 1.0);
+    } else {
+        double total = 0.0;
+        for (const Neighbour& neighbour : site.neighbours_) {
+            site.weights_.push_back(std::pow(neighbour.distance_km, -options.power));
+            total += site.weights_.back();
+        }
+        for (double& weight : site.weights_) weight /= total;
+    }
+
+    site.latitude_deg_ = latitude_deg;
+    site.longitude_deg_ = longitude_deg;
+    site.altitude_m_ = altitude_m;
+    site.delta_utc_solar_h_ = longitude_deg / 15.0;
+    const pack::Station first = pack.station(site.neighbours_.front().index);
+    site.annual_size_ = first.annual_basis_size();
+    site.diurnal_size_ = first.diurnal_basis_size();
+    const std::size_t stride = site.stride();
+    site.coeffs_.assign(pack::n_targets * stride, 0.0);
+    for (int t = 0; t < pack::n_targets; ++t) {
+        for (int term = 0; term < pack::max_diurnal_terms; ++term) site.n_annual_[t][term] = -1;
+    }
+
+    std::vector<double> block(pack::n_targets * stride);
+    for (std::size_t n = 0; n < site.neighbours_.size(); ++n) {
+        const pack::Station station = pack.station(site.neighbours_[n].index);
+        for (int t = 0; t < pack::n_targets; ++t) {
+            const auto target = static_cast<pack::Target>(t);
+            std::copy(station.coefficients(target), station.coefficients(target) + stride, block.data() + t * stride);
+            detail::shift_solar_time(block.data() + t * stride, site.annual_size_, site.diurnal_size_,
+                                     station.delta_utc_solar_h() - site.delta_utc_solar_h_);
+            site.n_diurnal_[t] = std::max(site.n_diurnal_[t], station.n_diurnal(target));
+            for (int term = 0; term < site.diurnal_size_; ++term) {
+                site.n_annual_[t][term] = std::max(site.n_annual_[t][term], station.n_annual(target, term));
+            }
+        }
+        if (std::isfinite(altitude_m) && std::isfinite(station.altitude_m())) {
+            // Constant terms are the annual and diurnal means; the pressure
+            // ratio uses the mean temperature of the layer between both levels.
+            const double rise_m = altitude_m - station.altitude_m();
+            double* temperature = block.data() + pack::temperature * stride;
+            const double layer_k = temperature[0] + 273.15 - 0.5 * options.lapse_rate_k_per_m * rise_m;
+            temperature[0] -= options.lapse_rate_k_per_m * rise_m;
+            const double ratio = std::exp(-gravity_m_s2 * rise_m / (dry_air_gas_constant * layer_k));
+            double* pressure = block.data() + pack::pressure * stride;
+            for (std::size_t i = 0; i < stride; ++i) pressure[i] *= ratio;
+        }
+        for (std::size_t i = 0; i < block.size(); ++i) site.coeffs_[i] += site.weights_[n] * block[i];
+    }
+    return site;
+}
+
+} // namespace spatial
+} // namespace harmoclimat
@@ -0,0 +1,20 @@
+// Error reporting shared by the extern "C" entry points of cpp/native
+#include "c_api.hpp"
+
+#include <string>
+
+namespace {
+
+thread_local std::string last_error;
+
+} // namespace
+
+namespace harmoclimat {
+namespace native {
+
+void set_last_error(const char* message){ last_error = message; }
+
+} // namespace native
+} // namespace harmoclimat
+
+extern "C" const char* hc_last_error(){ return last_error.c_str(); }
@@ -0,0 +1,26 @@
+// Error reporting shared by the extern "C" entry points of cpp/native
+#pragma once
+#include <exception>
+
+namespace harmoclimat {
+namespace native {
+
+// Message returned by hc_last_error() on the calling thread.
+void set_last_error(const char* message);
+
+// Runs body(), turning an exception into -1 and the last error message.
+template <class Body>
+int guarded(Body body){
+    try {
+        body();
+        return 0;
+    } catch (const std::exception& error) {
+        set_last_error(error.what());
+    } catch (...) {
+        set_last_error("unknown error");
+    }
+    return -1;
+}
+
+} // namespace native
+} // namespace harmoclimat
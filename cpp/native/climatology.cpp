@@ -0,0 +1,158 @@
+// Dense UTC climatology baseline of the LOYO evaluation (see climatology.hpp)
+#include "climatology.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "c_api.hpp"
+
+namespace harmoclimat {
+namespace native {
+namespace {
+
+constexpr std::size_t numpy_block = 8192;   // NumPy's reduction buffer size
+constexpr std::size_t pairwise_block = 128; // PW_BLOCKSIZE of NumPy's pairwise_sum
+
+// Cell of an observation, or climatology_cells outside the grid.
+std::size_t cell_of(std::int64_t utc_day, std::int64_t utc_hour){
+    if (utc_day < 1 || utc_day > static_cast<std::int64_t>(climatology_days) || utc_hour < 0
+        || utc_hour >= static_cast<std::int64_t>(climatology_hours)) {
+        return climatology_cells;
+    }
+    return static_cast<std::size_t>(utc_day - 1) * climatology_hours + static_cast<std::size_t>(utc_hour);
+}
+
+// NumPy's pairwise_sum: eight accumulators up to 128 values, halves above.
+double pairwise_sum(const double* a, std::size_t n){
+    if (n < 8) {
+        double sum = 0.0;
+        for (std::size_t i = 0; i < n; ++i) sum += a[i];
+        return sum;
+    }
+    if (n <= pairwise_block) {
+        double r[8];
+        for (std::size_t j = 0; j < 8; ++j) r[j] = a[j];
+        std::size_t i = 8;
+        for (; i < n - n % 8; i += 8) {
+            for (std::size_t j = 0; j < 8; ++j) r[j] += a[i + j];
+        }
+        double sum = ((r[0] + r[1]) + (r[2] + r[3])) + ((r[4] + r[5]) + (r[6] + r[7]));
+        for (; i < n; ++i) sum += a[i];
+        return sum;
+    }
+    std::size_t half = n / 2;
+    half -= half % 8;
+    return pairwise_sum(a, half) + pairwise_sum(a + half, n - half);
+}
+
+// np.mean of a contiguous array: pairwise sums of 8192-value buffers, added in order.
+double numpy_mean(const std::vector<double>& values){
+    double sum = 0.0;
+    for (std::size_t start = 0; start < values.size(); start += numpy_block) {
+        sum += pairwise_sum(values.data() + start, std::min(numpy_block, values.size() - start));
+    }
+    return sum / static_cast<double>(values.size());
+}
+
+} // namespace
+
+std::size_t ClimatologyBaseline::add_year(const std::int64_t* utc_day, const std::int64_t* utc_hour, const double* y,
+                                          std::size_t count){
+    const std::size_t slot = years();
+    sums_.resize(sums_.size() + climatology_cells, 0.0);
+    counts_.resize(counts_.size() + climatology_cells, 0);
+    double* sums = sums_.data() + slot * climatology_cells;
+    std::int64_t* counts = counts_.data() + slot * climatology_cells;
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::size_t cell = cell_of(utc_day[i], utc_hour[i]);
+        if (cell == climatology_cells || !std::isfinite(y[i])) continue;
+        sums[cell] += y[i];
+        ++counts[cell];
+    }
+    for (std::size_t cell = 0; cell < climatology_cells; ++cell) {
+        total_sum_[cell] += sums[cell];
+        total_count_[cell] += counts[cell];
+    }
+    return slot;
+}
+
+void ClimatologyBaseline::reference(std::size_t held_out, const std::int64_t* utc_day, const std::int64_t* utc_hour,
+                                    std::size_t count, double* out) const{
+    if (held_out >= years()) throw std::out_of_range("climatology year slot out of range");
+    const double* sums = sums_.data() + held_out * climatology_cells;
+    const std::int64_t* counts = counts_.data() + held_out * climatology_cells;
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::size_t cell = cell_of(utc_day[i], utc_hour[i]);
+        const std::int64_t others = cell == climatology_cells ? 0 : total_count_[cell] - counts[cell];
+        out[i] = others > 0 ? (total_sum_[cell] - sums[cell]) / static_cast<double>(others)
+                            : std::numeric_limits<double>::quiet_NaN();
+    }
+}
+
+FoldErrors ClimatologyBaseline::fold_errors(std::size_t held_out, const std::int64_t* utc_day,
+                                            const std::int64_t* utc_hour, const double* y, const double* model,
+                                            std::size_t count) const{
+    std::vector<double> reference_values(count);
+    reference(held_out, utc_day, utc_hour, count, reference_values.data());
+    std::vector<double> model_squares, reference_squares;
+    model_squares.reserve(count);
+    reference_squares.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const double residual = y[i] - model[i];
+        if (!std::isfinite(residual) || !std::isfinite(reference_values[i])) continue;
+        const double reference_error = y[i] - reference_values[i];
+        model_squares.push_back(residual * residual);
+        reference_squares.push_back(reference_error * reference_error);
+    }
+    FoldErrors errors;
+    errors.count = static_cast<std::int64_t>(model_squares.size());
+    errors.mse_model = numpy_mean(model_squares);
+    errors.mse_ref = numpy_mean(reference_squares);
+    return errors;
+}
+
+} // namespace native
+} // namespace harmoclimat
+
+// ------------------------------------------------------------------ C ABI ---
+
+struct hc_climatology {
+    harmoclimat::native::ClimatologyBaseline impl;
+};
+
+using harmoclimat::native::guarded;
+
+extern "C" {
+
+hc_climatology* hc_climatology_create(){
+    hc_climatology* climatology = nullptr;
+    guarded([&]() { climatology = new hc_climatology{}; });
+    return climatology;
+}
+
+void hc_climatology_destroy(hc_climatology* climatology){ delete climatology; }
+
+int hc_climatology_add_year(hc_climatology* climatology, const std::int64_t* utc_day, const std::int64_t* utc_hour,
+                            const double* y, std::size_t count, std::size_t* slot){
+    return guarded([&]() { *slot = climatology->impl.add_year(utc_day, utc_hour, y, count); });
+}
+
+int hc_climatology_reference(const hc_climatology* climatology, std::size_t slot, const std::int64_t* utc_day,
+                             const std::int64_t* utc_hour, std::size_t count, double* out){
+    return guarded([&]() { climatology->impl.reference(slot, utc_day, utc_hour, count, out); });
+}
+
+int hc_climatology_fold_errors(const hc_climatology* climatology, std::size_t slot, const std::int64_t* utc_day,
+                               const std::int64_t* utc_hour, const double* y, const double* model, std::size_t count,
+                               double* mse_model, double* mse_ref, std::int64_t* valid){
+    return guarded([&]() {
+        const harmoclimat::native::FoldErrors errors =
+            climatology->impl.fold_errors(slot, utc_day, utc_hour, y, model, count);
+        *mse_model = errors.mse_model;
+        *mse_ref = errors.mse_ref;
+        *valid = errors.count;
+    });
+}
+}
@@ -0,0 +1,70 @@
+// Dense UTC climatology baseline of the LOYO evaluation (harmoclimate.evaluation)
+//
+// Every year's observations are summed into 365×24 arrays indexed by
+// (utc_day_index - 1) * 24 + utc_hour, in observation order, and the totals
+// add the years in the order they were given: the summation order of the
+// dictionary-based baseline, so held-out means are the same doubles. The
+// held-out reference of a year is a gather from (total - year) / (count -
+// year count). Fold errors are averaged with NumPy's summation (pairwise
+// within blocks of 8192 values), so they equal np.mean(np.square(errors)).
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace harmoclimat {
+namespace native {
+
+constexpr std::size_t climatology_days = 365;
+constexpr std::size_t climatology_hours = 24;
+constexpr std::size_t climatology_cells = climatology_days * climatology_hours;
+
+struct FoldErrors {
+    double mse_model = 0.0;
+    double mse_ref = 0.0;
+    std::int64_t count = 0;  // observations with a finite model residual and a reference
+};
+
+class ClimatologyBaseline {
+  public:
+    // Adds one year; observations outside the grid (utc_day_index 1..365,
+    // utc_hour 0..23) or with a non-finite value are ignored. Returns the
+    // year slot used by the queries below.
+    std::size_t add_year(const std::int64_t* utc_day, const std::int64_t* utc_hour, const double* y, std::size_t count);
+    std::size_t years() const { return counts_.size() / climatology_cells; }
+
+    // Mean of the other years at each observation's cell, NaN outside the
+    // grid or where only the held-out year has data.
+    void reference(std::size_t held_out, const std::int64_t* utc_day, const std::int64_t* utc_hour, std::size_t count,
+                   double* out) const;
+
+    // MSE of y - model and of y - reference over the observations where both
+    // are finite (count 0 and NaN MSEs when there are none).
+    FoldErrors fold_errors(std::size_t held_out, const std::int64_t* utc_day, const std::int64_t* utc_hour,
+                           const double* y, const double* model, std::size_t count) const;
+
+  private:
+    std::vector<double> sums_;           // years × cells
+    std::vector<std::int64_t> counts_;   // years × cells
+    std::vector<double> total_sum_ = std::vector<double>(climatology_cells, 0.0);
+    std::vector<std::int64_t> total_count_ = std::vector<std::int64_t>(climatology_cells, 0);
+};
+
+} // namespace native
+} // namespace harmoclimat
+
+extern "C" {
+
+struct hc_climatology;
+
+// Functions returning int give 0 on success, -1 on error (see hc_last_error()).
+hc_climatology* hc_climatology_create();
+void hc_climatology_destroy(hc_climatology* climatology);
+int hc_climatology_add_year(hc_climatology* climatology, const std::int64_t* utc_day, const std::int64_t* utc_hour,
+                            const double* y, std::size_t count, std::size_t* slot);
+int hc_climatology_reference(const hc_climatology* climatology, std::size_t slot, const std::int64_t* utc_day,
+                             const std::int64_t* utc_hour, std::size_t count, double* out);
+int hc_climatology_fold_errors(const hc_climatology* climatology, std::size_t slot, const std::int64_t* utc_day,
+                               const std::int64_t* utc_hour, const double* y, const double* model, std::size_t count,
+                               double* mse_model, double* mse_ref, std::int64_t* valid);
+}
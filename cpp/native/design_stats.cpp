@@ -0,0 +1,274 @@
+// Streaming sufficient statistics of the factorized harmonic design (see design_stats.hpp)
+#include "design_stats.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "c_api.hpp"
+
+namespace harmoclimat {
+namespace native {
+namespace {
+
+// Four interleaved sums in a fixed order, so the result does not depend on
+// how the compiler vectorizes the loop.
+double dot(const double* a, const double* b, std::size_t n){
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 += a[i] * b[i];
+        s1 += a[i + 1] * b[i + 1];
+        s2 += a[i + 2] * b[i + 2];
+        s3 += a[i + 3] * b[i + 3];
+    }
+    for (; i < n; ++i) s0 += a[i] * b[i];
+    return (s0 + s1) + (s2 + s3);
+}
+
+unsigned resolve_threads(unsigned threads){
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    return std::max(1u, threads);
+}
+
+} // namespace
+
+DesignLayout::DesignLayout(int diurnal, const std::int32_t* annual_per_param) : n_diurnal(diurnal){
+    if (diurnal < 0 || diurnal > max_harmonics) throw std::invalid_argument("n_diurnal out of range");
+    const std::size_t parameters = 2 * static_cast<std::size_t>(diurnal) + 1;
+    n_annual.assign(annual_per_param, annual_per_param + parameters);
+    for (int n : n_annual) {
+        if (n < 0 || n > max_harmonics) throw std::invalid_argument("n_annual out of range");
+    }
+}
+
+std::size_t DesignLayout::dimension() const{
+    std::size_t total = 0;
+    for (int n : n_annual) total += 2 * static_cast<std::size_t>(n) + 1;
+    return total;
+}
+
+int DesignLayout::max_annual() const{
+    return n_annual.empty() ? 0 : *std::max_element(n_annual.begin(), n_annual.end());
+}
+
+void design_row(const DesignLayout& layout, double day, double hour, double* row){
+    double annual_cos[max_harmonics + 1], annual_sin[max_harmonics + 1];
+    const int annual = layout.max_annual();
+    for (int k = 1; k <= annual; ++k) {
+        const double phase = (k * omega_annual) * day;
+        annual_cos[k] = std::cos(phase);
+        annual_sin[k] = std::sin(phase);
+    }
+    std::size_t column = 0;
+    for (std::size_t p = 0; p < layout.parameter_count(); ++p) {
+        double factor = 1.0;
+        if (p > 0) {
+            const int harmonic = static_cast<int>((p + 1) / 2);
+            const double phase = (harmonic * omega_diurnal) * hour;
+            factor = (p % 2 == 1) ? std::cos(phase) : std::sin(phase);
+        }
+        row[column++] = factor;
+        for (int k = 1; k <= layout.n_annual[p]; ++k) {
+            row[column++] = annual_cos[k] * factor;
+            row[column++] = annual_sin[k] * factor;
+        }
+    }
+}
+
+void design_predict(const DesignLayout& layout, const double* coefficients, const double* day, const double* hour,
+                    std::size_t count, double* out){
+    std::vector<double> row(layout.dimension());
+    for (std::size_t i = 0; i < count; ++i) {
+        design_row(layout, day[i], hour[i], row.data());
+        double value = 0.0;
+        for (std::size_t j = 0; j < row.size(); ++j) value += row[j] * coefficients[j];
+        out[i] = value;
+    }
+}
+
+DesignAccumulator::DesignAccumulator(DesignLayout layout) : layout_(std::move(layout)), dimension_(layout_.dimension()){
+    pending_day_.reserve(block_rows);
+    pending_hour_.reserve(block_rows);
+    pending_y_.reserve(block_rows);
+}
+
+DesignAccumulator::Partial DesignAccumulator::reduce_block(const double* day, const double* hour, const double* y,
+                                                           std::size_t rows) const{
+    // Column-major block: column j of the kept rows is columns[j * block_rows ...].
+    thread_local std::vector<double> columns, targets, row;
+    columns.resize(dimension_ * block_rows);
+    targets.resize(block_rows);
+    row.resize(dimension_);
+
+    std::size_t kept = 0;
+    for (std::size_t r = 0; r < rows; ++r) {
+        if (!std::isfinite(day[r]) || !std::isfinite(hour[r]) || !std::isfinite(y[r])) continue;
+        design_row(layout_, day[r], hour[r], row.data());
+        for (std::size_t j = 0; j < dimension_; ++j) columns[j * block_rows + kept] = row[j];
+        targets[kept++] = y[r];
+    }
+
+    Partial partial;
+    partial.S.assign(dimension_ * dimension_, 0.0);
+    partial.b.assign(dimension_, 0.0);
+    partial.n = static_cast<std::int64_t>(kept);
+    for (std::size_t i = 0; i < dimension_; ++i) {
+        const double* column_i = columns.data() + i * block_rows;
+        for (std::size_t j = i; j < dimension_; ++j) {
+            partial.S[i * dimension_ + j] = dot(column_i, columns.data() + j * block_rows, kept);
+        }
+        partial.b[i] = dot(column_i, targets.data(), kept);
+    }
+    return partial;
+}
+
+void DesignAccumulator::merge_into(Partial& into, const Partial& from) const{
+    for (std::size_t i = 0; i < dimension_; ++i) {
+        for (std::size_t j = i; j < dimension_; ++j) into.S[i * dimension_ + j] += from.S[i * dimension_ + j];
+        into.b[i] += from.b[i];
+    }
+    into.n += from.n;
+}
+
+void DesignAccumulator::push(Partial&& partial){
+    // Binary counter: two sums of 2^k blocks make one of 2^(k+1), so every
+    // block sits at depth log2(blocks) of a fixed pairwise tree.
+    for (std::size_t k = 0;; ++k) {
+        if (k == levels_.size()) {
+            levels_.push_back(std::move(partial));
+            occupied_.push_back(true);
+            return;
+        }
+        if (!occupied_[k]) {
+            levels_[k] = std::move(partial);
+            occupied_[k] = true;
+            return;
+        }
+        merge_into(levels_[k], partial);
+        partial = std::move(levels_[k]);
+        occupied_[k] = false;
+    }
+}
+
+void DesignAccumulator::add(const double* day, const double* hour, const double* y, std::size_t count, unsigned threads){
+    std::size_t first = 0;
+    if (!pending_day_.empty()) {
+        first = std::min(block_rows - pending_day_.size(), count);
+        pending_day_.insert(pending_day_.end(), day, day + first);
+        pending_hour_.insert(pending_hour_.end(), hour, hour + first);
+        pending_y_.insert(pending_y_.end(), y, y + first);
+        if (pending_day_.size() < block_rows) return;
+        push(reduce_block(pending_day_.data(), pending_hour_.data(), pending_y_.data(), block_rows));
+        pending_day_.clear();
+        pending_hour_.clear();
+        pending_y_.clear();
+    }
+
+    // Full blocks are reduced in waves on a pool of threads, then pushed in
+    // row order; the wave bounds the number of live partials.
+    const std::size_t blocks = (count - first) / block_rows;
+    const unsigned workers = resolve_threads(threads);
+    const std::size_t wave = static_cast<std::size_t>(workers) * 8;
+    std::vector<Partial> partials;
+    for (std::size_t wave_start = 0; wave_start < blocks; wave_start += wave) {
+        const std::size_t wave_blocks = std::min(wave, blocks - wave_start);
+        partials.assign(wave_blocks, Partial{});
+        std::atomic<std::size_t> next{0};
+        const auto work = [&]() {
+            for (std::size_t i = next++; i < wave_blocks; i = next++) {
+                const std::size_t offset = first + (wave_start + i) * block_rows;
+                partials[i] = reduce_block(day + offset, hour + offset, y + offset, block_rows);
+            }
+        };
+        const unsigned helpers = static_cast<unsigned>(std::min<std::size_t>(workers, wave_blocks)) - 1;
+        std::vector<std::thread> pool;
+        pool.reserve(helpers);
+        for (unsigned t = 0; t < helpers; ++t) pool.emplace_back(work);
+        work();
+        for (std::thread& thread : pool) thread.join();
+        for (Partial& partial : partials) push(std::move(partial));
+    }
+
+    const std::size_t rest = first + blocks * block_rows;
+    pending_day_.assign(day + rest, day + count);
+    pending_hour_.assign(hour + rest, hour + count);
+    pending_y_.assign(y + rest, y + count);
+}
+
+void DesignAccumulator::result(double* S, double* b) const{
+    Partial total = reduce_block(pending_day_.data(), pending_hour_.data(), pending_y_.data(), pending_day_.size());
+    for (std::size_t k = 0; k < levels_.size(); ++k) {
+        if (occupied_[k]) merge_into(total, levels_[k]);
+    }
+    for (std::size_t i = 0; i < dimension_; ++i) {
+        for (std::size_t j = i; j < dimension_; ++j) {
+            S[i * dimension_ + j] = total.S[i * dimension_ + j];
+            S[j * dimension_ + i] = total.S[i * dimension_ + j];
+        }
+        b[i] = total.b[i];
+    }
+}
+
+std::int64_t DesignAccumulator::count() const{
+    std::int64_t total = 0;
+    for (std::size_t k = 0; k < levels_.size(); ++k) {
+        if (occupied_[k]) total += levels_[k].n;
+    }
+    for (std::size_t r = 0; r < pending_day_.size(); ++r) {
+        total += std::isfinite(pending_day_[r]) && std::isfinite(pending_hour_[r]) && std::isfinite(pending_y_[r]);
+    }
+    return total;
+}
+
+} // namespace native
+} // namespace harmoclimat
+
+// ------------------------------------------------------------------ C ABI ---
+
+struct hc_design_accumulator {
+    harmoclimat::native::DesignAccumulator impl;
+};
+
+using harmoclimat::native::guarded;
+
+extern "C" {
+
+hc_design_accumulator* hc_design_accumulator_create(int n_diurnal, const std::int32_t* n_annual_per_param){
+    hc_design_accumulator* accumulator = nullptr;
+    guarded([&]() {
+        accumulator = new hc_design_accumulator{
+            harmoclimat::native::DesignAccumulator(harmoclimat::native::DesignLayout(n_diurnal, n_annual_per_param))};
+    });
+    return accumulator;
+}
+
+void hc_design_accumulator_destroy(hc_design_accumulator* accumulator){ delete accumulator; }
+
+std::size_t hc_design_accumulator_dimension(const hc_design_accumulator* accumulator){
+    return accumulator->impl.dimension();
+}
+
+int hc_design_accumulator_add(hc_design_accumulator* accumulator, const double* day, const double* hour, const double* y,
+                              std::size_t count, unsigned threads){
+    return guarded([&]() { accumulator->impl.add(day, hour, y, count, threads); });
+}
+
+int hc_design_accumulator_result(const hc_design_accumulator* accumulator, double* S, double* b, std::int64_t* count){
+    return guarded([&]() {
+        accumulator->impl.result(S, b);
+        *count = accumulator->impl.count();
+    });
+}
+
+int hc_design_predict(int n_diurnal, const std::int32_t* n_annual_per_param, const double* coefficients, const double* day,
+                      const double* hour, std::size_t count, double* out){
+    return guarded([&]() {
+        const harmoclimat::native::DesignLayout layout(n_diurnal, n_annual_per_param);
+        harmoclimat::native::design_predict(layout, coefficients, day, hour, count, out);
+    });
+}
+}
@@ -0,0 +1,105 @@
+// Streaming sufficient statistics of the factorized harmonic design
+//
+// DesignAccumulator takes (solar day, solar hour, y) rows and keeps S = X^T X
+// and b = X^T y of the training design matrix (harmoclimate.training) without
+// ever storing X: each block of block_rows rows is expanded into a
+// column-major scratch block, reduced into a partial (S, b), and the partials
+// are merged pairwise through a binary counter. Blocks are cut by input row
+// index, so the summation tree depends only on the row sequence: S and b are
+// bit-identical for any thread count and any split of the rows across add()
+// calls. Rows with a non-finite day, hour or y are skipped.
+//
+// The column layout matches build_global_linear_matrix: one block per
+// parameter c0, a1, b1, ..., a<n_diurnal>, b<n_diurnal>, each the annual basis
+// [1, cos(k w_a d), sin(k w_a d) for k = 1..n_annual] times 1, cos(m w_d h) or
+// sin(m w_d h).
+//
+// The extern "C" functions at the end are the ABI loaded by
+// harmoclimate/native.py.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace harmoclimat {
+namespace native {
+
+// Same expressions as harmoclimate.training: 2 pi / SOLAR_YEAR_DAYS and 2 pi / 24.
+inline constexpr double pi = 3.141592653589793;
+inline constexpr double omega_annual = 2.0 * pi / 365.242189;
+inline constexpr double omega_diurnal = 2.0 * pi / 24.0;
+// Largest annual or diurnal order a DesignLayout accepts.
+inline constexpr int max_harmonics = 64;
+
+struct DesignLayout {
+    int n_diurnal = 0;
+    std::vector<int> n_annual; // per parameter, 2 * n_diurnal + 1 entries
+
+    DesignLayout() = default;
+    DesignLayout(int diurnal, const std::int32_t* annual_per_param);
+    std::size_t parameter_count() const { return n_annual.size(); }
+    std::size_t dimension() const;
+    int max_annual() const;
+};
+
+// Writes the dimension() design columns of one row.
+void design_row(const DesignLayout& layout, double day, double hour, double* row);
+
+// out[i] = X[i] . coefficients, without storing X.
+void design_predict(const DesignLayout& layout, const double* coefficients, const double* day, const double* hour,
+                    std::size_t count, double* out);
+
+class DesignAccumulator {
+  public:
+    static constexpr std::size_t block_rows = 256;
+
+    explicit DesignAccumulator(DesignLayout layout);
+
+    // threads = 0 uses std::thread::hardware_concurrency().
+    void add(const double* day, const double* hour, const double* y, std::size_t count, unsigned threads = 0);
+
+    // Full symmetric S (dimension() x dimension(), row-major) and b, including
+    // the pending partial block. The accumulator is left unchanged.
+    void result(double* S, double* b) const;
+
+    const DesignLayout& layout() const { return layout_; }
+    std::size_t dimension() const { return dimension_; }
+    std::int64_t count() const;
+
+  private:
+    struct Partial {
+        std::vector<double> S; // upper triangle used
+        std::vector<double> b;
+        std::int64_t n = 0;
+    };
+
+    Partial reduce_block(const double* day, const double* hour, const double* y, std::size_t rows) const;
+    void push(Partial&& partial);
+    void merge_into(Partial& into, const Partial& from) const;
+
+    DesignLayout layout_;
+    std::size_t dimension_;
+    std::vector<Partial> levels_; // levels_[k] holds the sum of 2^k blocks when occupied_[k]
+    std::vector<bool> occupied_;
+    std::vector<double> pending_day_, pending_hour_, pending_y_;
+};
+
+} // namespace native
+} // namespace harmoclimat
+
+extern "C" {
+
+struct hc_design_accumulator;
+
+// All functions returning int return 0 on success and -1 on error, with the
+// message available from hc_last_error() on the calling thread (c_api.cpp).
+const char* hc_last_error();
+hc_design_accumulator* hc_design_accumulator_create(int n_diurnal, const std::int32_t* n_annual_per_param);
+void hc_design_accumulator_destroy(hc_design_accumulator* accumulator);
+std::size_t hc_design_accumulator_dimension(const hc_design_accumulator* accumulator);
+int hc_design_accumulator_add(hc_design_accumulator* accumulator, const double* day, const double* hour, const double* y,
+                              std::size_t count, unsigned threads);
+int hc_design_accumulator_result(const hc_design_accumulator* accumulator, double* S, double* b, std::int64_t* count);
+int hc_design_predict(int n_diurnal, const std::int32_t* n_annual_per_param, const double* coefficients, const double* day,
+                      const double* hour, std::size_t count, double* out);
+}
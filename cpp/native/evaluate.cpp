@@ -0,0 +1,177 @@
+// Batch evaluation of fitted models for plots and post-processing (see evaluate.hpp)
+#include "evaluate.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+#include "c_api.hpp"
+
+namespace harmoclimat {
+namespace native {
+namespace {
+
+constexpr double two_pi = 2.0 * pi;
+
+// Diurnal series c[0] + sum_m c[2m-1] cos(m x) + c[2m] sin(m x) and its first
+// two derivatives in x.
+void diurnal_series(const double* c, int n, double x, double& f, double& d1, double& d2){
+    const double cos_x = std::cos(x), sin_x = std::sin(x);
+    double cos_m = 1.0, sin_m = 0.0;
+    f = c[0];
+    d1 = 0.0;
+    d2 = 0.0;
+    for (int m = 1; m <= n; ++m) {
+        const double next_cos = cos_m * cos_x - sin_m * sin_x;
+        sin_m = sin_m * cos_x + cos_m * sin_x;
+        cos_m = next_cos;
+        const double even = c[2 * m - 1] * cos_m + c[2 * m] * sin_m;
+        const double odd = c[2 * m] * cos_m - c[2 * m - 1] * sin_m;
+        f += even;
+        d1 += m * odd;
+        d2 -= m * m * even;
+    }
+}
+
+struct ExtremaSearch {
+    const double* c;
+    int n;
+    double bound_d2;
+    double bound_d3;
+    DailyExtremes out;
+
+    void consider(double x){
+        double f, d1, d2;
+        diurnal_series(c, n, x, f, d1, d2);
+        if (f < out.min) {
+            out.min = f;
+            out.hour_of_min = x;
+        }
+        if (f > out.max) {
+            out.max = f;
+            out.hour_of_max = x;
+        }
+    }
+    // Safeguarded Newton on f' inside a bracket where f' is monotonic.
+    void refine(double lo, double hi, double d1_lo){
+        double x = 0.5 * (lo + hi);
+        for (int it = 0; it < 100 && hi - lo > 1e-15; ++it) {
+            double f, d1, d2;
+            diurnal_series(c, n, x, f, d1, d2);
+            if (d1 == 0.0) break;
+            if ((d1 < 0.0) == (d1_lo < 0.0)) lo = x; else hi = x;
+            const double next = d2 != 0.0 ? x - d1 / d2 : lo;
+            x = (next > lo && next < hi) ? next : 0.5 * (lo + hi);
+        }
+        consider(x);
+    }
+    // No root of f' when |f'| cannot reach zero across the interval, at most
+    // one when f' is monotonic; anything else is bisected.
+    void search(double lo, double hi, double d1_lo, double d2_lo, double d1_hi, double d2_hi, int depth){
+        const double width = hi - lo;
+        if (std::fabs(d1_lo) + std::fabs(d1_hi) > bound_d2 * width) return;
+        if (std::fabs(d2_lo) + std::fabs(d2_hi) > bound_d3 * width) {
+            if ((d1_lo < 0.0) != (d1_hi < 0.0) || d1_lo == 0.0 || d1_hi == 0.0) refine(lo, hi, d1_lo);
+            return;
+        }
+        const double mid = 0.5 * (lo + hi);
+        if (depth >= 48) {
+            consider(mid);
+            return;
+        }
+        double f, d1_mid, d2_mid;
+        diurnal_series(c, n, mid, f, d1_mid, d2_mid);
+        search(lo, mid, d1_lo, d2_lo, d1_mid, d2_mid, depth + 1);
+        search(mid, hi, d1_mid, d2_mid, d1_hi, d2_hi, depth + 1);
+    }
+};
+
+double to_hour(double x){
+    const double hour = x / omega_diurnal;
+    return hour < 24.0 ? hour : hour - 24.0;
+}
+
+} // namespace
+
+void design_diurnal(const DesignLayout& layout, const double* coefficients, const double* day, std::size_t count,
+                    double* out){
+    const std::size_t parameters = layout.parameter_count();
+    const int annual = layout.max_annual();
+    double annual_cos[max_harmonics + 1], annual_sin[max_harmonics + 1];
+    for (std::size_t i = 0; i < count; ++i) {
+        for (int k = 1; k <= annual; ++k) {
+            const double phase = (k * omega_annual) * day[i];
+            annual_cos[k] = std::cos(phase);
+            annual_sin[k] = std::sin(phase);
+        }
+        const double* block = coefficients;
+        for (std::size_t p = 0; p < parameters; ++p) {
+            double value = block[0];
+            for (int k = 1; k <= layout.n_annual[p]; ++k) {
+                value += block[2 * k - 1] * annual_cos[k] + block[2 * k] * annual_sin[k];
+            }
+            out[i * parameters + p] = value;
+            block += 2 * layout.n_annual[p] + 1;
+        }
+    }
+}
+
+DailyExtremes diurnal_extremes(const double* c, int n_diurnal){
+    if (n_diurnal < 0 || n_diurnal > max_harmonics) throw std::invalid_argument("n_diurnal out of range");
+    double f0, d1_lo, d2_lo;
+    diurnal_series(c, n_diurnal, 0.0, f0, d1_lo, d2_lo);
+    ExtremaSearch search{c, n_diurnal, 0.0, 0.0, {c[0], f0, f0, 0.0, 0.0}};
+    for (int m = 1; m <= n_diurnal; ++m) {
+        const double amplitude = std::sqrt(c[2 * m - 1] * c[2 * m - 1] + c[2 * m] * c[2 * m]);
+        search.bound_d2 += m * m * amplitude;
+        search.bound_d3 += static_cast<double>(m) * m * m * amplitude;
+    }
+    if (search.bound_d2 > 0.0) {
+        const int pieces = 8 * n_diurnal;
+        for (int i = 0; i < pieces; ++i) {
+            const double lo = two_pi * i / pieces;
+            const double hi = two_pi * (i + 1) / pieces;
+            double f, d1_hi, d2_hi;
+            diurnal_series(c, n_diurnal, hi, f, d1_hi, d2_hi);
+            search.search(lo, hi, d1_lo, d2_lo, d1_hi, d2_hi, 0);
+            d1_lo = d1_hi;
+            d2_lo = d2_hi;
+        }
+    }
+    search.out.hour_of_min = to_hour(search.out.hour_of_min);
+    search.out.hour_of_max = to_hour(search.out.hour_of_max);
+    return search.out;
+}
+
+} // namespace native
+} // namespace harmoclimat
+
+// ------------------------------------------------------------------ C ABI ---
+
+using harmoclimat::native::guarded;
+
+extern "C" {
+
+int hc_design_diurnal(int n_diurnal, const std::int32_t* n_annual_per_param, const double* coefficients,
+                      const double* day, std::size_t count, double* out){
+    return guarded([&]() {
+        const harmoclimat::native::DesignLayout layout(n_diurnal, n_annual_per_param);
+        harmoclimat::native::design_diurnal(layout, coefficients, day, count, out);
+    });
+}
+
+int hc_diurnal_extremes(int n_diurnal, const double* coefficients, std::size_t count, double* out){
+    return guarded([&]() {
+        const std::size_t terms = 2 * static_cast<std::size_t>(n_diurnal) + 1;
+        for (std::size_t i = 0; i < count; ++i) {
+            const harmoclimat::native::DailyExtremes day =
+                harmoclimat::native::diurnal_extremes(coefficients + i * terms, n_diurnal);
+            double* row = out + 5 * i;
+            row[0] = day.mean;
+            row[1] = day.min;
+            row[2] = day.max;
+            row[3] = day.hour_of_min;
+            row[4] = day.hour_of_max;
+        }
+    });
+}
+}
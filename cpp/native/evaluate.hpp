@@ -0,0 +1,47 @@
+// Batch evaluation of fitted models for plots and post-processing
+//
+// design_diurnal() collapses the annual series of every parameter block at
+// the given solar days: row i holds the diurnal coefficients [c0, a1, b1, ...]
+// of day[i], which design_predict() would combine with the diurnal basis.
+// diurnal_extremes() gives the exact mean, minimum and maximum of one such
+// series over a solar day and the solar hours of its extrema. It is the
+// runtime-order form of the search in the generated headers
+// (DayProfile::stats()): critical points are isolated with Lipschitz bounds
+// on f'' and f''' and refined by safeguarded Newton, so no extremum falls
+// between samples.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "design_stats.hpp"
+
+namespace harmoclimat {
+namespace native {
+
+struct DailyExtremes {
+    double mean = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+    double hour_of_min = 0.0;  // solar hours in [0, 24)
+    double hour_of_max = 0.0;
+};
+
+// out is count x (2 * n_diurnal + 1), row-major.
+void design_diurnal(const DesignLayout& layout, const double* coefficients, const double* day, std::size_t count,
+                    double* out);
+
+// c = [c0, a1, b1, ..., a<n_diurnal>, b<n_diurnal>].
+DailyExtremes diurnal_extremes(const double* c, int n_diurnal);
+
+} // namespace native
+} // namespace harmoclimat
+
+extern "C" {
+
+// Functions returning int give 0 on success, -1 on error (see hc_last_error()).
+int hc_design_diurnal(int n_diurnal, const std::int32_t* n_annual_per_param, const double* coefficients,
+                      const double* day, std::size_t count, double* out);
+// coefficients is count x (2 * n_diurnal + 1); out is count x 5 rows of
+// (mean, min, max, hour_of_min, hour_of_max).
+int hc_diurnal_extremes(int n_diurnal, const double* coefficients, std::size_t count, double* out);
+}
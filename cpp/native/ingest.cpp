@@ -0,0 +1,491 @@
+// Native filter for Météo-France hourly archives (see ingest.hpp)
+#include "ingest.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+#include <zlib.h>
+
+#include "c_api.hpp"
+
+namespace harmoclimat {
+namespace native {
+namespace {
+
+constexpr std::size_t read_block_bytes = 4u << 20;
+constexpr std::size_t queue_blocks = 4;
+
+// Blocks of whole lines handed from the reader thread to the parser.
+class BlockQueue {
+  public:
+    void push(std::string&& block){
+        std::unique_lock<std::mutex> lock(mutex_);
+        space_.wait(lock, [&] { return blocks_.size() < queue_blocks || cancelled_; });
+        blocks_.push_back(std::move(block));
+        ready_.notify_one();
+    }
+    void finish(std::string error = {}){
+        std::lock_guard<std::mutex> lock(mutex_);
+        finished_ = true;
+        error_ = std::move(error);
+        ready_.notify_one();
+    }
+    void cancel(){
+        std::lock_guard<std::mutex> lock(mutex_);
+        cancelled_ = true;
+        space_.notify_all();
+    }
+    bool cancelled(){
+        std::lock_guard<std::mutex> lock(mutex_);
+        return cancelled_;
+    }
+    // False once the reader has finished and every block was taken.
+    bool pop(std::string& block){
+        std::unique_lock<std::mutex> lock(mutex_);
+        ready_.wait(lock, [&] { return !blocks_.empty() || finished_; });
+        if (blocks_.empty()) {
+            if (!error_.empty()) throw std::runtime_error(error_);
+            return false;
+        }
+        block = std::move(blocks_.front());
+        blocks_.pop_front();
+        space_.notify_one();
+        return true;
+    }
+
+  private:
+    std::mutex mutex_;
+    std::condition_variable ready_, space_;
+    std::deque<std::string> blocks_;
+    bool finished_ = false, cancelled_ = false;
+    std::string error_;
+};
+
+// gzread() handles multi-member gzip files and passes plain files through.
+void read_blocks(const std::string& path, BlockQueue& queue){
+    gzFile file = gzopen(path.c_str(), "rb");
+    if (!file) {
+        queue.finish("cannot open " + path);
+        return;
+    }
+    gzbuffer(file, 1u << 20);
+    std::string carry;
+    std::string error;
+    while (!queue.cancelled()) {
+        std::string block = std::move(carry);
+        carry.clear();
+        const std::size_t start = block.size();
+        block.resize(start + read_block_bytes);
+        const int got = gzread(file, block.data() + start, static_cast<unsigned>(read_block_bytes));
+        if (got < 0) {
+            int code = 0;
+            error = path + ": " + gzerror(file, &code);
+            break;
+        }
+        block.resize(start + static_cast<std::size_t>(got));
+        if (got == 0) {
+            if (!block.empty()) queue.push(std::move(block));
+            break;
+        }
+        const std::size_t last_newline = block.rfind('\n');
+        if (last_newline == std::string::npos) {
+            carry = std::move(block);
+            continue;
+        }
+        carry.assign(block, last_newline + 1, std::string::npos);
+        block.resize(last_newline + 1);
+        queue.push(std::move(block));
+    }
+    gzclose(file);
+    queue.finish(std::move(error));
+}
+
+std::string_view trim(std::string_view field){
+    while (!field.empty() && (field.front() == ' ' || field.front() == '\t' || field.front() == '"')) field.remove_prefix(1);
+    while (!field.empty() && (field.back() == ' ' || field.back() == '\t' || field.back() == '"' || field.back() == '\r')) {
+        field.remove_suffix(1);
+    }
+    return field;
+}
+
+// Station codes are sometimes exported as floats ("18033001.0").
+std::string_view normalize_code(std::string_view field){
+    field = trim(field);
+    if (field.size() >= 2 && field.substr(field.size() - 2) == ".0") field.remove_suffix(2);
+    return field;
+}
+
+bool parse_number(std::string_view field, double& value){
+    field = trim(field);
+    if (field.empty()) return false;
+    if (field.front() == '+') field.remove_prefix(1);
+    const auto [end, error] = std::from_chars(field.data(), field.data() + field.size(), value);
+    return error == std::errc() && end == field.data() + field.size() && value == value;
+}
+
+bool parse_digits(const char* text, int count, int& value){
+    value = 0;
+    for (int i = 0; i < count; ++i) {
+        if (text[i] < '0' || text[i] > '9') return false;
+        value = value * 10 + (text[i] - '0');
+    }
+    return true;
+}
+
+// AAAAMMJJHH in local time: trailing ".0" removed, right-padded with zeros
+// to ten digits, as parse_dt_aaaammjjhh does.
+bool parse_local_time(std::string_view field, std::int64_t& local_seconds){
+    field = normalize_code(field);
+    if (field.empty()) return false;
+    char digits[10];
+    for (std::size_t i = 0; i < 10; ++i) digits[i] = i < field.size() ? field[i] : '0';
+    int year = 0, month = 0, day = 0, hour = 0;
+    if (!parse_digits(digits, 4, year) || !parse_digits(digits + 4, 2, month) || !parse_digits(digits + 6, 2, day)
+        || !parse_digits(digits + 8, 2, hour)) {
+        return false;
+    }
+    static constexpr int month_days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    if (month < 1 || month > 12 || day < 1 || hour > 23) return false;
+    const bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    if (day > month_days[month - 1] + (month == 2 && leap)) return false;
+    local_seconds = days_from_civil(year, static_cast<unsigned>(month), static_cast<unsigned>(day)) * 86400 + hour * 3600;
+    return true;
+}
+
+enum Column { code, name, time, temperature, humidity, longitude, latitude, altitude, pressure, column_count };
+constexpr const char* column_names[column_count] = {"NUM_POSTE", "NOM_USUEL", "AAAAMMJJHH", "T", "U",
+                                                    "LON", "LAT", "ALTI", "PSTAT"};
+
+// Per-file state of one station.
+struct StationSlot {
+    IngestTable table;
+    std::unordered_map<std::string, std::uint32_t> name_ids{};
+};
+
+struct FileParser {
+    const DstTable& dst;
+    bool every_station;
+    // Keys view the strings of `codes`, which a deque never moves.
+    std::unordered_map<std::string_view, std::size_t> routes{};
+    std::deque<std::string> codes{};
+    std::deque<StationSlot> slots{};
+    std::uint64_t lines = 0;
+    int index[column_count]{};
+    int last_column = -1;
+    bool have_header = false;
+    std::vector<std::string_view> fields{};
+
+    FileParser(const std::vector<std::string>& station_codes, const DstTable& dst_table)
+        : dst(dst_table), every_station(station_codes.empty()){
+        for (const std::string& station_code : station_codes) add_station(station_code);
+    }
+
+    StationSlot& add_station(std::string_view station_code){
+        codes.emplace_back(station_code);
+        routes.emplace(codes.back(), slots.size());
+        return slots.emplace_back();
+    }
+
+    StationSlot* route(std::string_view station_code){
+        const auto found = routes.find(station_code);
+        if (found != routes.end()) return &slots[found->second];
+        return every_station && !station_code.empty() ? &add_station(station_code) : nullptr;
+    }
+
+    void header(std::string_view line, const std::string& path){
+        std::vector<std::string_view> names;
+        while (true) {
+            const std::size_t semicolon = line.find(';');
+            names.push_back(trim(line.substr(0, semicolon)));
+            if (semicolon == std::string_view::npos) break;
+            line.remove_prefix(semicolon + 1);
+        }
+        std::string missing;
+        for (int c = 0; c < column_count; ++c) {
+            const auto found = std::find(names.begin(), names.end(), std::string_view(column_names[c]));
+            if (found == names.end()) {
+                missing += missing.empty() ? "" : ", ";
+                missing += column_names[c];
+                continue;
+            }
+            index[c] = static_cast<int>(found - names.begin());
+            last_column = std::max(last_column, index[c]);
+        }
+        if (!missing.empty()) throw std::runtime_error("Missing required columns: [" + missing + "] in " + path);
+        have_header = true;
+    }
+
+    void row(std::string_view line){
+        ++lines;
+        // Cheap rejection: only the fields up to NUM_POSTE are located.
+        fields.clear();
+        std::size_t position = 0;
+        for (int f = 0; f <= index[code]; ++f) {
+            const std::size_t semicolon = line.find(';', position);
+            fields.push_back(line.substr(position, semicolon - position));
+            if (semicolon == std::string_view::npos) {
+                if (f < index[code]) return;
+                position = line.size() + 1;
+                break;
+            }
+            position = semicolon + 1;
+        }
+        StationSlot* slot = route(normalize_code(fields[index[code]]));
+        if (slot == nullptr) return;
+        IngestTable& out = slot->table;
+        ++out.matched;
+        for (int f = index[code] + 1; f <= last_column; ++f) {
+            if (position > line.size()) return;
+            const std::size_t semicolon = line.find(';', position);
+            fields.push_back(line.substr(position, semicolon - position));
+            position = semicolon == std::string_view::npos ? line.size() + 1 : semicolon + 1;
+        }
+
+        const std::string_view station_name = trim(fields[index[name]]);
+        if (out.first_name.empty() && !station_name.empty()) out.first_name = std::string(station_name);
+
+        std::int64_t local_seconds = 0, utc_seconds = 0;
+        double values[column_count];
+        for (int c = temperature; c < column_count; ++c) {
+            if (!parse_number(fields[index[c]], values[c])) return;
+        }
+        if (!parse_local_time(fields[index[time]], local_seconds) || !dst.to_utc(local_seconds, utc_seconds)) return;
+
+        const auto [id, inserted] =
+            slot->name_ids.try_emplace(std::string(station_name), static_cast<std::uint32_t>(out.names.size()));
+        if (inserted) out.names.emplace_back(station_name);
+        out.name_index.push_back(id->second);
+        out.utc_seconds.push_back(utc_seconds);
+        out.temperature_c.push_back(static_cast<float>(values[temperature]));
+        out.relative_humidity_percent.push_back(static_cast<float>(std::clamp(values[humidity], 0.0, 100.0)));
+        out.pressure_hpa.push_back(static_cast<float>(values[pressure]));
+        out.longitude_deg.push_back(static_cast<float>(values[longitude]));
+        out.latitude_deg.push_back(static_cast<float>(values[latitude]));
+        out.altitude_m.push_back(static_cast<float>(values[altitude]));
+    }
+};
+
+// Stations of one file, in the order of the requested codes or of first
+// appearance.
+struct FileRows {
+    std::vector<StationRows> stations;
+    std::uint64_t lines = 0;
+};
+
+FileRows ingest_file(const std::string& path, const std::vector<std::string>& station_codes, const DstTable& dst){
+    FileParser parser(station_codes, dst);
+    BlockQueue queue;
+    std::thread reader(read_blocks, std::cref(path), std::ref(queue));
+    try {
+        std::string block;
+        while (queue.pop(block)) {
+            std::string_view rest(block);
+            while (!rest.empty()) {
+                const std::size_t newline = rest.find('\n');
+                std::string_view line = rest.substr(0, newline);
+                rest.remove_prefix(newline == std::string_view::npos ? rest.size() : newline + 1);
+                if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+                if (line.empty()) continue;
+                if (!parser.have_header) {
+                    // A UTF-8 byte order mark may precede the header.
+                    if (line.substr(0, 3) == "\xEF\xBB\xBF") line.remove_prefix(3);
+                    parser.header(line, path);
+                } else {
+                    parser.row(line);
+                }
+            }
+        }
+    } catch (...) {
+        queue.cancel();
+        reader.join();
+        throw;
+    }
+    reader.join();
+
+    FileRows rows;
+    rows.lines = parser.lines;
+    rows.stations.reserve(parser.slots.size());
+    for (std::size_t i = 0; i < parser.slots.size(); ++i) {
+        rows.stations.push_back({std::move(parser.codes[i]), std::move(parser.slots[i].table)});
+    }
+    return rows;
+}
+
+void append(IngestTable& into, IngestTable&& part){
+    std::vector<std::uint32_t> remap(part.names.size());
+    for (std::size_t i = 0; i < part.names.size(); ++i) {
+        const auto found = std::find(into.names.begin(), into.names.end(), part.names[i]);
+        remap[i] = static_cast<std::uint32_t>(found - into.names.begin());
+        if (found == into.names.end()) into.names.push_back(std::move(part.names[i]));
+    }
+    for (std::uint32_t id : part.name_index) into.name_index.push_back(remap[id]);
+    const auto extend = [](auto& to, const auto& from) { to.insert(to.end(), from.begin(), from.end()); };
+    extend(into.utc_seconds, part.utc_seconds);
+    extend(into.temperature_c, part.temperature_c);
+    extend(into.relative_humidity_percent, part.relative_humidity_percent);
+    extend(into.pressure_hpa, part.pressure_hpa);
+    extend(into.longitude_deg, part.longitude_deg);
+    extend(into.latitude_deg, part.latitude_deg);
+    extend(into.altitude_m, part.altitude_m);
+    if (into.first_name.empty()) into.first_name = std::move(part.first_name);
+    into.matched += part.matched;
+}
+
+} // namespace
+
+bool DstTable::to_utc(std::int64_t local_seconds, std::int64_t& utc_seconds) const{
+    // Regime r runs from transitions[r - 1] to transitions[r] at offsets[r];
+    // its wall clock ends at transitions[r] + offsets[r], increasing with r.
+    const std::size_t count = transitions.size();
+    std::size_t low = 0, high = count;
+    while (low < high) {
+        const std::size_t mid = (low + high) / 2;
+        if (transitions[mid] + offsets[mid] > local_seconds) high = mid;
+        else low = mid + 1;
+    }
+    const std::size_t r = low;
+    const bool inside = r == 0 || transitions[r - 1] + offsets[r] <= local_seconds;
+    if (!inside) {
+        utc_seconds = transitions[r - 1];
+        return true;
+    }
+    if (r < count && transitions[r] + offsets[r + 1] <= local_seconds) return false;
+    utc_seconds = local_seconds - offsets[r];
+    return true;
+}
+
+std::vector<StationRows> ingest_stations(const std::vector<std::string>& paths,
+                                         const std::vector<std::string>& station_codes, const DstTable& dst,
+                                         unsigned threads){
+    if (dst.offsets.size() != dst.transitions.size() + 1) throw std::invalid_argument("DST table needs one offset per regime");
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    std::vector<std::string> codes;
+    for (const std::string& station_code : station_codes) {
+        const std::string normalized(normalize_code(station_code));
+        if (std::find(codes.begin(), codes.end(), normalized) == codes.end()) codes.push_back(normalized);
+    }
+
+    std::vector<FileRows> parts(paths.size());
+    std::vector<std::exception_ptr> errors(paths.size());
+    std::atomic<std::size_t> next{0};
+    const auto work = [&]() {
+        for (std::size_t i = next++; i < paths.size(); i = next++) {
+            try {
+                parts[i] = ingest_file(paths[i], codes, dst);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        }
+    };
+    const std::size_t helpers = std::min<std::size_t>(std::max(1u, threads), paths.size());
+    std::vector<std::thread> pool;
+    for (std::size_t t = 1; t < helpers; ++t) pool.emplace_back(work);
+    work();
+    for (std::thread& thread : pool) thread.join();
+
+    // Files are merged in path order, so rows keep the order of a sequential read.
+    std::vector<StationRows> stations;
+    std::unordered_map<std::string, std::size_t> positions;
+    for (const std::string& station_code : codes) {
+        positions.emplace(station_code, stations.size());
+        stations.push_back({station_code, IngestTable{}});
+    }
+    std::uint64_t lines = 0;
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+        if (errors[i]) std::rethrow_exception(errors[i]);
+        lines += parts[i].lines;
+        for (StationRows& part : parts[i].stations) {
+            const auto [position, inserted] = positions.try_emplace(part.code, stations.size());
+            if (inserted) stations.push_back({part.code, IngestTable{}});
+            append(stations[position->second].table, std::move(part.table));
+        }
+        parts[i] = FileRows{};
+    }
+    for (StationRows& station : stations) station.table.lines = lines;
+    return stations;
+}
+
+IngestTable ingest_archives(const std::vector<std::string>& paths, std::string_view station_code, const DstTable& dst,
+                            unsigned threads){
+    return std::move(ingest_stations(paths, {std::string(station_code)}, dst, threads).front().table);
+}
+
+} // namespace native
+} // namespace harmoclimat
+
+// ------------------------------------------------------------------ C ABI ---
+
+struct hc_ingest_result {
+    std::vector<harmoclimat::native::StationRows> stations;
+};
+
+extern "C" {
+
+hc_ingest_result* hc_ingest_archives(const char* const* paths, std::size_t path_count, const char* const* station_codes,
+                                     std::size_t station_count, const std::int64_t* transitions,
+                                     const std::int32_t* offsets, std::size_t transition_count, unsigned threads){
+    hc_ingest_result* result = nullptr;
+    harmoclimat::native::guarded([&]() {
+        harmoclimat::native::DstTable dst;
+        dst.transitions.assign(transitions, transitions + transition_count);
+        dst.offsets.assign(offsets, offsets + transition_count + 1);
+        const std::vector<std::string> files(paths, paths + path_count);
+        const std::vector<std::string> codes(station_codes, station_codes + station_count);
+        result = new hc_ingest_result{harmoclimat::native::ingest_stations(files, codes, dst, threads)};
+    });
+    return result;
+}
+
+void hc_ingest_free(hc_ingest_result* result){ delete result; }
+
+std::size_t hc_ingest_station_count(const hc_ingest_result* result){ return result->stations.size(); }
+
+const char* hc_ingest_station_code(const hc_ingest_result* result, std::size_t station){
+    return result->stations[station].code.c_str();
+}
+
+std::size_t hc_ingest_rows(const hc_ingest_result* result, std::size_t station){
+    return result->stations[station].table.size();
+}
+
+void hc_ingest_counts(const hc_ingest_result* result, std::size_t station, std::uint64_t* lines, std::uint64_t* matched){
+    *lines = result->stations[station].table.lines;
+    *matched = result->stations[station].table.matched;
+}
+
+void hc_ingest_columns(const hc_ingest_result* result, std::size_t station, std::int64_t* utc_seconds,
+                       float* temperature_c, float* relative_humidity_percent, float* pressure_hpa,
+                       float* longitude_deg, float* latitude_deg, float* altitude_m, std::uint32_t* name_index){
+    const harmoclimat::native::IngestTable& t = result->stations[station].table;
+    std::copy(t.utc_seconds.begin(), t.utc_seconds.end(), utc_seconds);
+    std::copy(t.temperature_c.begin(), t.temperature_c.end(), temperature_c);
+    std::copy(t.relative_humidity_percent.begin(), t.relative_humidity_percent.end(), relative_humidity_percent);
+    std::copy(t.pressure_hpa.begin(), t.pressure_hpa.end(), pressure_hpa);
+    std::copy(t.longitude_deg.begin(), t.longitude_deg.end(), longitude_deg);
+    std::copy(t.latitude_deg.begin(), t.latitude_deg.end(), latitude_deg);
+    std::copy(t.altitude_m.begin(), t.altitude_m.end(), altitude_m);
+    std::copy(t.name_index.begin(), t.name_index.end(), name_index);
+}
+
+std::size_t hc_ingest_name_count(const hc_ingest_result* result, std::size_t station){
+    return result->stations[station].table.names.size();
+}
+
+const char* hc_ingest_name(const hc_ingest_result* result, std::size_t station, std::size_t index){
+    return result->stations[station].table.names[index].c_str();
+}
+
+const char* hc_ingest_first_name(const hc_ingest_result* result, std::size_t station){
+    return result->stations[station].table.first_name.c_str();
+}
+}
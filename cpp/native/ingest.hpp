@@ -0,0 +1,99 @@
+// Native filter for Météo-France hourly archives (H_<dept>_<period>.csv.gz)
+//
+// ingest_stations() reads local gzip (or plain) `;`-separated files once and
+// routes the rows of every requested NUM_POSTE to its own table through a
+// hash map on the station code; ingest_archives() keeps a single station.
+// The cleaning is the same as
+// harmoclimate.data_ingest.stream_filter_to_disk: rows with a missing or
+// unparsable timestamp, T, U, PSTAT, LON, LAT or ALTI are dropped, U is
+// clipped to [0, 100], and the local AAAAMMJJHH time is converted to UTC
+// through a DstTable (wall times in a spring-forward gap move to the
+// transition, repeated autumn hours are dropped).
+//
+// Each file is decompressed by zlib on a reader thread that hands blocks of
+// whole lines to the parsing thread, and files run in parallel. Lines are
+// scanned in place: the station code field is looked up before anything else
+// is parsed, and fields are string_views into the block.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <harmoclimat/civil.hpp>
+
+namespace harmoclimat {
+namespace native {
+
+// Offsets (seconds east of UTC) of a time zone: offsets[i] is in force before
+// transitions[i] (UTC seconds, ascending), offsets.back() after the last one.
+struct DstTable {
+    std::vector<std::int64_t> transitions;
+    std::vector<std::int32_t> offsets;
+
+    // False for a wall time that occurs twice; a wall time in a gap maps to
+    // the transition instant.
+    bool to_utc(std::int64_t local_seconds, std::int64_t& utc_seconds) const;
+};
+
+// Kept rows in file order, in the DATASET_COLUMNS units. Station names are
+// stored once and referenced by index.
+struct IngestTable {
+    std::vector<std::string> names;
+    std::vector<std::uint32_t> name_index;
+    std::vector<std::int64_t> utc_seconds;
+    std::vector<float> temperature_c, relative_humidity_percent, pressure_hpa, longitude_deg, latitude_deg, altitude_m;
+    std::string first_name;     // first non-empty NOM_USUEL of the station, valid row or not
+    std::uint64_t lines = 0;    // data lines scanned
+    std::uint64_t matched = 0;  // lines of the station before cleaning
+
+    std::size_t size() const { return utc_seconds.size(); }
+};
+
+struct StationRows {
+    std::string code;
+    IngestTable table;  // lines counts every data line of the archives
+};
+
+// One table per code of `station_codes`, in that order (a code without rows
+// gets an empty table), or one per station found when `station_codes` is
+// empty, in order of first appearance. Throws std::runtime_error for
+// unreadable files or missing columns.
+std::vector<StationRows> ingest_stations(const std::vector<std::string>& paths,
+                                         const std::vector<std::string>& station_codes, const DstTable& dst,
+                                         unsigned threads = 0);
+
+// The table of ingest_stations(paths, {station_code}, dst, threads).
+IngestTable ingest_archives(const std::vector<std::string>& paths, std::string_view station_code, const DstTable& dst,
+                            unsigned threads = 0);
+
+// Days since 1970-01-01 of a proleptic Gregorian date (cpp/include/harmoclimat/civil.hpp).
+using ::harmoclimat::days_from_civil;
+
+} // namespace native
+} // namespace harmoclimat
+
+extern "C" {
+
+struct hc_ingest_result;
+
+// `station_count` 0 keeps every station. Returns null on error (see
+// hc_last_error()); the accessors take a station index below
+// hc_ingest_station_count().
+hc_ingest_result* hc_ingest_archives(const char* const* paths, std::size_t path_count, const char* const* station_codes,
+                                     std::size_t station_count, const std::int64_t* transitions,
+                                     const std::int32_t* offsets, std::size_t transition_count, unsigned threads);
+void hc_ingest_free(hc_ingest_result* result);
+std::size_t hc_ingest_station_count(const hc_ingest_result* result);
+const char* hc_ingest_station_code(const hc_ingest_result* result, std::size_t station);
+std::size_t hc_ingest_rows(const hc_ingest_result* result, std::size_t station);
+void hc_ingest_counts(const hc_ingest_result* result, std::size_t station, std::uint64_t* lines, std::uint64_t* matched);
+// Copies the columns into caller arrays of hc_ingest_rows() elements.
+void hc_ingest_columns(const hc_ingest_result* result, std::size_t station, std::int64_t* utc_seconds,
+                       float* temperature_c, float* relative_humidity_percent, float* pressure_hpa,
+                       float* longitude_deg, float* latitude_deg, float* altitude_m, std::uint32_t* name_index);
+std::size_t hc_ingest_name_count(const hc_ingest_result* result, std::size_t station);
+const char* hc_ingest_name(const hc_ingest_result* result, std::size_t station, std::size_t index);
+const char* hc_ingest_first_name(const hc_ingest_result* result, std::size_t station);
+}
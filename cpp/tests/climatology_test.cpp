@@ -0,0 +1,110 @@
+// Checks harmoclimat::native::ClimatologyBaseline against the dictionary
+// baseline it replaces: held-out means must be the same doubles as per-cell
+// sums kept in std::map, cells outside the grid or filled only by the
+// held-out year give NaN, and fold MSEs match a long double reference.
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "climatology.hpp"
+
+namespace {
+
+struct Year {
+    std::vector<std::int64_t> day, hour;
+    std::vector<double> y;
+};
+
+} // namespace
+
+int main(){
+    using harmoclimat::native::ClimatologyBaseline;
+    using harmoclimat::native::FoldErrors;
+
+    // Three no-leap years of hourly UTC cells with a synthetic target; year 1
+    // is the only one with data on day 365 and has Feb 29 (-1) and NaN rows.
+    std::vector<Year> years(3);
+    std::uint64_t state = 7;
+    for (std::size_t k = 0; k < years.size(); ++k) {
+        const std::int64_t last_day = k == 1 ? 365 : 364;
+        for (std::int64_t d = 1; d <= last_day; ++d) {
+            for (std::int64_t h = 0; h < 24; ++h) {
+                state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+                const double noise = static_cast<double>(state >> 11) / 9007199254740992.0 - 0.5;
+                years[k].day.push_back(d);
+                years[k].hour.push_back(h);
+                years[k].y.push_back(10.0 + 8.0 * std::cos(d / 58.0) + 3.0 * std::sin(h / 3.8) + noise + k);
+            }
+        }
+    }
+    years[1].day.push_back(-1);
+    years[1].hour.push_back(12);
+    years[1].y.push_back(4.0);
+    years[1].y[100] = NAN;
+
+    ClimatologyBaseline baseline;
+    using CellMap = std::map<std::pair<std::int64_t, std::int64_t>, std::pair<double, std::int64_t>>;
+    CellMap total;
+    std::vector<CellMap> per_year(years.size());
+    for (std::size_t k = 0; k < years.size(); ++k) {
+        const Year& year = years[k];
+        if (baseline.add_year(year.day.data(), year.hour.data(), year.y.data(), year.y.size()) != k) return 1;
+        for (std::size_t i = 0; i < year.y.size(); ++i) {
+            if (year.day[i] < 1 || !std::isfinite(year.y[i])) continue;
+            auto& cell = per_year[k][{year.day[i], year.hour[i]}];
+            cell.first += year.y[i];
+            ++cell.second;
+        }
+        for (const auto& [key, cell] : per_year[k]) {
+            total[key].first += cell.first;
+            total[key].second += cell.second;
+        }
+    }
+
+    bool ok = true;
+    std::size_t compared = 0;
+    for (std::size_t k = 0; k < years.size(); ++k) {
+        const Year& year = years[k];
+        std::vector<double> reference(year.y.size()), model(year.y.size());
+        baseline.reference(k, year.day.data(), year.hour.data(), year.y.size(), reference.data());
+        long double model_sum = 0.0L, reference_sum = 0.0L;
+        std::int64_t valid = 0;
+        for (std::size_t i = 0; i < year.y.size(); ++i) {
+            model[i] = year.y[i] - 0.25 * std::sin(static_cast<double>(i));
+            double expected = NAN;
+            const auto found = total.find({year.day[i], year.hour[i]});
+            if (year.day[i] >= 1 && found != total.end()) {
+                const auto excluded = per_year[k].find({year.day[i], year.hour[i]});
+                const double sum = excluded == per_year[k].end() ? 0.0 : excluded->second.first;
+                const std::int64_t count = excluded == per_year[k].end() ? 0 : excluded->second.second;
+                if (found->second.second - count > 0) {
+                    expected = (found->second.first - sum) / static_cast<double>(found->second.second - count);
+                }
+            }
+            ok = ok && (std::isnan(expected) ? std::isnan(reference[i]) : reference[i] == expected);
+            ++compared;
+            const double residual = year.y[i] - model[i];
+            if (!std::isfinite(residual) || !std::isfinite(reference[i])) continue;
+            model_sum += static_cast<long double>(residual) * residual;
+            reference_sum += static_cast<long double>(year.y[i] - reference[i]) * (year.y[i] - reference[i]);
+            ++valid;
+        }
+        const FoldErrors errors =
+            baseline.fold_errors(k, year.day.data(), year.hour.data(), year.y.data(), model.data(), year.y.size());
+        const long double mse_model = model_sum / valid, mse_ref = reference_sum / valid;
+        ok = ok && errors.count == valid
+          && std::fabs(static_cast<long double>(errors.mse_model) - mse_model) < 1e-13L * mse_model
+          && std::fabs(static_cast<long double>(errors.mse_ref) - mse_ref) < 1e-13L * mse_ref;
+    }
+    // Day 365 only exists in year 1, so its held-out reference is missing.
+    const std::int64_t day = 365, hour = 0;
+    double missing = 0.0;
+    baseline.reference(1, &day, &hour, 1, &missing);
+    ok = ok && std::isnan(missing);
+
+    std::printf("climatology: %zu held-out references %s\n", compared, ok ? "match" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,110 @@
+// Checks DayProfile::stats() of one station header through year_daily_stats()
+// against a dense sampling of every integer solar day of the year: the exact
+// extrema must bound every sample and sit within the sampling error of the
+// sampled ones, and the reported hours must hold those values. The sampled
+// extremum is refined by golden-section search; the reported hour must be next
+// to it unless the refined value ties the exact one (two equal extrema).
+//
+// Built by CMake once per station, with HARMOCLIMAT_HEADER_TEST_STATION set to
+// the station namespace and HARMOCLIMAT_HEADER_TEST_HEADER to its header.
+#include <cmath>
+#include <cstdio>
+
+#if !defined(HARMOCLIMAT_HEADER_TEST_STATION) || !defined(HARMOCLIMAT_HEADER_TEST_HEADER)
+#error "Define HARMOCLIMAT_HEADER_TEST_STATION and HARMOCLIMAT_HEADER_TEST_HEADER"
+#endif
+#include HARMOCLIMAT_HEADER_TEST_HEADER
+
+namespace {
+
+namespace station = harmoclimat::HARMOCLIMAT_HEADER_TEST_STATION;
+using harmoclimat::DailyExtremes;
+
+constexpr int samples = 20000;
+constexpr int days = 366;
+const char* const targets[3] = {"temperature", "specific_humidity", "pressure"};
+
+double value_at(const station::DayProfile& profile, int t, double hour_utc){
+    double values[3];
+    profile.predict(hour_utc, values[0], values[1], values[2]);
+    return values[t];
+}
+
+// Extremum of the day's series on [hour - width, hour + width] (sign = +1 for
+// a minimum, -1 for a maximum), by golden-section search.
+double refine(const station::DayProfile& profile, int t, double hour, double width, double sign){
+    const double ratio = 0.6180339887498949;
+    double lo = hour - width, hi = hour + width;
+    for (int it = 0; it < 100; ++it) {
+        const double a = hi - ratio * (hi - lo), b = lo + ratio * (hi - lo);
+        if (sign * value_at(profile, t, a) < sign * value_at(profile, t, b)) hi = b; else lo = a;
+    }
+    return value_at(profile, t, 0.5 * (lo + hi));
+}
+
+double hour_distance(double a, double b){
+    const double d = std::fabs(a - b);
+    return std::fmin(d, 24.0 - d);
+}
+
+}  // namespace
+
+int main(){
+    static harmoclimat::DailyStats stats[days];
+    station::year_daily_stats(stats);
+
+    bool ok = true;
+    for (int day = 0; day < days && ok; ++day) {
+        const station::DayProfile profile = station::DayProfile::from_solar_day(day);
+        const DailyExtremes* exact[3] = {&stats[day].temperature_c, &stats[day].specific_humidity_kg_kg,
+                                         &stats[day].pressure_hpa};
+        for (int t = 0; t < 3; ++t) {
+            const double* c = profile.coeffs[t];
+            // |f - f(sample)| <= max|f''| h^2 / 8 around an extremum, h in radians;
+            // f values themselves carry rounding of order 1e-15 |f|.
+            double bound_d2 = 0.0, scale = std::fabs(c[0]);
+            for (int m = 1; 2 * m < station::detail::diurnal_basis_size; ++m) {
+                const double amplitude = std::hypot(c[2 * m - 1], c[2 * m]);
+                bound_d2 += m * m * amplitude;
+                scale += amplitude;
+            }
+            const double step = 2.0 * 3.141592653589793 / samples;
+            const double rounding = 1e-13 * scale;
+            const double slack = bound_d2 * step * step / 8.0 + rounding;
+
+            double low = INFINITY, high = -INFINITY, hour_low = 0.0, hour_high = 0.0;
+            for (int s = 0; s < samples; ++s) {
+                const double hour = 24.0 * s / samples;
+                const double value = value_at(profile, t, hour);
+                if (value < low) { low = value; hour_low = hour; }
+                if (value > high) { high = value; hour_high = hour; }
+            }
+            const DailyExtremes& e = *exact[t];
+            const bool values_ok = e.mean == c[0] && e.min <= low + rounding && e.min >= low - slack
+                                && e.max >= high - rounding && e.max <= high + slack;
+            const bool hours_ok = e.hour_of_min_utc >= 0.0 && e.hour_of_min_utc < 24.0 && e.hour_of_max_utc >= 0.0
+                               && e.hour_of_max_utc < 24.0
+                               && std::fabs(value_at(profile, t, e.hour_of_min_utc) - e.min) <= rounding
+                               && std::fabs(value_at(profile, t, e.hour_of_max_utc) - e.max) <= rounding;
+            const double near = 2.0 * 24.0 / samples;
+            const double refined_low = refine(profile, t, hour_low, near, 1.0);
+            const double refined_high = refine(profile, t, hour_high, near, -1.0);
+            const bool placed_ok = e.min <= refined_low + rounding && e.max >= refined_high - rounding
+                                && (hour_distance(e.hour_of_min_utc, hour_low) <= near
+                                    || std::fabs(refined_low - e.min) <= rounding)
+                                && (hour_distance(e.hour_of_max_utc, hour_high) <= near
+                                    || std::fabs(refined_high - e.max) <= rounding);
+            if (!(values_ok && hours_ok && placed_ok)) {
+                std::printf("day %d %s: stats (min %.17g at %.9g h, max %.17g at %.9g h) vs samples "
+                            "(min %.17g at %.9g h, max %.17g at %.9g h)\n",
+                            day, targets[t], e.min, e.hour_of_min_utc, e.max, e.hour_of_max_utc, low, hour_low, high,
+                            hour_high);
+                ok = false;
+            }
+        }
+    }
+
+    std::printf("%s: daily stats of %d days %s\n", HARMOCLIMAT_HEADER_TEST_HEADER, days,
+                ok ? "match the sampled series" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,89 @@
+// Checks harmoclimat::native::DesignAccumulator: S and b must be bit-identical
+// for any thread count and any chunking of add(), skip non-finite rows, and
+// match a long double reference built from explicit design rows.
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "design_stats.hpp"
+
+int main(){
+    using harmoclimat::native::DesignAccumulator;
+    using harmoclimat::native::DesignLayout;
+    const std::int32_t n_annual[] = {4, 3, 3, 2, 2, 1, 1};
+    const DesignLayout layout(3, n_annual);
+    const std::size_t dim = layout.dimension();
+
+    // Twenty years of hourly solar features with a synthetic target.
+    const std::size_t rows = 20 * 8760 + 77;
+    std::vector<double> day(rows), hour(rows), y(rows);
+    std::uint64_t state = 42;
+    for (std::size_t i = 0; i < rows; ++i) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        const double noise = static_cast<double>(state >> 11) / 9007199254740992.0 - 0.5;
+        day[i] = std::fmod(i / 24.0, 365.242189) + 0.3;
+        hour[i] = std::fmod(i + 0.16, 24.0);
+        y[i] = 12.0 + 8.0 * std::cos(day[i] / 58.0) + 4.0 * std::sin(hour[i] / 3.8) + noise;
+    }
+    y[1000] = NAN;
+    hour[5000] = INFINITY;
+
+    std::vector<std::vector<double>> results;
+    std::vector<std::int64_t> counts;
+    const auto run = [&](unsigned threads, std::size_t chunk) {
+        DesignAccumulator accumulator(layout);
+        for (std::size_t start = 0; start < rows; start += chunk) {
+            const std::size_t count = std::min(chunk, rows - start);
+            accumulator.add(day.data() + start, hour.data() + start, y.data() + start, count, threads);
+        }
+        std::vector<double> out(dim * dim + dim);
+        accumulator.result(out.data(), out.data() + dim * dim);
+        results.push_back(out);
+        counts.push_back(accumulator.count());
+    };
+    run(1, rows);
+    run(4, rows);
+    run(7, 1000);
+    run(3, 97);
+
+    bool ok = counts[0] == static_cast<std::int64_t>(rows) - 2;
+    for (std::size_t r = 1; r < results.size(); ++r) {
+        if (results[r] != results[0] || counts[r] != counts[0]) {
+            std::printf("run %zu differs from the single-threaded run\n", r);
+            ok = false;
+        }
+    }
+
+    std::vector<long double> S(dim * dim, 0.0L), b(dim, 0.0L);
+    std::vector<double> row(dim);
+    for (std::size_t i = 0; i < rows; ++i) {
+        if (!std::isfinite(y[i]) || !std::isfinite(hour[i])) continue;
+        harmoclimat::native::design_row(layout, day[i], hour[i], row.data());
+        for (std::size_t j = 0; j < dim; ++j) {
+            for (std::size_t k = 0; k < dim; ++k) S[j * dim + k] += static_cast<long double>(row[j]) * row[k];
+            b[j] += static_cast<long double>(row[j]) * y[i];
+        }
+    }
+    double worst = 0.0;
+    for (std::size_t j = 0; j < dim * dim; ++j) {
+        worst = std::fmax(worst, static_cast<double>(std::fabs(results[0][j] - S[j]) / rows));
+    }
+    for (std::size_t j = 0; j < dim; ++j) {
+        worst = std::fmax(worst, static_cast<double>(std::fabs(results[0][dim * dim + j] - b[j]) / (rows * 25.0)));
+    }
+    if (worst > 1e-14) ok = false;
+
+    std::vector<double> coefficients(dim), predicted(3);
+    for (std::size_t j = 0; j < dim; ++j) coefficients[j] = 0.1 * static_cast<double>(j);
+    harmoclimat::native::design_predict(layout, coefficients.data(), day.data(), hour.data(), 3, predicted.data());
+    harmoclimat::native::design_row(layout, day[2], hour[2], row.data());
+    double expected = 0.0;
+    for (std::size_t j = 0; j < dim; ++j) expected += row[j] * coefficients[j];
+    if (predicted[2] != expected) ok = false;
+
+    std::printf("design_stats: %zu rows, dimension %zu, worst error vs long double %.3g %s\n", rows, dim, worst,
+                ok ? "match" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,112 @@
+// Checks the freestanding float/Q15/Q31 variants of one station against its
+// double header on the grid their envelope is computed on (every whole UTC
+// day of a year at 15-minute steps). Each variant must stay within the
+// worst-case |error| its header states; the stated values are rounded to
+// three significant digits, hence the 0.5 % slack.
+//
+// Usage: embedded_test <f32 header> <q15 header> <q31 header>
+// The variants themselves are compiled freestanding in embedded_variants.cpp.
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#if !defined(HARMOCLIMAT_EMBEDDED_STATION) || !defined(HARMOCLIMAT_EMBEDDED_DOUBLE)
+#error "Define HARMOCLIMAT_EMBEDDED_STATION and HARMOCLIMAT_EMBEDDED_DOUBLE"
+#endif
+#include HARMOCLIMAT_EMBEDDED_DOUBLE
+
+namespace embedded {
+void predict_f32(float day_utc, float hour_utc, float (&out)[3]);
+void predict_q15(std::uint32_t day_utc, std::uint32_t second_of_day_utc, std::int32_t (&raw)[3], int (&frac_bits)[3]);
+void predict_q31(std::uint32_t day_utc, std::uint32_t second_of_day_utc, std::int32_t (&raw)[3], int (&frac_bits)[3]);
+}  // namespace embedded
+
+namespace {
+
+namespace station = harmoclimat::HARMOCLIMAT_EMBEDDED_STATION;
+
+constexpr int grid_days = 366;
+constexpr int grid_steps = 96;
+constexpr double rounding_slack = 1.005;
+const char* const targets[3] = {"temperature", "specific_humidity", "pressure"};
+
+// The "Worst-case |error|" lines of a generated header, in target order.
+bool stated_envelope(const char* path, double (&envelope)[3]){
+    std::ifstream in(path);
+    std::string line;
+    int found = 0;
+    while (found < 3 && std::getline(in, line)) {
+        if (line.rfind("//   ", 0) != 0) continue;
+        const std::size_t colon = line.find(':');
+        if (colon == std::string::npos || line.find(targets[found]) == std::string::npos) continue;
+        envelope[found++] = std::strtod(line.c_str() + colon + 1, nullptr);
+    }
+    if (found != 3) std::printf("%s: no worst-case error lines\n", path);
+    return found == 3;
+}
+
+struct Worst {
+    double error[3] = {0.0, 0.0, 0.0};
+    void add(int t, double value, double reference){
+        error[t] = std::fmax(error[t], std::fabs(value - reference));
+        if (std::isnan(value)) error[t] = INFINITY;
+    }
+    bool within(const char* name, const double (&envelope)[3]) const {
+        bool ok = true;
+        for (int t = 0; t < 3; ++t) {
+            if (!(error[t] <= envelope[t] * rounding_slack)) {
+                std::printf("%s %s: |error| %.3g exceeds the stated %.3g\n", name, targets[t], error[t], envelope[t]);
+                ok = false;
+            }
+        }
+        return ok;
+    }
+};
+
+}  // namespace
+
+int main(int argc, char** argv){
+    if (argc != 4) {
+        std::fprintf(stderr, "usage: %s <f32 header> <q15 header> <q31 header>\n", argv[0]);
+        return 2;
+    }
+    double envelopes[3][3];
+    for (int v = 0; v < 3; ++v) {
+        if (!stated_envelope(argv[v + 1], envelopes[v])) return 1;
+    }
+
+    Worst f32, q15, q31;
+    for (int day = 0; day < grid_days; ++day) {
+        for (int step = 0; step < grid_steps; ++step) {
+            const std::uint32_t second = static_cast<std::uint32_t>(step * (86400 / grid_steps));
+            const double hour = second / 3600.0;
+            double reference[3];
+            station::predict(day, hour, reference[0], reference[1], reference[2]);
+
+            float single[3];
+            embedded::predict_f32(static_cast<float>(day), static_cast<float>(hour), single);
+            std::int32_t raw15[3], raw31[3];
+            int frac15[3], frac31[3];
+            embedded::predict_q15(static_cast<std::uint32_t>(day), second, raw15, frac15);
+            embedded::predict_q31(static_cast<std::uint32_t>(day), second, raw31, frac31);
+            for (int t = 0; t < 3; ++t) {
+                f32.add(t, single[t], reference[t]);
+                q15.add(t, std::ldexp(static_cast<double>(raw15[t]), -frac15[t]), reference[t]);
+                q31.add(t, std::ldexp(static_cast<double>(raw31[t]), -frac31[t]), reference[t]);
+            }
+        }
+    }
+
+    bool ok = f32.within("float", envelopes[0]);
+    ok = q15.within("q15", envelopes[1]) && ok;
+    ok = q31.within("q31", envelopes[2]) && ok;
+    std::printf("%s: float/q15/q31 variants %s\n", HARMOCLIMAT_EMBEDDED_DOUBLE,
+                ok ? "within their stated envelopes" : "FAILED");
+    for (int t = 0; t < 3; ++t) {
+        std::printf("  %-17s float %.3g, q15 %.3g, q31 %.3g\n", targets[t], f32.error[t], q15.error[t], q31.error[t]);
+    }
+    return ok ? 0 : 1;
+}
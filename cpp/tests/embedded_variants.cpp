@@ -0,0 +1,42 @@
+// The float, Q15 and Q31 variants of one station behind plain functions.
+//
+// Built on its own with -ffreestanding -Wconversion -Werror (see
+// CMakeLists.txt), so the generated headers are compiled exactly as a
+// microcontroller build would see them; embedded_test.cpp calls the wrappers
+// from a hosted translation unit. HARMOCLIMAT_EMBEDDED_STATION names the
+// station and HARMOCLIMAT_EMBEDDED_F32/_Q15/_Q31 its three headers.
+#include <stdint.h>
+
+#if !defined(HARMOCLIMAT_EMBEDDED_STATION) || !defined(HARMOCLIMAT_EMBEDDED_F32) \
+    || !defined(HARMOCLIMAT_EMBEDDED_Q15) || !defined(HARMOCLIMAT_EMBEDDED_Q31)
+#error "Define HARMOCLIMAT_EMBEDDED_STATION and HARMOCLIMAT_EMBEDDED_F32/_Q15/_Q31"
+#endif
+#include HARMOCLIMAT_EMBEDDED_F32
+#include HARMOCLIMAT_EMBEDDED_Q15
+#include HARMOCLIMAT_EMBEDDED_Q31
+
+#define HARMOCLIMAT_EMBEDDED_JOIN2(a, b) a##b
+#define HARMOCLIMAT_EMBEDDED_JOIN(a, b) HARMOCLIMAT_EMBEDDED_JOIN2(a, b)
+
+namespace embedded {
+
+namespace f32 = harmoclimat::HARMOCLIMAT_EMBEDDED_JOIN(HARMOCLIMAT_EMBEDDED_STATION, _f32);
+namespace q15 = harmoclimat::HARMOCLIMAT_EMBEDDED_JOIN(HARMOCLIMAT_EMBEDDED_STATION, _q15);
+namespace q31 = harmoclimat::HARMOCLIMAT_EMBEDDED_JOIN(HARMOCLIMAT_EMBEDDED_STATION, _q31);
+
+void predict_f32(float day_utc, float hour_utc, float (&out)[3]){
+    f32::predict(day_utc, hour_utc, out[0], out[1], out[2]);
+}
+
+// Raw outputs and the fractional bits of each target.
+void predict_q15(uint32_t day_utc, uint32_t second_of_day_utc, int32_t (&raw)[3], int (&frac_bits)[3]){
+    q15::predict_raw(day_utc, second_of_day_utc, raw[0], raw[1], raw[2]);
+    for (int t = 0; t < 3; ++t) frac_bits[t] = q15::frac_bits[t];
+}
+
+void predict_q31(uint32_t day_utc, uint32_t second_of_day_utc, int32_t (&raw)[3], int (&frac_bits)[3]){
+    q31::predict_raw(day_utc, second_of_day_utc, raw[0], raw[1], raw[2]);
+    for (int t = 0; t < 3; ++t) frac_bits[t] = q31::frac_bits[t];
+}
+
+}  // namespace embedded
@@ -0,0 +1,87 @@
+// Checks harmoclimat::native::design_diurnal against design_predict (the
+// per-day coefficients times the diurnal basis are the model), and
+// diurnal_extremes against a dense sampling of random diurnal series: the
+// exact extrema must bound every sample, sit within the sampling error of the
+// sampled ones, and be the series values at the reported hours.
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "evaluate.hpp"
+
+namespace {
+
+double series(const std::vector<double>& c, double hour){
+    const double x = 2.0 * 3.141592653589793 / 24.0 * hour;
+    double value = c[0];
+    for (std::size_t m = 1; 2 * m < c.size(); ++m) {
+        value += c[2 * m - 1] * std::cos(m * x) + c[2 * m] * std::sin(m * x);
+    }
+    return value;
+}
+
+} // namespace
+
+int main(){
+    using namespace harmoclimat::native;
+    std::uint64_t state = 5;
+    const auto uniform = [&state](double lo, double hi) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return lo + (hi - lo) * (static_cast<double>(state >> 11) / 9007199254740992.0);
+    };
+
+    const std::int32_t n_annual[] = {4, 3, 3, 0, 2, 1, 1};
+    const DesignLayout layout(3, n_annual);
+    std::vector<double> coefficients(layout.dimension());
+    for (double& value : coefficients) value = uniform(-3.0, 3.0);
+    const std::size_t count = 1000;
+    std::vector<double> day(count), hour(count), predicted(count), diurnal(count * layout.parameter_count());
+    for (std::size_t i = 0; i < count; ++i) {
+        day[i] = uniform(0.0, 366.0);
+        hour[i] = uniform(0.0, 24.0);
+    }
+    design_predict(layout, coefficients.data(), day.data(), hour.data(), count, predicted.data());
+    design_diurnal(layout, coefficients.data(), day.data(), count, diurnal.data());
+    bool ok = true;
+    for (std::size_t i = 0; i < count && ok; ++i) {
+        const std::vector<double> c(diurnal.begin() + i * 7, diurnal.begin() + (i + 1) * 7);
+        ok = std::fabs(series(c, hour[i]) - predicted[i]) < 1e-12 * (1.0 + std::fabs(predicted[i]));
+    }
+    if (!ok) std::printf("evaluate: diurnal coefficients differ from design_predict\n");
+
+    bool extremes_ok = true;
+    for (int trial = 0; trial < 200 && extremes_ok; ++trial) {
+        const int n = trial % 5;
+        std::vector<double> c(2 * n + 1);
+        c[0] = uniform(-10.0, 10.0);
+        double bound = 0.0;
+        for (int m = 1; m <= n; ++m) {
+            c[2 * m - 1] = uniform(-4.0, 4.0) / m;
+            c[2 * m] = uniform(-4.0, 4.0) / m;
+            bound += m * m * std::hypot(c[2 * m - 1], c[2 * m]);
+        }
+        const DailyExtremes exact = diurnal_extremes(c.data(), n);
+        const int samples = 100000;
+        double low = INFINITY, high = -INFINITY;
+        for (int s = 0; s < samples; ++s) {
+            const double value = series(c, 24.0 * s / samples);
+            low = std::fmin(low, value);
+            high = std::fmax(high, value);
+        }
+        // |f - f(sample)| <= max|f''| h^2 / 8 around an extremum, h in radians.
+        const double step = 2.0 * 3.141592653589793 / samples;
+        const double slack = bound * step * step / 8.0 + 1e-12;
+        extremes_ok = exact.mean == c[0] && exact.min <= low + 1e-12 && exact.min >= low - slack
+                   && exact.max >= high - 1e-12 && exact.max <= high + slack
+                   && std::fabs(series(c, exact.hour_of_min) - exact.min) < 1e-12
+                   && std::fabs(series(c, exact.hour_of_max) - exact.max) < 1e-12
+                   && exact.hour_of_min >= 0.0 && exact.hour_of_min < 24.0 && exact.hour_of_max >= 0.0
+                   && exact.hour_of_max < 24.0;
+    }
+    if (!extremes_ok) std::printf("evaluate: diurnal extremes differ from the sampled series\n");
+
+    ok = ok && extremes_ok;
+    std::printf("evaluate: %zu days, 200 extrema %s\n", count, ok ? "match" : "FAILED");
+    return ok ? 0 : 1;
+}
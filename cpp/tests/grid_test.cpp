@@ -0,0 +1,122 @@
+// Checks harmoclimat::grid against one-point predict_batch(unix_seconds) for every station
+// in the registry, with small tiles so the threads steal from each other, and
+// the binary and CSV writers against the table, with CSV quoting of codes that
+// hold a comma or a quote.
+//
+// Usage: grid_test <scratch directory>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "harmoclimat_stations.hpp"
+#include <harmoclimat/grid.hpp>
+
+int main(int argc, char** argv){
+    using namespace harmoclimat;
+    if (argc != 2) {
+        std::fprintf(stderr, "usage: %s <scratch directory>\n", argv[0]);
+        return 2;
+    }
+    const std::string scratch = argv[1];
+    std::vector<grid::PredictBatchUnix> kernels;
+    std::vector<std::string_view> codes;
+    for (const StationEntry& entry : stations) {
+        kernels.push_back(entry.predict_batch_unix);
+        codes.push_back(entry.code);
+    }
+    // Ten-minute steps over one year, from just before a UTC midnight.
+    const grid::TimeRange range{1704067200 - 7 * 60, 600, 52561};
+    grid::Options options;
+    options.threads = 4;
+    options.tile_steps = 333;
+    grid::Table table = grid::generate(kernels.data(), kernels.size(), range, false, options);
+
+    bool ok = true;
+    for (std::size_t s = 0; s < station_count && ok; ++s) {
+        for (std::size_t n = 0; n < range.steps; ++n) {
+            double t = 0.0, q = 0.0, p = 0.0;
+            const std::int64_t when = range.at(n);
+            stations[s].predict_batch_unix(&when, 1, &t, &q, &p);
+            const std::size_t i = s * range.steps + n;
+            // The SIMD lanes and the one-lane tail differ only by rounding.
+            if (std::fabs(table.temperature_c[i] - t) > 1e-12 * 40.0 || std::fabs(table.specific_humidity_kg_kg[i] - q) > 1e-12 * 0.02
+                || std::fabs(table.pressure_hpa[i] - p) > 1e-12 * 1100.0) {
+                std::printf("%s step %zu: grid differs from predict_batch\n", std::string(codes[s]).c_str(), n);
+                ok = false;
+                break;
+            }
+        }
+    }
+
+    const std::string binary = scratch + "/grid_test.hcgrid";
+    grid::write_binary(binary, codes.data(), codes.size(), range, table.columns());
+    if (std::FILE* in = std::fopen(binary.c_str(), "rb")) {
+        grid::FileHeader header{};
+        std::vector<char> code_table(16 * codes.size());
+        std::vector<double> pressure(table.pressure_hpa.size());
+        const bool read = std::fread(&header, sizeof(header), 1, in) == 1
+                       && std::fread(code_table.data(), 1, code_table.size(), in) == code_table.size()
+                       && std::fseek(in, static_cast<long>(2 * pressure.size() * sizeof(double)), SEEK_CUR) == 0
+                       && std::fread(pressure.data(), sizeof(double), pressure.size(), in) == pressure.size();
+        std::fclose(in);
+        if (!read || std::memcmp(header.magic, grid::file_magic, 8) != 0 || header.column_count != 3
+            || header.station_count != codes.size() || header.steps != range.steps || pressure != table.pressure_hpa
+            || std::string_view(code_table.data() + 16) != codes[1]) {
+            std::printf("binary file does not round-trip\n");
+            ok = false;
+        }
+    } else {
+        ok = false;
+    }
+
+    const std::string csv = scratch + "/grid_test.csv";
+    grid::write_csv(csv, codes.data(), codes.size(), range, table.columns(), options);
+    if (std::FILE* in = std::fopen(csv.c_str(), "rb")) {
+        std::size_t lines = 0;
+        char last_line[256] = {}, line[256];
+        while (std::fgets(line, sizeof(line), in)) {
+            ++lines;
+            std::memcpy(last_line, line, sizeof(line));
+        }
+        std::fclose(in);
+        const std::size_t last = table.temperature_c.size() - 1;
+        char expected_prefix[64];
+        std::snprintf(expected_prefix, sizeof(expected_prefix), "%s,%lld,", std::string(codes.back()).c_str(),
+                      static_cast<long long>(range.at(range.steps - 1)));
+        if (lines != 1 + codes.size() * range.steps || std::strncmp(last_line, expected_prefix, std::strlen(expected_prefix)) != 0
+            || std::strtod(last_line + std::strlen(expected_prefix), nullptr) != table.temperature_c[last]) {
+            std::printf("CSV has %zu lines or a wrong last row: %s", lines, last_line);
+            ok = false;
+        }
+    } else {
+        ok = false;
+    }
+
+    // Codes with a comma or a quote come out as quoted fields, the others verbatim.
+    const std::string_view odd_codes[3] = {"a,b", "q\"x", "plain"};
+    const char* const odd_prefixes[3] = {"\"a,b\",", "\"q\"\"x\",", "plain,"};
+    const std::string quoted = scratch + "/grid_test_quoted.csv";
+    grid::write_csv(quoted, odd_codes, 3, grid::TimeRange{range.start_unix, 600, 1}, table.columns());
+    if (std::FILE* in = std::fopen(quoted.c_str(), "rb")) {
+        char line[256] = {};
+        bool read = std::fgets(line, sizeof(line), in) != nullptr;
+        for (int s = 0; s < 3 && read; ++s) {
+            read = std::fgets(line, sizeof(line), in) && std::strncmp(line, odd_prefixes[s], std::strlen(odd_prefixes[s])) == 0;
+        }
+        std::fclose(in);
+        if (!read) {
+            std::printf("CSV station codes are not quoted: %s", line);
+            ok = false;
+        }
+    } else {
+        ok = false;
+    }
+
+    std::printf("grid: %zu stations x %zu steps %s\n", codes.size(), range.steps, ok ? "match" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,104 @@
+"""Runs one gzip archive through the native and the pandas ingesters.
+
+Both paths of ``data_ingest.stream_stations_to_disk`` must keep the same rows
+with the same values and dtypes, and pick the same station name. The archive
+holds the cases where they could drift: padded, quoted, empty and
+whitespace-only names, a station whose first name is blank, CRLF lines, float
+codes and times, missing values, the spring-forward gap and the repeated
+autumn hour of Europe/Paris.
+
+Usage: ingest_paths_test.py <scratch directory>, with PYTHONPATH on src/ and
+HARMOCLIMATE_NATIVE_LIB on the CMake harmoclimate_native library.
+"""
+
+from __future__ import annotations
+
+import gzip
+import sys
+from pathlib import Path
+from types import SimpleNamespace
+
+import pandas as pd
+
+from harmoclimate import data_ingest, native
+
+HEADER = "NUM_POSTE;NOM_USUEL;LAT;LON;ALTI;AAAAMMJJHH;RR1;T;U;PSTAT\n"
+ROWS = (
+    "18033001; BOURGES ;47.059;2.359;161;2024010100;0;3.5;87;1001.2\n"
+    "18033001;;47.059;2.359;161;2024010101;0;3.4;88;1001.0\n"
+    "18033001;   ;47.059;2.359;161;2024010102;0;3.3;88;1000.9\n"
+    '18033001;"BOURGES";47.059;2.359;161;2024010103;0;3.2;89;1000.8\n'
+    "18033001;\tBOURGES\t;47.059;2.359;161;2024033101;0;4.0;120;1000.0\r\n"
+    "18033001;BOURGES;47.059;2.359;161;2024033102;0;4.1;-3;1000.1\n"
+    "18033001;BOURGES;47.059;2.359;161;2024033103;0;4.2;80;1000.2\n"
+    "18033001;BOURGES;47.059;2.359;161;2024102702;0;9.0;80;1010.0\n"
+    "18033001;BOURGES;47.059;2.359;161;2024102703;0;9.5;80;1010.5\n"
+    "18033001;BOURGES;47.059;2.359;161;2024060112;0;;80;1000.0\n"
+    "18033001.0;BOURGES;47.059;2.359;161;2024060113;0;20.5;60;1005.0\n"
+    "18015003;  ;47.05;2.63;176;2024010100;0;3.1;90;998.0\n"
+    "18015003;;47.05;2.63;176;2024010101;0;3.0;91;997.9\n"
+    "18015003;AVORD ;47.05;2.63;176;2024010102;0;2.9;91;997.8\n"
+    "18015003;AVORD;47.05;2.63;176;2024010103;0;2.8;;997.7\n"
+)
+
+
+def ingest(archive: Path, scratch: Path, *, use_native: bool) -> dict[str, tuple[pd.DataFrame, str]]:
+    """Frames and station names of every station, through one path; parquet goes to ``scratch``."""
+
+    load_library = native.load_library
+    artifact_paths = data_ingest.build_artifact_paths
+    data_ingest.build_artifact_paths = lambda slug: SimpleNamespace(parquet=scratch / f"{slug}.parquet")
+    if not use_native:
+        native.load_library = lambda: None
+    try:
+        results = data_ingest.stream_stations_to_disk([str(archive)], chunk_size=4)
+    finally:
+        native.load_library = load_library
+        data_ingest.build_artifact_paths = artifact_paths
+    frames = {}
+    for code, result in results.items():
+        frames[code] = (pd.read_parquet(result.parquet_path), result.station_name)
+        result.parquet_path.unlink()
+    return frames
+
+
+def main(argv: list[str]) -> int:
+    if len(argv) != 2:
+        print(f"usage: {argv[0]} <scratch directory>", file=sys.stderr)
+        return 2
+    if native.load_library() is None:
+        print("ingest_paths: native library unavailable")
+        return 1
+    scratch = Path(argv[1]) / "ingest_paths"
+    scratch.mkdir(parents=True, exist_ok=True)
+    archive = scratch / "ingest_paths.csv.gz"
+    # Two gzip members, as `cat a.gz b.gz` produces; the split falls mid-station.
+    split = ROWS.index("18033001;BOURGES;47.059;2.359;161;2024033103")
+    archive.write_bytes(gzip.compress((HEADER + ROWS[:split]).encode()) + gzip.compress(ROWS[split:].encode()))
+
+    native_frames = ingest(archive, scratch, use_native=True)
+    pandas_frames = ingest(archive, scratch, use_native=False)
+    ok = sorted(native_frames) == sorted(pandas_frames) == ["18015003", "18033001"]
+    if not ok:
+        print(f"ingest_paths: stations {sorted(native_frames)} (native) vs {sorted(pandas_frames)} (pandas)")
+    for code in sorted(set(native_frames) & set(pandas_frames)):
+        (native_rows, native_name), (pandas_rows, pandas_name) = native_frames[code], pandas_frames[code]
+        if native_name != pandas_name:
+            print(f"ingest_paths {code}: station name {native_name!r} (native) vs {pandas_name!r} (pandas)")
+            ok = False
+        try:
+            pd.testing.assert_frame_equal(native_rows, pandas_rows)
+        except AssertionError as exc:
+            print(f"ingest_paths {code}: frames differ\n{exc}")
+            ok = False
+        blank = int(pandas_rows["STATION_NAME"].isna().sum())
+        if code == "18033001" and blank != 2:
+            print(f"ingest_paths {code}: {blank} <NA> names, expected 2")
+            ok = False
+
+    print(f"ingest_paths: native and pandas ingesters {'agree' if ok else 'FAILED'}")
+    return 0 if ok else 1
+
+
+if __name__ == "__main__":
+    raise SystemExit(main(sys.argv))
@@ -0,0 +1,116 @@
+// Checks harmoclimat::native::ingest_archives on a two-member gzip archive
+// written here: station filtering, cleaning, the spring-forward gap and the
+// repeated autumn hour of Europe/Paris, and a missing-column error; then the
+// single-pass routing of ingest_stations for every station and for a list.
+//
+// Usage: ingest_test <scratch directory>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <zlib.h>
+
+#include "ingest.hpp"
+
+namespace {
+
+bool write_gzip(const std::string& path, const std::vector<std::string>& members){
+    std::FILE* out = std::fopen(path.c_str(), "wb");
+    if (!out) return false;
+    for (const std::string& text : members) {
+        // Each member is a complete gzip stream, as `cat a.gz b.gz` produces.
+        z_stream stream{};
+        deflateInit2(&stream, 6, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+        std::vector<unsigned char> buffer(deflateBound(&stream, text.size()) + 64);
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(text.data()));
+        stream.avail_in = static_cast<uInt>(text.size());
+        stream.next_out = buffer.data();
+        stream.avail_out = static_cast<uInt>(buffer.size());
+        deflate(&stream, Z_FINISH);
+        std::fwrite(buffer.data(), 1, stream.total_out, out);
+        deflateEnd(&stream);
+    }
+    std::fclose(out);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv){
+    using namespace harmoclimat::native;
+    if (argc != 2) {
+        std::fprintf(stderr, "usage: %s <scratch directory>\n", argv[0]);
+        return 2;
+    }
+    const std::string scratch = argv[1];
+
+    // Europe/Paris in 2024: CET (+1 h) until 03-31 01:00 UTC, CEST (+2 h)
+    // until 10-27 01:00 UTC, then CET.
+    DstTable paris;
+    paris.transitions = {days_from_civil(2024, 3, 31) * 86400 + 3600, days_from_civil(2024, 10, 27) * 86400 + 3600};
+    paris.offsets = {3600, 7200, 3600};
+
+    const std::string header = "NUM_POSTE;NOM_USUEL;LAT;LON;ALTI;AAAAMMJJHH;RR1;T;U;PSTAT\n";
+    const std::string first_member = header
+        + "18033001; BOURGES ;47.059;2.359;161;2024010100;0;3.5;87;1001.2\n"
+          "18015003;AVORD;47.05;2.63;176;2024010100;0;3.1;90;998.0\n"
+          "18033001;BOURGES;47.059;2.359;161;2024033101;0;4.0;120;1000.0\r\n"
+          "18033001;BOURGES;47.059;2.359;161;2024033102;0;4.1;-3;1000.1\n";
+    const std::string second_member =
+        "18033001;BOURGES;47.059;2.359;161;2024033103;0;4.2;80;1000.2\n"
+        "18033001;BOURGES;47.059;2.359;161;2024102702;0;9.0;80;1010.0\n"
+        "18033001;BOURGES;47.059;2.359;161;2024102703;0;9.5;80;1010.5\n"
+        "18033001;BOURGES;47.059;2.359;161;2024023012;0;5.0;80;1000.0\n"
+        "18033001;BOURGES;47.059;2.359;161;2024060112;0;;80;1000.0\n"
+        "18033001.0;BOURGES;47.059;2.359;161;2024060113.0;0;20.5;60;1005.0\n"
+        "18033001;BOURGES;47.059\n";
+    const std::string archive = scratch + "/ingest_test.csv.gz";
+    const std::string broken = scratch + "/ingest_test_broken.csv.gz";
+    if (!write_gzip(archive, {first_member, second_member}) || !write_gzip(broken, {"NUM_POSTE;T\n1;2\n"})) return 1;
+
+    const IngestTable table = ingest_archives({archive, archive}, "18033001", paris, 2);
+    const auto utc = [](int month, int day, int hour) { return days_from_civil(2024, month, day) * 86400 + hour * 3600; };
+    // Per archive: 01-01 00 (CET), 03-31 01 (CET), 03-31 02 (gap -> 01:00 UTC),
+    // 03-31 03 (CEST), 10-27 03 (CET), 06-01 13 (float-formatted code/time);
+    // 10-27 02 is repeated, 02-30 is invalid, the empty T and short line drop.
+    const std::vector<std::int64_t> expected = {utc(1, 1, 0) - 3600, utc(3, 31, 0), utc(3, 31, 1), utc(3, 31, 1),
+                                                utc(10, 27, 2), utc(6, 1, 11)};
+    bool ok = table.size() == 2 * expected.size() && table.lines == 2 * 11 && table.matched == 2 * 10;
+    for (std::size_t i = 0; ok && i < table.size(); ++i) {
+        ok = table.utc_seconds[i] == expected[i % expected.size()];
+    }
+    ok = ok && table.names.size() == 1 && table.names[0] == "BOURGES" && table.first_name == "BOURGES"
+      && table.relative_humidity_percent[1] == 100.0f && table.relative_humidity_percent[2] == 0.0f
+      && table.temperature_c[5] == 20.5f && table.pressure_hpa[0] == 1001.2f && table.altitude_m[0] == 161.0f;
+    if (!ok) std::printf("ingest: kept rows differ from the expected cleaning\n");
+
+    bool threw = false;
+    try {
+        ingest_archives({archive, broken}, "18033001", paris, 1);
+    } catch (const std::runtime_error& error) {
+        threw = std::string(error.what()).find("Missing required columns") != std::string::npos;
+    }
+    if (!threw) {
+        std::printf("ingest: missing columns were not reported\n");
+        ok = false;
+    }
+
+    const std::vector<StationRows> every = ingest_stations({archive, archive}, {}, paris, 2);
+    const bool routed = every.size() == 2 && every[0].code == "18033001" && every[1].code == "18015003"
+                     && every[0].table.utc_seconds == table.utc_seconds && every[1].table.size() == 2
+                     && every[1].table.first_name == "AVORD" && every[1].table.lines == table.lines
+                     && every[1].table.temperature_c[1] == 3.1f;
+    const std::vector<StationRows> listed = ingest_stations({archive}, {"99000001", "18015003.0"}, paris, 1);
+    const bool requested = listed.size() == 2 && listed[0].code == "99000001" && listed[0].table.size() == 0
+                        && listed[1].code == "18015003" && listed[1].table.size() == 1 && listed[1].table.matched == 1;
+    if (!routed || !requested) {
+        std::printf("ingest: per-station routing differs from the single-station filter\n");
+        ok = false;
+    }
+
+    std::printf("ingest: %zu rows from %llu lines %s\n", table.size(), static_cast<unsigned long long>(table.lines),
+                ok ? "match" : "FAILED");
+    return ok ? 0 : 1;
+}
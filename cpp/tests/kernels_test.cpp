@@ -0,0 +1,125 @@
+// Checks the precompiled kernels of one station (harmoclimate::kernels)
+// against the inline functions of its header.
+//
+// Built by CMake once per station, with HARMOCLIMAT_KERNELS_TEST_STATION set to
+// the station namespace and HARMOCLIMAT_KERNELS_TEST_HEADER to its header.
+// Exits non-zero and prints the worst deviation when a path disagrees.
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include <harmoclimat/kernels.hpp>
+
+#if !defined(HARMOCLIMAT_KERNELS_TEST_STATION) || !defined(HARMOCLIMAT_KERNELS_TEST_HEADER)
+#error "Define HARMOCLIMAT_KERNELS_TEST_STATION and HARMOCLIMAT_KERNELS_TEST_HEADER"
+#endif
+#include HARMOCLIMAT_KERNELS_TEST_HEADER
+
+namespace {
+
+namespace station = harmoclimat::HARMOCLIMAT_KERNELS_TEST_STATION;
+namespace kernels = harmoclimat::kernels::HARMOCLIMAT_KERNELS_TEST_STATION;
+using real = harmoclimat::kernels::real;
+
+// Relative to the largest reference value of each target. Float mode rounds
+// the outputs to single precision; double mode only differs by the SIMD width.
+constexpr double tolerance = std::is_same_v<real, double> ? 1e-12 : 2e-7;
+constexpr std::size_t count = 4099;  // not a multiple of any lane or staging block
+
+struct Arrays {
+    std::vector<double> t, q, p;
+    Arrays() : t(count), q(count), p(count) {}
+};
+
+bool compare(const char* name, const Arrays& reference, const std::vector<real> (&actual)[3]){
+    const std::vector<double>* targets[3] = {&reference.t, &reference.q, &reference.p};
+    bool ok = true;
+    for (int k = 0; k < 3; ++k) {
+        double scale = 0.0, worst = 0.0;
+        for (std::size_t i = 0; i < count; ++i) {
+            scale = std::max(scale, std::fabs((*targets[k])[i]));
+            worst = std::max(worst, std::fabs(static_cast<double>(actual[k][i]) - (*targets[k])[i]));
+        }
+        const double relative = scale > 0.0 ? worst / scale : worst;
+        if (!(relative <= tolerance)) {
+            std::printf("%s target %d: relative error %.3g exceeds %.3g\n", name, k, relative, tolerance);
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+}  // namespace
+
+int main(){
+    // Inputs are drawn in `real` so both sides evaluate the same points.
+    std::mt19937_64 rng(7);
+    std::uniform_real_distribution<double> day(-2000.0, 20000.0), hour(-48.0, 48.0), duration(0.0, 24.0 * 90.0);
+    std::uniform_int_distribution<std::int64_t> second(-2208988800LL, 4102444800LL);  // 1900 to 2100
+    std::vector<real> day_utc(count), hour_utc(count), duration_hours(count);
+    std::vector<double> day_wide(count), hour_wide(count), duration_wide(count);
+    std::vector<std::int64_t> unix_seconds(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        day_utc[i] = static_cast<real>(day(rng));
+        hour_utc[i] = static_cast<real>(hour(rng));
+        duration_hours[i] = static_cast<real>(duration(rng));
+        day_wide[i] = day_utc[i];
+        hour_wide[i] = hour_utc[i];
+        duration_wide[i] = duration_hours[i];
+        unix_seconds[i] = second(rng);
+    }
+
+    Arrays reference;
+    std::vector<real> actual[3] = {std::vector<real>(count), std::vector<real>(count), std::vector<real>(count)};
+    bool ok = true;
+
+    station::predict_batch(day_wide.data(), hour_wide.data(), count, reference.t.data(), reference.q.data(), reference.p.data());
+    kernels::predict_batch(day_utc.data(), hour_utc.data(), count, actual[0].data(), actual[1].data(), actual[2].data());
+    ok = compare("predict_batch", reference, actual) && ok;
+
+    station::predict_batch(unix_seconds.data(), count, reference.t.data(), reference.q.data(), reference.p.data());
+    kernels::predict_batch(unix_seconds.data(), count, actual[0].data(), actual[1].data(), actual[2].data());
+    ok = compare("predict_batch(unix_seconds)", reference, actual) && ok;
+
+    station::integrate_batch(day_wide.data(), hour_wide.data(), duration_wide.data(), count, reference.t.data(),
+                             reference.q.data(), reference.p.data());
+    kernels::integrate_batch(day_utc.data(), hour_utc.data(), duration_hours.data(), count, actual[0].data(),
+                             actual[1].data(), actual[2].data());
+    ok = compare("integrate_batch", reference, actual) && ok;
+
+    // Non-finite inputs give NaN on the scalar path, the header batch and the kernels alike.
+    const double bad_day[] = {NAN, 100.0, -INFINITY, 100.0, INFINITY};
+    const double bad_hour[] = {12.0, INFINITY, 3.0, NAN, -INFINITY};
+    for (std::size_t i = 0; i < std::size(bad_day); ++i) {
+        double t, q, p, bt, bq, bp;
+        real kt, kq, kp;
+        const real kernel_day = static_cast<real>(bad_day[i]), kernel_hour = static_cast<real>(bad_hour[i]);
+        station::predict(bad_day[i], bad_hour[i], t, q, p);
+        station::predict_batch(&bad_day[i], &bad_hour[i], 1, &bt, &bq, &bp);
+        kernels::predict_batch(&kernel_day, &kernel_hour, 1, &kt, &kq, &kp);
+        if (!(std::isnan(t) && std::isnan(q) && std::isnan(p) && std::isnan(bt) && std::isnan(bq) && std::isnan(bp)
+              && std::isnan(kt) && std::isnan(kq) && std::isnan(kp))) {
+            std::printf("predict(%g, %g): non-finite input did not give NaN\n", bad_day[i], bad_hour[i]);
+            ok = false;
+        }
+    }
+
+    const harmoclimat::kernels::KernelEntry* entry = nullptr;
+    for (const auto& candidate : harmoclimat::kernels::stations) {
+        if (candidate.predict_batch == static_cast<decltype(candidate.predict_batch)>(&kernels::predict_batch)) entry = &candidate;
+    }
+    if (entry == nullptr || harmoclimat::kernels::find_station(entry->code) != entry) {
+        std::printf("station table: missing or ambiguous entry\n");
+        ok = false;
+    }
+
+    std::printf("%s: kernels (%s, %s) %s\n", HARMOCLIMAT_KERNELS_TEST_HEADER,
+                harmoclimat::kernels::simd_level.data(), std::is_same_v<real, double> ? "double" : "float",
+                ok ? "match the header" : "FAILED");
+    return ok ? 0 : 1;
+}
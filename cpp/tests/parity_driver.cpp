@@ -0,0 +1,145 @@
+// Evaluates one generated station header through each of its code paths on a
+// grid of solar coordinates, for comparison with the Python model.
+//
+// Build with the header directory on the include path and the header name in
+// HARMOCLIMAT_PARITY_HEADER (see harmoclimate/parity.py, `python main.py parity`).
+// Usage: parity_driver <grid.bin> <out.bin>
+//   grid.bin : uint64 count, then count day_solar and count hour_solar doubles.
+//   out.bin  : for every path in "paths" of the JSON object printed on stdout,
+//              the temperature, specific humidity and pressure arrays, count
+//              doubles each; then, for every path in "derived", the relative
+//              humidity, dew point and vapour pressure arrays.
+// The predict_full paths are only built when the header found
+// harmoclimat_psychrometrics.hpp next to it or on the include path.
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#ifndef HARMOCLIMAT_PARITY_HEADER
+#error "Define HARMOCLIMAT_PARITY_HEADER to the station header to check"
+#endif
+#include HARMOCLIMAT_PARITY_HEADER
+
+namespace {
+
+struct Outputs {
+    std::vector<double> temperature_c, specific_humidity_kg_kg, pressure_hpa;
+    explicit Outputs(std::size_t n) : temperature_c(n), specific_humidity_kg_kg(n), pressure_hpa(n) {}
+};
+
+struct Derived {
+    std::vector<double> relative_humidity_percent, dew_point_c, vapor_pressure_hpa;
+    explicit Derived(std::size_t n) : relative_humidity_percent(n), dew_point_c(n), vapor_pressure_hpa(n) {}
+};
+
+void print_names(const std::vector<const char*>& names){
+    std::printf("[");
+    for (std::size_t p = 0; p < names.size(); ++p) std::printf("%s\"%s\"", p ? ", " : "", names[p]);
+    std::printf("]");
+}
+
+}  // namespace
+
+int main(int argc, char** argv){
+    using namespace harmoclimat;
+    if (argc != 3) {
+        std::fprintf(stderr, "usage: %s <grid.bin> <out.bin>\n", argv[0]);
+        return 2;
+    }
+    std::FILE* in = std::fopen(argv[1], "rb");
+    if (!in) {
+        std::perror(argv[1]);
+        return 1;
+    }
+    std::uint64_t count = 0;
+    if (std::fread(&count, sizeof(count), 1, in) != 1) return 1;
+    const std::size_t n = static_cast<std::size_t>(count);
+    std::vector<double> day_solar(n), hour_solar(n);
+    if (std::fread(day_solar.data(), sizeof(double), n, in) != n) return 1;
+    if (std::fread(hour_solar.data(), sizeof(double), n, in) != n) return 1;
+    std::fclose(in);
+
+    // The UTC entry points take the inverse of the header's solar shift.
+    std::vector<double> day_utc(n), hour_utc(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        day_utc[i] = day_solar[i] - delta_utc_solar_h / 24.0;
+        hour_utc[i] = hour_solar[i] - delta_utc_solar_h;
+    }
+
+    std::vector<const char*> names = {"evaluate", "predict_single", "predict", "predict_batch",
+                                      "predict_constexpr", "day_profile", "window_mean"};
+    std::vector<const char*> derived_names;
+#if defined(HARMOCLIMAT_PSYCHROMETRICS)
+    names.push_back("predict_full");
+    names.push_back("predict_full_batch");
+    derived_names = {"predict_full", "predict_full_batch"};
+#endif
+    std::vector<Outputs> paths(names.size(), Outputs(n));
+    std::vector<Derived> derived(derived_names.size(), Derived(n));
+    for (std::size_t i = 0; i < n; ++i) {
+        paths[0].temperature_c[i] = temperature_model::evaluate(day_solar[i], hour_solar[i]);
+        paths[0].specific_humidity_kg_kg[i] = specific_humidity_model::evaluate(day_solar[i], hour_solar[i]);
+        paths[0].pressure_hpa[i] = pressure_model::evaluate(day_solar[i], hour_solar[i]);
+
+        paths[1].temperature_c[i] = predict_temperature(day_utc[i], hour_utc[i]);
+        paths[1].specific_humidity_kg_kg[i] = predict_specific_humidity(day_utc[i], hour_utc[i]);
+        paths[1].pressure_hpa[i] = predict_pressure(day_utc[i], hour_utc[i]);
+
+        predict(day_utc[i], hour_utc[i], paths[2].temperature_c[i], paths[2].specific_humidity_kg_kg[i],
+                paths[2].pressure_hpa[i]);
+
+        const Prediction constant = predict_constexpr(day_utc[i], hour_utc[i]);
+        paths[4].temperature_c[i] = constant.temperature_c;
+        paths[4].specific_humidity_kg_kg[i] = constant.specific_humidity_kg_kg;
+        paths[4].pressure_hpa[i] = constant.pressure_hpa;
+
+        DayProfile::from_utc_day(day_utc[i]).predict(hour_utc[i], paths[5].temperature_c[i],
+                                                     paths[5].specific_humidity_kg_kg[i], paths[5].pressure_hpa[i]);
+
+        const Prediction point = window_mean(day_utc[i], hour_utc[i], 0.0);
+        paths[6].temperature_c[i] = point.temperature_c;
+        paths[6].specific_humidity_kg_kg[i] = point.specific_humidity_kg_kg;
+        paths[6].pressure_hpa[i] = point.pressure_hpa;
+    }
+    predict_batch(day_utc.data(), hour_utc.data(), n, paths[3].temperature_c.data(),
+                  paths[3].specific_humidity_kg_kg.data(), paths[3].pressure_hpa.data());
+#if defined(HARMOCLIMAT_PSYCHROMETRICS)
+    for (std::size_t i = 0; i < n; ++i) {
+        const FullPrediction full = predict_full(day_utc[i], hour_utc[i]);
+        paths[7].temperature_c[i] = full.temperature_c;
+        paths[7].specific_humidity_kg_kg[i] = full.specific_humidity_kg_kg;
+        paths[7].pressure_hpa[i] = full.pressure_hpa;
+        derived[0].relative_humidity_percent[i] = full.relative_humidity_percent;
+        derived[0].dew_point_c[i] = full.dew_point_c;
+        derived[0].vapor_pressure_hpa[i] = full.vapor_pressure_hpa;
+    }
+    predict_full_batch(day_utc.data(), hour_utc.data(), n, paths[8].temperature_c.data(),
+                       paths[8].specific_humidity_kg_kg.data(), paths[8].pressure_hpa.data(),
+                       derived[1].relative_humidity_percent.data(), derived[1].dew_point_c.data(),
+                       derived[1].vapor_pressure_hpa.data());
+#endif
+
+    std::FILE* out = std::fopen(argv[2], "wb");
+    if (!out) {
+        std::perror(argv[2]);
+        return 1;
+    }
+    for (const Outputs& path : paths) {
+        std::fwrite(path.temperature_c.data(), sizeof(double), n, out);
+        std::fwrite(path.specific_humidity_kg_kg.data(), sizeof(double), n, out);
+        std::fwrite(path.pressure_hpa.data(), sizeof(double), n, out);
+    }
+    for (const Derived& path : derived) {
+        std::fwrite(path.relative_humidity_percent.data(), sizeof(double), n, out);
+        std::fwrite(path.dew_point_c.data(), sizeof(double), n, out);
+        std::fwrite(path.vapor_pressure_hpa.data(), sizeof(double), n, out);
+    }
+    std::fclose(out);
+
+    std::printf("{\"paths\": ");
+    print_names(names);
+    std::printf(", \"derived\": ");
+    print_names(derived_names);
+    std::printf("}\n");
+    return 0;
+}
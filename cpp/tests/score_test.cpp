@@ -0,0 +1,121 @@
+// Checks score() of one station header on observations built as the model's
+// prediction plus a chosen residual: the band centre (in the envelope), a
+// residual past p95 or below p05 in one target at a time (its out-of-band bit
+// set, the others clear), and a NaN observation (NaN residual, no flag). The
+// expected residuals and standardized scores are those chosen residuals and
+// (r - (p05 + p95) / 2) * 2 * 1.645 / (p95 - p05), worked out here rather than
+// taken from the header. Eleven rows, so both the SIMD blocks and the
+// one-lane tail run.
+//
+// Built by CMake once per station, with HARMOCLIMAT_HEADER_TEST_STATION set to
+// the station namespace and HARMOCLIMAT_HEADER_TEST_HEADER to its header.
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+#if !defined(HARMOCLIMAT_HEADER_TEST_STATION) || !defined(HARMOCLIMAT_HEADER_TEST_HEADER)
+#error "Define HARMOCLIMAT_HEADER_TEST_STATION and HARMOCLIMAT_HEADER_TEST_HEADER"
+#endif
+#include HARMOCLIMAT_HEADER_TEST_HEADER
+
+namespace {
+
+namespace station = harmoclimat::HARMOCLIMAT_HEADER_TEST_STATION;
+
+constexpr int rows = 11;
+// Phi^-1(0.95), spelled out here so a wrong constant in the header shows up.
+constexpr double z95 = 1.6448536269514722;
+const char* const targets[3] = {"temperature", "specific_humidity", "pressure"};
+
+enum class Kind { centre, above, below, missing };
+
+// Row r: which target it moves off the centre and how (others stay centred).
+struct Case {
+    int target;
+    Kind kind;
+};
+constexpr Case cases[rows] = {
+    {0, Kind::centre}, {0, Kind::above},   {1, Kind::above},  {2, Kind::above},
+    {0, Kind::below},  {1, Kind::below},   {2, Kind::below},  {0, Kind::missing},
+    {1, Kind::missing}, {2, Kind::missing}, {0, Kind::above},
+};
+
+double chosen_residual(int t, Kind kind){
+    const harmoclimat::ErrorEnvelope& e = station::error_envelope[t];
+    const double centre = 0.5 * (e.p05 + e.p95), width = e.p95 - e.p05;
+    switch (kind) {
+        case Kind::above: return e.p95 + 0.25 * width;
+        case Kind::below: return e.p05 - 0.25 * width;
+        case Kind::missing: return NAN;
+        default: return centre;
+    }
+}
+
+}  // namespace
+
+int main(){
+    // 2021-01-01T00:00Z onwards, an odd number of seconds apart.
+    std::int64_t unix_seconds[rows];
+    for (int r = 0; r < rows; ++r) unix_seconds[r] = 1609459200 + r * 2718281;
+
+    double observed[3][rows], expected_residual[3][rows], predicted[3][rows];
+    std::uint8_t expected_flags[rows] = {};
+    for (int r = 0; r < rows; ++r) {
+        station::predict(unix_seconds[r], predicted[0][r], predicted[1][r], predicted[2][r]);
+        for (int t = 0; t < 3; ++t) {
+            const Kind kind = cases[r].target == t ? cases[r].kind : Kind::centre;
+            expected_residual[t][r] = chosen_residual(t, kind);
+            observed[t][r] = predicted[t][r] + expected_residual[t][r];
+            if (kind == Kind::above || kind == Kind::below) expected_flags[r] |= static_cast<std::uint8_t>(1u << t);
+        }
+    }
+
+    double residual[3][rows], standardized[3][rows];
+    std::uint8_t flags[rows];
+    const harmoclimat::Observations observations{observed[0], observed[1], observed[2]};
+    const harmoclimat::ScoreOutputs outputs{{residual[0], residual[1], residual[2]},
+                                            {standardized[0], standardized[1], standardized[2]}, flags};
+    station::score(observations, unix_seconds, rows, outputs);
+
+    bool ok = true;
+    for (int r = 0; r < rows; ++r) {
+        for (int t = 0; t < 3; ++t) {
+            const harmoclimat::ErrorEnvelope& e = station::error_envelope[t];
+            const double want = expected_residual[t][r];
+            const double want_score = (want - 0.5 * (e.p05 + e.p95)) * (2.0 * z95 / (e.p95 - e.p05));
+            // observed - predicted recovers the chosen residual up to the rounding of observed.
+            const double rounding = 1e-13 * (std::fabs(predicted[t][r]) + std::fabs(want));
+            const double score_rounding = rounding * 2.0 * z95 / (e.p95 - e.p05) + 1e-13 * std::fabs(want_score);
+            const bool match = std::isnan(want)
+                                   ? std::isnan(residual[t][r]) && std::isnan(standardized[t][r])
+                                   : std::fabs(residual[t][r] - want) <= rounding
+                                         && std::fabs(standardized[t][r] - want_score) <= score_rounding;
+            if (!match) {
+                std::printf("row %d %s: residual %.17g, score %.17g; expected %.17g, %.17g\n", r, targets[t],
+                            residual[t][r], standardized[t][r], want, want_score);
+                ok = false;
+            }
+        }
+        if (flags[r] != expected_flags[r]) {
+            std::printf("row %d: out_of_band 0x%x, expected 0x%x\n", r, flags[r], expected_flags[r]);
+            ok = false;
+        }
+    }
+
+    // A null observation target is skipped: its outputs are left alone and never flagged.
+    double untouched[rows];
+    for (int r = 0; r < rows; ++r) untouched[r] = -1.0;
+    const harmoclimat::Observations partial{nullptr, observed[1], observed[2]};
+    const harmoclimat::ScoreOutputs partial_outputs{{untouched, nullptr, nullptr}, {nullptr, nullptr, nullptr}, flags};
+    station::score(partial, unix_seconds, rows, partial_outputs);
+    for (int r = 0; r < rows; ++r) {
+        if (untouched[r] != -1.0 || flags[r] != (expected_flags[r] & ~1u)) {
+            std::printf("row %d: null temperature observations were scored\n", r);
+            ok = false;
+        }
+    }
+
+    std::printf("%s: score of %d rows %s\n", HARMOCLIMAT_HEADER_TEST_HEADER, rows,
+                ok ? "matches the hand-built residuals" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,101 @@
+// Checks the polynomial sin/cos of the shared header core over the range its
+// comment states: |x| <= 2^20 * pi/2, negative x and points next to multiples
+// of pi/2 included, within 2.5e-16 of the long double reference, for the
+// native SIMD width and the one-lane kernel. sinc_lanes() is checked on the
+// same range and past it, where window means of long windows land.
+//
+// The core is the same in every station header; CMake builds this test
+// against one of them, named by HARMOCLIMAT_HEADER_TEST_HEADER.
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <random>
+
+#if !defined(HARMOCLIMAT_HEADER_TEST_HEADER)
+#error "Define HARMOCLIMAT_HEADER_TEST_HEADER"
+#endif
+#include HARMOCLIMAT_HEADER_TEST_HEADER
+
+namespace {
+
+namespace simd = harmoclimat::detail::simd;
+
+constexpr double range = 1048576.0 * 1.5707963267948966;
+constexpr double tolerance = 2.5e-16;
+// sinc past the range: the reduction error, divided by |x|.
+constexpr double sinc_tolerance = 1e-15;
+constexpr int samples = 1 << 20;
+
+struct Worst {
+    double error = 0.0, at = 0.0;
+    void add(double value, long double reference, double x){
+        const double error_here = static_cast<double>(std::fabs(static_cast<long double>(value) - reference));
+        if (!(error_here <= error)) {
+            error = error_here;
+            at = x;
+        }
+    }
+};
+
+template <class V>
+void sincos(const double* x, Worst& worst){
+    alignas(64) double s[V::width], c[V::width];
+    V vs = V::set1(0.0), vc = V::set1(0.0);
+    harmoclimat::detail::sincos_lanes(V::load(x), vs, vc);
+    vs.store(s);
+    vc.store(c);
+    for (std::size_t l = 0; l < V::width; ++l) {
+        worst.add(s[l], std::sin(static_cast<long double>(x[l])), x[l]);
+        worst.add(c[l], std::cos(static_cast<long double>(x[l])), x[l]);
+    }
+}
+
+template <class V>
+void sinc(const double* x, Worst& worst){
+    alignas(64) double out[V::width];
+    harmoclimat::detail::sinc_lanes(V::load(x)).store(out);
+    for (std::size_t l = 0; l < V::width; ++l) {
+        const long double xl = x[l];
+        worst.add(out[l], xl == 0.0L ? 1.0L : std::sin(xl) / xl, x[l]);
+    }
+}
+
+bool report(const char* name, const Worst& worst, double bound){
+    const bool ok = worst.error <= bound;
+    if (!ok) std::printf("%s: error %.3g at x = %.17g exceeds %.3g\n", name, worst.error, worst.at, bound);
+    return ok;
+}
+
+}  // namespace
+
+int main(){
+    using V = simd::native;
+    std::mt19937_64 random(20240601);
+    std::uniform_real_distribution<double> uniform(-range, range);
+    std::uniform_int_distribution<long> quadrant(-1048576, 1048576);
+    Worst native, scalar, sinc_native, sinc_far;
+    alignas(64) double x[V::width];
+    for (int n = 0; n < samples; ++n) {
+        for (std::size_t l = 0; l < V::width; ++l) {
+            // Every other draw sits a few ulp off a multiple of pi/2, where the
+            // reduction cancels most.
+            const double near = static_cast<double>(quadrant(random)) * 1.5707963267948966;
+            x[l] = (n + l) % 2 ? uniform(random) : std::nextafter(near, n % 4 ? INFINITY : -INFINITY);
+        }
+        sincos<V>(x, native);
+        for (std::size_t l = 0; l < V::width; ++l) sincos<simd::f64x1>(x + l, scalar);
+        sinc<V>(x, sinc_native);
+        for (std::size_t l = 0; l < V::width; ++l) x[l] = std::ldexp(x[l], 6);
+        sinc<V>(x, sinc_far);
+    }
+    for (std::size_t l = 0; l < V::width; ++l) x[l] = l % 2 ? 1e-9 : 0.0;
+    sinc<V>(x, sinc_native);
+
+    bool ok = report("sincos_lanes (native)", native, tolerance);
+    ok = report("sincos_lanes (one lane)", scalar, tolerance) && ok;
+    ok = report("sinc_lanes", sinc_native, tolerance) && ok;
+    ok = report("sinc_lanes (past the range)", sinc_far, sinc_tolerance) && ok;
+    std::printf("%s: sincos_lanes %s (worst %.3g, sinc %.3g, far %.3g)\n", HARMOCLIMAT_HEADER_TEST_HEADER,
+                ok ? "within its stated range" : "FAILED", native.error, sinc_native.error, sinc_far.error);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,236 @@
+// Checks harmoclimat::spatial on a model pack written here: nearest() against
+// a brute-force scan, a virtual station at a station site against the station,
+// a blend against the weighted mean of the neighbours' UTC predictions (so the
+// solar-frame rotation is exact), the altitude adjustment, and an index over
+// the station registry. find() is checked on the pack and on copies with a
+// corrupt hash table.
+//
+// Usage: spatial_test <scratch directory>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "harmoclimat_stations.hpp"
+#include <harmoclimat/spatial.hpp>
+
+namespace {
+
+using namespace harmoclimat;
+
+std::uint64_t state = 11;
+double uniform(double lo, double hi){
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return lo + (hi - lo) * (static_cast<double>(state >> 11) / 9007199254740992.0);
+}
+
+std::size_t align64(std::size_t offset){ return (offset + 63) / 64 * 64; }
+
+// Pack of `count` stations over France: 2 annual and 2 diurnal harmonics at
+// most, with some stations at lower orders so their blocks are zero-padded.
+// A non-zero `fill` then overwrites every hash slot with that entry.
+bool write_pack(const std::string& path, std::size_t count, std::vector<double>& altitudes, std::uint32_t fill = 0){
+    const int annual_size = 5, diurnal_size = 5;
+    const std::uint32_t stride = (annual_size * diurnal_size + 7) / 8 * 8;
+    std::uint32_t slots = 1;
+    while (slots < 2 * count) slots *= 2;
+    pack::FileHeader header{};
+    std::memcpy(header.magic, pack::file_magic, sizeof(header.magic));
+    header.version = pack::format_version;
+    header.byte_order = pack::byte_order_mark;
+    header.station_count = static_cast<std::uint32_t>(count);
+    header.annual_basis_size = annual_size;
+    header.diurnal_basis_size = diurnal_size;
+    header.coeff_stride = stride;
+    header.hash_slots = slots;
+    header.records_offset = sizeof(pack::FileHeader);
+    header.hash_offset = align64(header.records_offset + count * sizeof(pack::StationRecord));
+    header.coeffs_offset = align64(header.hash_offset + slots * 4);
+
+    std::vector<unsigned char> bytes(header.coeffs_offset + count * pack::n_targets * stride * 8, 0);
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    auto* records = reinterpret_cast<pack::StationRecord*>(bytes.data() + header.records_offset);
+    auto* table = reinterpret_cast<std::uint32_t*>(bytes.data() + header.hash_offset);
+    auto* coeffs = reinterpret_cast<double*>(bytes.data() + header.coeffs_offset);
+    for (std::size_t s = 0; s < count; ++s) {
+        pack::StationRecord& record = records[s];
+        std::snprintf(record.code, sizeof(record.code), "%08zu", s + 1);
+        std::snprintf(record.name, sizeof(record.name), "STATION %zu", s + 1);
+        record.latitude_deg = uniform(42.5, 51.0);
+        record.longitude_deg = uniform(-4.5, 8.0);
+        record.altitude_m = uniform(0.0, 900.0);
+        record.delta_utc_solar_h = record.longitude_deg / 15.0;
+        altitudes.push_back(record.altitude_m);
+        const int diurnal_terms = s % 3 == 0 ? 3 : 5;
+        const double means[pack::n_targets] = {12.0, 0.007, 1000.0};
+        for (int t = 0; t < pack::n_targets; ++t) {
+            record.n_diurnal[t] = static_cast<std::uint32_t>((diurnal_terms - 1) / 2);
+            std::memset(record.n_annual[t], pack::absent_term, sizeof(record.n_annual[t]));
+            double* block = coeffs + (s * pack::n_targets + t) * stride;
+            for (int p = 0; p < diurnal_terms; ++p) {
+                const int order = (p + static_cast<int>(s)) % 3 == 0 ? 1 : 2;
+                record.n_annual[t][p] = static_cast<std::uint8_t>(order);
+                for (int j = 0; j < 2 * order + 1; ++j) {
+                    block[p * annual_size + j] = means[t] * (p == 0 && j == 0 ? 1.0 : uniform(-0.2, 0.2));
+                }
+            }
+        }
+        std::uint32_t slot = static_cast<std::uint32_t>(pack::detail::fnv1a_64(record.code)) & (slots - 1);
+        while (table[slot] != 0) slot = (slot + 1) & (slots - 1);
+        table[slot] = static_cast<std::uint32_t>(s + 1);
+    }
+    if (fill != 0) std::fill(table, table + slots, fill);
+    std::FILE* out = std::fopen(path.c_str(), "wb");
+    if (!out) return false;
+    const bool written = std::fwrite(bytes.data(), 1, bytes.size(), out) == bytes.size();
+    std::fclose(out);
+    return written;
+}
+
+// Copy of the pack at `from` with its header patched by `patch`; true when
+// opening the copy throws.
+template <class Patch>
+bool rejects(const std::string& from, const std::string& path, Patch patch){
+    std::ifstream in(from, std::ios::binary);
+    std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    pack::FileHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    patch(header);
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    std::ofstream(path, std::ios::binary).write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    try {
+        pack::ModelPack opened(path);
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+int main(int argc, char** argv){
+    if (argc != 2) {
+        std::fprintf(stderr, "usage: %s <scratch directory>\n", argv[0]);
+        return 2;
+    }
+    const std::string path = std::string(argv[1]) + "/spatial_test.hcpack";
+    std::vector<double> altitudes;
+    if (!write_pack(path, 300, altitudes)) return 1;
+    const pack::ModelPack models(path);
+    const spatial::StationIndex index(models);
+
+    bool ok = index.size() == models.size();
+    for (int q = 0; q < 500 && ok; ++q) {
+        const double lat = uniform(41.0, 52.5), lon = uniform(-6.0, 10.0);
+        const std::vector<spatial::Neighbour> found = index.nearest(lat, lon, 6);
+        std::vector<std::pair<double, std::size_t>> scan;
+        const spatial::detail::Point query = spatial::detail::unit_vector(lat, lon, 0);
+        for (std::size_t s = 0; s < models.size(); ++s) {
+            const pack::Station station = models.station(s);
+            const auto point = spatial::detail::unit_vector(station.latitude_deg(), station.longitude_deg(), s);
+            scan.emplace_back(spatial::detail::squared_chord(query.xyz, point.xyz), s);
+        }
+        std::partial_sort(scan.begin(), scan.begin() + 6, scan.end());
+        ok = found.size() == 6;
+        for (std::size_t n = 0; ok && n < found.size(); ++n) {
+            ok = found[n].index == scan[n].second
+              && found[n].distance_km == spatial::detail::chord_to_km(scan[n].first);
+        }
+    }
+    if (!ok) std::printf("spatial: k-d tree neighbours differ from the brute-force scan\n");
+
+    // At a station site, with its own altitude, the virtual station is the station.
+    const pack::Station seventh = models.station(7);
+    const spatial::VirtualStation same =
+        spatial::blend(models, index, seventh.latitude_deg(), seventh.longitude_deg(), seventh.altitude_m());
+    const spatial::VirtualStation raised =
+        spatial::blend(models, index, seventh.latitude_deg(), seventh.longitude_deg(), seventh.altitude_m() + 500.0);
+    const double ratio = raised.coefficients(pack::pressure)[0] / seventh.coefficients(pack::pressure)[0];
+    bool site_ok = same.neighbours().size() == 1 && same.neighbours()[0].index == 7 && ratio > 0.94 && ratio < 0.95;
+    for (int n = 0; n < 200 && site_ok; ++n) {
+        const double day = uniform(0.0, 366.0), hour = uniform(0.0, 24.0);
+        double t, q, p, vt, vq, vp, rt, rq, rp;
+        seventh.predict(day, hour, t, q, p);
+        same.predict(day, hour, vt, vq, vp);
+        raised.predict(day, hour, rt, rq, rp);
+        site_ok = vt == t && vq == q && vp == p && std::fabs(rt - (t - 3.25)) < 1e-12 && rq == q
+               && std::fabs(rp - p * ratio) < 1e-9;
+    }
+    if (!site_ok) std::printf("spatial: virtual station at a station site differs from the station\n");
+
+    // Between stations, without altitude: the weighted mean of the neighbours' predictions.
+    bool blend_ok = true;
+    for (int s = 0; s < 50 && blend_ok; ++s) {
+        spatial::BlendOptions options;
+        options.neighbours = 1 + s % 6;
+        const spatial::VirtualStation site =
+            spatial::blend(models, index, uniform(43.0, 50.0), uniform(-3.0, 7.0), NAN, options);
+        double total = 0.0;
+        for (double weight : site.weights()) total += weight;
+        blend_ok = site.neighbours().size() == options.neighbours && std::fabs(total - 1.0) < 1e-12
+                && site.n_diurnal(pack::temperature) >= 1 && site.n_annual(pack::pressure, 0) >= 1;
+        for (int n = 0; n < 50 && blend_ok; ++n) {
+            const double day = uniform(0.0, 366.0), hour = uniform(0.0, 24.0);
+            double expected[pack::n_targets] = {};
+            for (std::size_t k = 0; k < site.neighbours().size(); ++k) {
+                const pack::Station station = models.station(site.neighbours()[k].index);
+                for (int t = 0; t < pack::n_targets; ++t) {
+                    expected[t] += site.weights()[k] * station.predict(static_cast<pack::Target>(t), day, hour);
+                }
+            }
+            for (int t = 0; t < pack::n_targets; ++t) {
+                const double value = site.predict(static_cast<pack::Target>(t), day, hour);
+                blend_ok = blend_ok && std::fabs(value - expected[t]) <= 1e-11 * std::fabs(expected[t]);
+            }
+        }
+    }
+    if (!blend_ok) std::printf("spatial: blend differs from the weighted station predictions\n");
+
+    // Registry rows index the compiled stations the same way.
+    const spatial::StationIndex registry(stations);
+    const std::vector<spatial::Neighbour> nearest =
+        registry.nearest(stations[1].latitude_deg, stations[1].longitude_deg, 2);
+    const bool registry_ok = registry.size() == station_count && !nearest.empty() && nearest[0].index == 1
+                          && nearest[0].distance_km == 0.0;
+    if (!registry_ok) std::printf("spatial: registry index does not find its own stations\n");
+
+    // A full table must not probe forever and a slot past the records is refused.
+    bool find_ok = models.find("00000042") && models.find("00000042")->code() == "00000042" && !models.find("none");
+    std::vector<double> unused;
+    const std::string full_path = std::string(argv[1]) + "/spatial_test_full.hcpack";
+    const std::string past_path = std::string(argv[1]) + "/spatial_test_past.hcpack";
+    if (write_pack(full_path, 300, unused, 1) && write_pack(past_path, 300, unused, 301)) {
+        find_ok = find_ok && !pack::ModelPack(full_path).find("none") && pack::ModelPack(full_path).find("00000001");
+        try {
+            pack::ModelPack(past_path).find("00000001");
+            find_ok = false;
+        } catch (const std::runtime_error&) {
+        }
+    } else {
+        find_ok = false;
+    }
+    if (!find_ok) std::printf("spatial: find() on a corrupt hash table\n");
+
+    // Foreign byte order, misaligned sections and offsets whose sums would wrap.
+    const std::string bad_path = std::string(argv[1]) + "/spatial_test_bad.hcpack";
+    const std::uint64_t wrapping = ~std::uint64_t{0} - 255;
+    const bool header_ok =
+        rejects(path, bad_path, [](pack::FileHeader& h) { h.byte_order = 0x04030201u; })
+        && rejects(path, bad_path, [](pack::FileHeader& h) { h.records_offset += 4; })
+        && rejects(path, bad_path, [](pack::FileHeader& h) { h.hash_offset += 2; })
+        && rejects(path, bad_path, [](pack::FileHeader& h) { h.coeffs_offset += 4; })
+        && rejects(path, bad_path, [&](pack::FileHeader& h) { h.records_offset = wrapping; })
+        && rejects(path, bad_path, [&](pack::FileHeader& h) { h.coeffs_offset = wrapping; })
+        && !rejects(path, bad_path, [](pack::FileHeader&) {});
+    if (!header_ok) std::printf("spatial: a corrupt pack header was accepted\n");
+
+    ok = ok && site_ok && blend_ok && registry_ok && find_ok && header_ok;
+    std::printf("spatial: %zu stations indexed %s\n", index.size(), ok ? "match" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,74 @@
+// Checks the consteval year_grid() of one station header against predict() at
+// every grid point: cell [day * StepsPerDay + step] is the model at day_utc =
+// day, hour_utc = step * 24 / StepsPerDay. The hourly grid runs over 366 days,
+// so its last row is day 365, the trailing fraction of the solar year; a
+// small grid with seven steps a day covers hours that are not whole. The
+// grid collapses the annual series in plain doubles rather than predict()'s
+// fused kernels, so the two agree up to rounding only.
+//
+// Built by CMake once per station, with HARMOCLIMAT_HEADER_TEST_STATION set to
+// the station namespace and HARMOCLIMAT_HEADER_TEST_HEADER to its header.
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#if !defined(HARMOCLIMAT_HEADER_TEST_STATION) || !defined(HARMOCLIMAT_HEADER_TEST_HEADER)
+#error "Define HARMOCLIMAT_HEADER_TEST_STATION and HARMOCLIMAT_HEADER_TEST_HEADER"
+#endif
+#include HARMOCLIMAT_HEADER_TEST_HEADER
+
+#if !defined(__cpp_consteval)
+#error "year_grid() needs consteval"
+#endif
+
+namespace {
+
+namespace station = harmoclimat::HARMOCLIMAT_HEADER_TEST_STATION;
+
+// Relative to the largest |value| of each target.
+constexpr double tolerance = 1e-12;
+const char* const targets[3] = {"temperature", "specific_humidity", "pressure"};
+
+template <int Days, int Steps>
+bool compare(const harmoclimat::YearGrid<Days, Steps>& grid){
+    const double* cells[3] = {grid.temperature_c.data(), grid.specific_humidity_kg_kg.data(), grid.pressure_hpa.data()};
+    double scale[3] = {0.0, 0.0, 0.0}, worst[3] = {0.0, 0.0, 0.0};
+    int worst_index[3] = {0, 0, 0};
+    for (int day = 0; day < Days; ++day) {
+        for (int step = 0; step < Steps; ++step) {
+            double values[3];
+            station::predict(day, step * (24.0 / Steps), values[0], values[1], values[2]);
+            const int index = day * Steps + step;
+            for (int t = 0; t < 3; ++t) {
+                scale[t] = std::max(scale[t], std::fabs(values[t]));
+                const double error = std::fabs(cells[t][index] - values[t]);
+                if (!(error <= worst[t])) {
+                    worst[t] = error;
+                    worst_index[t] = index;
+                }
+            }
+        }
+    }
+    bool ok = true;
+    for (int t = 0; t < 3; ++t) {
+        if (!(worst[t] <= tolerance * scale[t])) {
+            std::printf("year_grid<%d, %d> %s: day %d step %d off by %.3g (scale %.3g)\n", Days, Steps, targets[t],
+                        worst_index[t] / Steps, worst_index[t] % Steps, worst[t], scale[t]);
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+}  // namespace
+
+int main(){
+    static constexpr auto hourly = station::year_grid<366, 24>();
+    static constexpr auto uneven = station::year_grid<3, 7>();
+    static_assert(hourly.size == 366 * 24 && uneven.size == 21);
+
+    bool ok = compare(hourly);
+    ok = compare(uneven) && ok;
+    std::printf("%s: year_grid %s\n", HARMOCLIMAT_HEADER_TEST_HEADER, ok ? "matches predict()" : "FAILED");
+    return ok ? 0 : 1;
+}
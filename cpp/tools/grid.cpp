@@ -0,0 +1,124 @@
+// Writes T/Q/P (and RH) tables for a set of stations over a regular UTC range.
+//
+// Build with generated/templates and cpp/include on the include path (CMake
+// target harmoclimate_grid). Usage:
+//   harmoclimat_grid --start 2024-01-01 --end 2025-01-01 [--step 3600]
+//                    [--stations 18033001,78621001] [--rh] [--threads N]
+//                    [--format csv|binary] [--output PATH]
+// Times are Unix seconds or YYYY-MM-DD[THH:MM[:SS]][Z] in UTC; --end is
+// exclusive. CSV goes to stdout without --output. Timing goes to stderr.
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "harmoclimat_stations.hpp"
+#include <harmoclimat/civil.hpp>
+#include <harmoclimat/grid.hpp>
+
+namespace {
+
+std::int64_t parse_time(const std::string& text){
+    int y = 0, mo = 0, d = 0, h = 0, mi = 0, s = 0;
+    char tail = 0;
+    if (text.find('-', 1) == std::string::npos) return std::stoll(text);
+    const int fields = std::sscanf(text.c_str(), "%d-%d-%d%*[T ]%d:%d:%d%c", &y, &mo, &d, &h, &mi, &s, &tail);
+    if (fields < 3 || mo < 1 || mo > 12 || d < 1 || d > 31 || (fields == 7 && tail != 'Z')) {
+        throw std::invalid_argument("bad time '" + text + "'");
+    }
+    return harmoclimat::days_from_civil(y, static_cast<unsigned>(mo), static_cast<unsigned>(d)) * 86400 + h * 3600
+         + mi * 60 + s;
+}
+
+std::vector<const harmoclimat::StationEntry*> select_stations(const std::string& list){
+    std::vector<const harmoclimat::StationEntry*> selected;
+    if (list.empty() || list == "all") {
+        for (const harmoclimat::StationEntry& entry : harmoclimat::stations) selected.push_back(&entry);
+        return selected;
+    }
+    std::size_t start = 0;
+    while (start <= list.size()) {
+        const std::size_t comma = std::min(list.find(',', start), list.size());
+        const std::string_view code(list.data() + start, comma - start);
+        const harmoclimat::StationEntry* entry = harmoclimat::find_station(code);
+        if (!entry) throw std::invalid_argument("unknown station code '" + std::string(code) + "'");
+        selected.push_back(entry);
+        start = comma + 1;
+    }
+    return selected;
+}
+
+int usage(const char* program){
+    std::fprintf(stderr,
+                 "usage: %s --start TIME --end TIME [--step SECONDS] [--stations CODE,...|all] [--rh]\n"
+                 "       [--threads N] [--format csv|binary] [--output PATH]\n",
+                 program);
+    return 2;
+}
+
+}  // namespace
+
+int main(int argc, char** argv){
+    std::string start, end, stations_arg, format = "csv", output;
+    std::int64_t step = 3600;
+    bool relative_humidity = false;
+    harmoclimat::grid::Options options;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            const auto value = [&]() -> std::string {
+                if (i + 1 >= argc) throw std::invalid_argument(arg + " needs a value");
+                return argv[++i];
+            };
+            if (arg == "--start") start = value();
+            else if (arg == "--end") end = value();
+            else if (arg == "--step") step = std::stoll(value());
+            else if (arg == "--stations") stations_arg = value();
+            else if (arg == "--threads") options.threads = static_cast<unsigned>(std::stoul(value()));
+            else if (arg == "--format") format = value();
+            else if (arg == "--output") output = value();
+            else if (arg == "--rh") relative_humidity = true;
+            else return usage(argv[0]);
+        }
+        if (start.empty() || end.empty() || step <= 0 || (format != "csv" && format != "binary")) return usage(argv[0]);
+        if (format == "binary" && output.empty()) throw std::invalid_argument("--format binary needs --output");
+        if (relative_humidity && !harmoclimat::grid::has_relative_humidity) {
+            throw std::invalid_argument("--rh needs harmoclimat_psychrometrics.hpp next to the station headers");
+        }
+
+        const std::int64_t first = parse_time(start), last = parse_time(end);
+        if (last <= first) throw std::invalid_argument("--end must be after --start");
+        const harmoclimat::grid::TimeRange range{first, step, static_cast<std::size_t>((last - first + step - 1) / step)};
+        const std::vector<const harmoclimat::StationEntry*> selected = select_stations(stations_arg);
+        std::vector<harmoclimat::grid::PredictBatchUnix> kernels;
+        std::vector<std::string_view> codes;
+        for (const harmoclimat::StationEntry* entry : selected) {
+            kernels.push_back(entry->predict_batch_unix);
+            codes.push_back(entry->code);
+        }
+
+        using clock = std::chrono::steady_clock;
+        const auto t0 = clock::now();
+        harmoclimat::grid::Table table =
+            harmoclimat::grid::generate(kernels.data(), kernels.size(), range, relative_humidity, options);
+        const auto t1 = clock::now();
+        const std::string path = output.empty() ? "/dev/stdout" : output;
+        if (format == "binary") harmoclimat::grid::write_binary(path, codes.data(), codes.size(), range, table.columns());
+        else harmoclimat::grid::write_csv(path, codes.data(), codes.size(), range, table.columns(), options);
+        const auto t2 = clock::now();
+
+        const double points = static_cast<double>(codes.size() * range.steps);
+        const double compute_s = std::chrono::duration<double>(t1 - t0).count();
+        std::fprintf(stderr, "%zu stations x %zu steps: generated in %.3f s (%.1f M points/s), written in %.3f s\n",
+                     codes.size(), range.steps, compute_s, points / compute_s / 1e6,
+                     std::chrono::duration<double>(t2 - t1).count());
+    } catch (const std::exception& error) {
+        std::fprintf(stderr, "harmoclimat_grid: %s\n", error.what());
+        return 1;
+    }
+    return 0;
+}
@@ -3,34 +3,558 @@
 // Station code : 59343001
 #pragma once
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#if __cplusplus >= 202002L
+#include <chrono>
+#endif
+#if __cplusplus >= 202002L && defined(__has_include)
+#if __has_include(<span>)
+#include <span>
+#endif
+#endif
+#include <iterator>
+#if defined(__cpp_consteval)
+#include <array>
+#endif
+#if !defined(HARMOCLIMAT_DISABLE_SIMD)
+#if defined(__AVX512F__) || (defined(__AVX2__) && defined(__FMA__))
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+#endif
+// Optional companion emitted next to the station headers; enables predict_full().
+#if defined(__has_include) && !defined(HARMOCLIMAT_DISABLE_PSYCHROMETRICS)
+#if __has_include("harmoclimat_psychrometrics.hpp")
+#include "harmoclimat_psychrometrics.hpp"
+#endif
+#endif
 namespace harmoclimat {
-static constexpr double longitude_deg = 3.0975000858306885;
-static constexpr double latitude_deg = 50.569999694824219;
-static constexpr double delta_utc_solar_h = 0.20650000572204597;
+// Station-independent helpers, shared by every station header in a translation unit.
+#if !defined(HARMOCLIMAT_DETAIL_CORE)
+#define HARMOCLIMAT_DETAIL_CORE
+struct Prediction {
+    double temperature_c;
+    double specific_humidity_kg_kg;
+    double pressure_hpa;
+};
+// Training residuals (observed - model) of one target.
+struct ErrorEnvelope {
+    double mae;
+    double bias;
+    double p05;
+    double p95;
+};
+// Structure-of-arrays observations for score(); a null target is skipped.
+struct Observations {
+    const double* temperature_c;
+    const double* specific_humidity_kg_kg;
+    const double* pressure_hpa;
+};
+// Outputs of score(), indexed by target (T, Q, P); null pointers are not written.
+// Bit t of out_of_band is set when residual t lies outside [p05, p95].
+struct ScoreOutputs {
+    double* residual[3];
+    double* standardized[3];
+    std::uint8_t* out_of_band;
+};
+// Solar day in [0, solar_year_days] and solar hour in [0, 24], as used by the fit.
+struct SolarTime {
+    double day;
+    double hour;
+};
+// One target over one solar day; hours are UTC, like predict() arguments.
+struct DailyExtremes {
+    double mean;
+    double min;
+    double max;
+    double hour_of_min_utc;
+    double hour_of_max_utc;
+};
+struct DailyStats {
+    DailyExtremes temperature_c;
+    DailyExtremes specific_humidity_kg_kg;
+    DailyExtremes pressure_hpa;
+};
+#if defined(__cpp_consteval)
+// Days x StepsPerDay table; entry [day * StepsPerDay + step] is the prediction
+// for day_utc = day and hour_utc = step * 24 / StepsPerDay.
+template <int Days, int StepsPerDay>
+struct YearGrid {
+    static constexpr int days = Days;
+    static constexpr int steps_per_day = StepsPerDay;
+    static constexpr std::size_t size = static_cast<std::size_t>(Days) * StepsPerDay;
+    std::array<double, size> temperature_c;
+    std::array<double, size> specific_humidity_kg_kg;
+    std::array<double, size> pressure_hpa;
+};
+#endif
 namespace detail {
 static constexpr double two_pi = 6.2831853071795864769;
 static constexpr double solar_year_days = 365.242189;
 static constexpr double omega_annual = two_pi / solar_year_days;
 static constexpr double omega_diurnal = two_pi / 24.0;
-inline double eval_annual(const double* coeffs, int n_annual, double day){
+// Harmonic basis [1, cos x, sin x, ..., cos Nx, sin Nx] from a single sincos by
+// angle addition. For N <= 3 and angle in [0, 2*pi) each entry stays within 4e-15
+// (18 ulp of 1.0) of direct std::cos/std::sin(k*angle), whose own k*angle
+// rounding dominates.
+template <int N>
+inline void harmonic_basis(double angle, double (&basis)[2 * N + 1]){
+    basis[0] = 1.0;
+    for(int k = 1; k <= N; ++k){
+        if (k == 1) {
+            basis[1] = std::cos(angle);
+            basis[2] = std::sin(angle);
+            continue;
+        }
+        basis[2*k - 1] = basis[2*k - 3] * basis[1] - basis[2*k - 2] * basis[2];
+        basis[2*k] = basis[2*k - 2] * basis[1] + basis[2*k - 3] * basis[2];
+    }
+}
+inline double eval_annual(const double* coeffs, int n_annual, const double* annual){
     double value = coeffs[0];
-    for(int k = 1; k <= n_annual; ++k){
-        double angle = k * omega_annual * day;
-        value += coeffs[2*k - 1] * std::cos(angle);
-        value += coeffs[2*k] * std::sin(angle);
+    for(int j = 1; j <= 2 * n_annual; ++j){
+        value += coeffs[j] * annual[j];
     }
     return value;
 }
+// numpy's float modulo: std::fmod is exact, so this is constant time and loses
+// nothing however far x is from zero; only the final + period rounds.
+inline double mod_positive(double x, double period){
+    const double r = std::fmod(x, period);
+    return r < 0.0 ? r + period : r;
+}
 inline double wrap_day(double d){
-    while (d >= solar_year_days) d -= solar_year_days;
-    while (d < 0.0)   d += solar_year_days;
-    return d;
+    d = mod_positive(d, solar_year_days);
+    return d >= solar_year_days ? 0.0 : d;  // rounding up to the period; NaN passes through
 }
 inline double wrap_hour(double h){
-    while (h >= 24.0) h -= 24.0;
-    while (h < 0.0)   h += 24.0;
-    return h;
+    h = mod_positive(h, 24.0);
+    return h >= 24.0 ? 0.0 : h;
+}
+// mod_positive for x in [-period, 2 * period): fmod reduces to one subtraction,
+// exact by Sterbenz, so the result is bit-identical without the fmod.
+inline double mod_positive_near(double x, double period){
+    const double r = x >= period ? x - period : x;
+    return r < 0.0 ? r + period : r;
+}
+// mod_positive(day, solar_year_days) for an integer day. The remainder is a
+// multiple of ulp(solar_year_days) = 2^-44 below 2^9, so one fused multiply-add
+// forms it exactly and matches std::fmod bit for bit; without hardware FMA
+// std::fma is a library call, so fmod stays.
+inline double mod_year_day(std::int64_t day){
+    const double d = static_cast<double>(day);
+#if defined(FP_FAST_FMA) || defined(__FP_FAST_FMA)
+    double k = std::floor(d / solar_year_days);
+    double r = std::fma(-k, solar_year_days, d);
+    if (r < 0.0 || r >= solar_year_days) {
+        k += r < 0.0 ? -1.0 : 1.0;
+        r = std::fma(-k, solar_year_days, d);
+    }
+    return r;
+#else
+    return mod_positive(d, solar_year_days);
+#endif
+}
+static constexpr std::int64_t seconds_per_day = 86400;
+static constexpr std::int64_t solar_epoch_unix_day = 10957; // 2000-01-01T00:00:00Z
+// harmoclimate.core.compute_solar_time for one Unix timestamp, operation for
+// operation (before its float32 storage cast): the floored UTC day since the epoch
+// modulo the tropical year, shifted by longitude / 360 of a year, and the UTC
+// hour from whole hours, minutes and seconds shifted by longitude / 15.
+inline SolarTime solar_time_from_unix(std::int64_t unix_seconds, double longitude_deg){
+    std::int64_t day = unix_seconds / seconds_per_day;
+    std::int64_t second = unix_seconds % seconds_per_day;
+    if (second < 0) {
+        second += seconds_per_day;
+        --day;
+    }
+    const double year_day = mod_year_day(day - solar_epoch_unix_day);
+    const double hour_utc = static_cast<double>(second / 3600) + static_cast<double>(second % 3600 / 60) / 60.0
+                          + static_cast<double>(second % 60) / 3600.0;
+    return {mod_positive_near(year_day + (longitude_deg / 360.0) * solar_year_days, solar_year_days),
+            mod_positive_near(hour_utc + longitude_deg / 15.0, 24.0)};
+}
+// Diurnal series c[0] + sum_m c[2m-1] cos(m x) + c[2m] sin(m x) and its first
+// two derivatives in x.
+template <int N>
+inline void diurnal_series(const double (&c)[2 * N + 1], double x, double& f, double& d1, double& d2){
+    double basis[2 * N + 1];
+    harmonic_basis<N>(x, basis);
+    f = c[0];
+    d1 = 0.0;
+    d2 = 0.0;
+    for(int m = 1; m <= N; ++m){
+        const double even = c[2*m - 1] * basis[2*m - 1] + c[2*m] * basis[2*m];
+        const double odd = c[2*m] * basis[2*m - 1] - c[2*m - 1] * basis[2*m];
+        f += even;
+        d1 += m * odd;
+        d2 -= m * m * even;
+    }
+}
+// Critical points of a diurnal series, isolated on [0, 2*pi) with Lipschitz
+// bounds on f'' and f''' instead of a sampling grid.
+template <int N>
+struct ExtremaSearch {
+    const double (&c)[2 * N + 1];
+    double bound_d2;
+    double bound_d3;
+    DailyExtremes out;
+
+    void consider(double x){
+        double f, d1, d2;
+        diurnal_series<N>(c, x, f, d1, d2);
+        if (f < out.min) { out.min = f; out.hour_of_min_utc = x; }
+        if (f > out.max) { out.max = f; out.hour_of_max_utc = x; }
+    }
+    // Safeguarded Newton on f' inside a bracket where f' is monotonic.
+    void refine(double lo, double hi, double d1_lo){
+        double x = 0.5 * (lo + hi);
+        for(int it = 0; it < 100 && hi - lo > 1e-15; ++it){
+            double f, d1, d2;
+            diurnal_series<N>(c, x, f, d1, d2);
+            if (d1 == 0.0) break;
+            if ((d1 < 0.0) == (d1_lo < 0.0)) lo = x; else hi = x;
+            const double next = d2 != 0.0 ? x - d1 / d2 : lo;
+            x = (next > lo && next < hi) ? next : 0.5 * (lo + hi);
+        }
+        consider(x);
+    }
+    // The interval holds no root of f' when |f'| cannot reach zero across it, and
+    // at most one when f' is monotonic; anything else is bisected.
+    void search(double lo, double hi, double d1_lo, double d2_lo, double d1_hi, double d2_hi, int depth){
+        const double width = hi - lo;
+        if (std::fabs(d1_lo) + std::fabs(d1_hi) > bound_d2 * width) return;
+        if (std::fabs(d2_lo) + std::fabs(d2_hi) > bound_d3 * width) {
+            if ((d1_lo < 0.0) != (d1_hi < 0.0) || d1_lo == 0.0 || d1_hi == 0.0) refine(lo, hi, d1_lo);
+            return;
+        }
+        const double mid = 0.5 * (lo + hi);
+        if (depth >= 48) {
+            consider(mid);
+            return;
+        }
+        double f, d1_mid, d2_mid;
+        diurnal_series<N>(c, mid, f, d1_mid, d2_mid);
+        search(lo, mid, d1_lo, d2_lo, d1_mid, d2_mid, depth + 1);
+        search(mid, hi, d1_mid, d2_mid, d1_hi, d2_hi, depth + 1);
+    }
+};
+// Daily mean (the constant term, exact over a full period) and extrema of a
+// diurnal series, with the hours of the extrema converted back to UTC.
+template <int N>
+inline DailyExtremes diurnal_extremes(const double (&c)[2 * N + 1], double delta_utc_solar_h){
+    double f0, d1_lo, d2_lo;
+    diurnal_series<N>(c, 0.0, f0, d1_lo, d2_lo);
+    ExtremaSearch<N> search{c, 0.0, 0.0, {c[0], f0, f0, 0.0, 0.0}};
+    for(int m = 1; m <= N; ++m){
+        const double amplitude = std::sqrt(c[2*m - 1] * c[2*m - 1] + c[2*m] * c[2*m]);
+        search.bound_d2 += m * m * amplitude;
+        search.bound_d3 += m * m * m * amplitude;
+    }
+    if (search.bound_d2 > 0.0) {
+        const int pieces = 8 * N;
+        for(int i = 0; i < pieces; ++i){
+            const double lo = two_pi * i / pieces;
+            const double hi = two_pi * (i + 1) / pieces;
+            double f, d1_hi, d2_hi;
+            diurnal_series<N>(c, hi, f, d1_hi, d2_hi);
+            search.search(lo, hi, d1_lo, d2_lo, d1_hi, d2_hi, 0);
+            d1_lo = d1_hi;
+            d2_lo = d2_hi;
+        }
+    }
+    search.out.hour_of_min_utc = wrap_hour(search.out.hour_of_min_utc / omega_diurnal - delta_utc_solar_h);
+    search.out.hour_of_max_utc = wrap_hour(search.out.hour_of_max_utc / omega_diurnal - delta_utc_solar_h);
+    return search.out;
+}
+namespace simd {
+struct f64x1 {
+    static constexpr std::size_t width = 1;
+    using mask = bool;
+    double v;
+    static constexpr f64x1 load(const double* p){ return {*p}; }
+    static constexpr f64x1 set1(double x){ return {x}; }
+    constexpr void store(double* p) const { *p = v; }
+    static constexpr f64x1 select(mask m, f64x1 a, f64x1 b){ return m ? a : b; }
+    friend constexpr f64x1 operator+(f64x1 a, f64x1 b){ return {a.v + b.v}; }
+    friend constexpr f64x1 operator-(f64x1 a, f64x1 b){ return {a.v - b.v}; }
+    friend constexpr f64x1 operator*(f64x1 a, f64x1 b){ return {a.v * b.v}; }
+    friend constexpr f64x1 operator/(f64x1 a, f64x1 b){ return {a.v / b.v}; }
+    friend constexpr f64x1 fmadd(f64x1 a, f64x1 b, f64x1 c){ return {a.v * b.v + c.v}; }
+    friend f64x1 ldexp(f64x1 x, f64x1 n){ return {std::ldexp(x.v, static_cast<int>(n.v))}; }
+    friend f64x1 split_exponent(f64x1 x, f64x1& e){
+        int k = 0;
+        const double m = std::frexp(x.v, &k);
+        e = {static_cast<double>(k - 1)};
+        return {2.0 * m};
+    }
+    friend constexpr f64x1 floor(f64x1 a){
+        // Constant-expression floor; beyond 2^52 every double is already integral.
+        if (!(a.v > -4503599627370496.0 && a.v < 4503599627370496.0)) return a;
+        const double t = static_cast<double>(static_cast<long long>(a.v));
+        return {t > a.v ? t - 1.0 : t};
+    }
+    friend constexpr mask ge(f64x1 a, f64x1 b){ return a.v >= b.v; }
+    friend constexpr mask lt(f64x1 a, f64x1 b){ return a.v < b.v; }
+    friend constexpr mask eq(f64x1 a, f64x1 b){ return a.v == b.v; }
+    friend constexpr double reduce_add(f64x1 a){ return a.v; }
+};
+#if defined(__AVX512F__) && !defined(HARMOCLIMAT_DISABLE_SIMD)
+struct f64x8 {
+    static constexpr std::size_t width = 8;
+    using mask = __mmask8;
+    __m512d v;
+    static f64x8 load(const double* p){ return {_mm512_loadu_pd(p)}; }
+    static f64x8 set1(double x){ return {_mm512_set1_pd(x)}; }
+    void store(double* p) const { _mm512_storeu_pd(p, v); }
+    static f64x8 select(mask m, f64x8 a, f64x8 b){ return {_mm512_mask_blend_pd(m, b.v, a.v)}; }
+    friend f64x8 operator+(f64x8 a, f64x8 b){ return {_mm512_add_pd(a.v, b.v)}; }
+    friend f64x8 operator-(f64x8 a, f64x8 b){ return {_mm512_sub_pd(a.v, b.v)}; }
+    friend f64x8 operator*(f64x8 a, f64x8 b){ return {_mm512_mul_pd(a.v, b.v)}; }
+    friend f64x8 operator/(f64x8 a, f64x8 b){ return {_mm512_div_pd(a.v, b.v)}; }
+    friend f64x8 fmadd(f64x8 a, f64x8 b, f64x8 c){ return {_mm512_fmadd_pd(a.v, b.v, c.v)}; }
+    // Full-mask forms: the unmasked intrinsics trip -Wuninitialized on GCC 12.
+    friend f64x8 ldexp(f64x8 x, f64x8 n){ return {_mm512_mask_scalef_pd(x.v, 0xFF, x.v, n.v)}; }
+    friend f64x8 split_exponent(f64x8 x, f64x8& e){
+        e = {_mm512_mask_getexp_pd(x.v, 0xFF, x.v)};
+        return {_mm512_mask_getmant_pd(x.v, 0xFF, x.v, _MM_MANT_NORM_1_2, _MM_MANT_SIGN_src)};
+    }
+    friend f64x8 floor(f64x8 a){ return {_mm512_mask_roundscale_pd(a.v, 0xFF, a.v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC)}; }
+    friend mask ge(f64x8 a, f64x8 b){ return _mm512_cmp_pd_mask(a.v, b.v, _CMP_GE_OQ); }
+    friend mask lt(f64x8 a, f64x8 b){ return _mm512_cmp_pd_mask(a.v, b.v, _CMP_LT_OQ); }
+    friend mask eq(f64x8 a, f64x8 b){ return _mm512_cmp_pd_mask(a.v, b.v, _CMP_EQ_OQ); }
+    friend double reduce_add(f64x8 a){
+        const __m256d half = _mm256_add_pd(_mm512_maskz_extractf64x4_pd(0xFF, a.v, 0), _mm512_maskz_extractf64x4_pd(0xFF, a.v, 1));
+        const __m128d pair = _mm_add_pd(_mm256_castpd256_pd128(half), _mm256_extractf128_pd(half, 1));
+        return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+    }
+};
+using native = f64x8;
+#elif defined(__AVX2__) && defined(__FMA__) && !defined(HARMOCLIMAT_DISABLE_SIMD)
+struct f64x4 {
+    static constexpr std::size_t width = 4;
+    using mask = __m256d;
+    __m256d v;
+    static f64x4 load(const double* p){ return {_mm256_loadu_pd(p)}; }
+    static f64x4 set1(double x){ return {_mm256_set1_pd(x)}; }
+    void store(double* p) const { _mm256_storeu_pd(p, v); }
+    static f64x4 select(mask m, f64x4 a, f64x4 b){ return {_mm256_blendv_pd(b.v, a.v, m)}; }
+    friend f64x4 operator+(f64x4 a, f64x4 b){ return {_mm256_add_pd(a.v, b.v)}; }
+    friend f64x4 operator-(f64x4 a, f64x4 b){ return {_mm256_sub_pd(a.v, b.v)}; }
+    friend f64x4 operator*(f64x4 a, f64x4 b){ return {_mm256_mul_pd(a.v, b.v)}; }
+    friend f64x4 operator/(f64x4 a, f64x4 b){ return {_mm256_div_pd(a.v, b.v)}; }
+    friend f64x4 fmadd(f64x4 a, f64x4 b, f64x4 c){ return {_mm256_fmadd_pd(a.v, b.v, c.v)}; }
+    friend f64x4 ldexp(f64x4 x, f64x4 n){
+        // n + 1.5 * 2^52 holds n in its low mantissa bits; shifted into the
+        // exponent field and added to x, they scale x by 2^n.
+        const __m256i scale = _mm256_slli_epi64(_mm256_castpd_si256(_mm256_add_pd(n.v, _mm256_set1_pd(6755399441055744.0))), 52);
+        return {_mm256_castsi256_pd(_mm256_add_epi64(_mm256_castpd_si256(x.v), scale))};
+    }
+    friend f64x4 split_exponent(f64x4 x, f64x4& e){
+        const __m256i bits = _mm256_castpd_si256(x.v);
+        const __m256d two_52 = _mm256_set1_pd(4503599627370496.0);
+        const __m256i biased = _mm256_or_si256(_mm256_srli_epi64(bits, 52), _mm256_castpd_si256(two_52));
+        e = {_mm256_sub_pd(_mm256_castsi256_pd(biased), _mm256_add_pd(two_52, _mm256_set1_pd(1023.0)))};
+        const __m256i mantissa = _mm256_and_si256(bits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFFLL));
+        return {_mm256_castsi256_pd(_mm256_or_si256(mantissa, _mm256_set1_epi64x(0x3FF0000000000000LL)))};
+    }
+    friend f64x4 floor(f64x4 a){ return {_mm256_floor_pd(a.v)}; }
+    friend mask ge(f64x4 a, f64x4 b){ return _mm256_cmp_pd(a.v, b.v, _CMP_GE_OQ); }
+    friend mask lt(f64x4 a, f64x4 b){ return _mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ); }
+    friend mask eq(f64x4 a, f64x4 b){ return _mm256_cmp_pd(a.v, b.v, _CMP_EQ_OQ); }
+    friend double reduce_add(f64x4 a){
+        const __m128d pair = _mm_add_pd(_mm256_castpd256_pd128(a.v), _mm256_extractf128_pd(a.v, 1));
+        return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+    }
+};
+using native = f64x4;
+#elif defined(__ARM_NEON) && defined(__aarch64__) && !defined(HARMOCLIMAT_DISABLE_SIMD)
+struct f64x2 {
+    static constexpr std::size_t width = 2;
+    using mask = uint64x2_t;
+    float64x2_t v;
+    static f64x2 load(const double* p){ return {vld1q_f64(p)}; }
+    static f64x2 set1(double x){ return {vdupq_n_f64(x)}; }
+    void store(double* p) const { vst1q_f64(p, v); }
+    static f64x2 select(mask m, f64x2 a, f64x2 b){ return {vbslq_f64(m, a.v, b.v)}; }
+    friend f64x2 operator+(f64x2 a, f64x2 b){ return {vaddq_f64(a.v, b.v)}; }
+    friend f64x2 operator-(f64x2 a, f64x2 b){ return {vsubq_f64(a.v, b.v)}; }
+    friend f64x2 operator*(f64x2 a, f64x2 b){ return {vmulq_f64(a.v, b.v)}; }
+    friend f64x2 operator/(f64x2 a, f64x2 b){ return {vdivq_f64(a.v, b.v)}; }
+    friend f64x2 fmadd(f64x2 a, f64x2 b, f64x2 c){ return {vfmaq_f64(c.v, a.v, b.v)}; }
+    friend f64x2 ldexp(f64x2 x, f64x2 n){
+        const int64x2_t scale = vshlq_n_s64(vcvtq_s64_f64(n.v), 52);
+        return {vreinterpretq_f64_s64(vaddq_s64(vreinterpretq_s64_f64(x.v), scale))};
+    }
+    friend f64x2 split_exponent(f64x2 x, f64x2& e){
+        const uint64x2_t bits = vreinterpretq_u64_f64(x.v);
+        e = {vsubq_f64(vcvtq_f64_u64(vshrq_n_u64(bits, 52)), vdupq_n_f64(1023.0))};
+        const uint64x2_t mantissa = vandq_u64(bits, vdupq_n_u64(0x000FFFFFFFFFFFFFULL));
+        return {vreinterpretq_f64_u64(vorrq_u64(mantissa, vdupq_n_u64(0x3FF0000000000000ULL)))};
+    }
+    friend f64x2 floor(f64x2 a){ return {vrndmq_f64(a.v)}; }
+    friend mask ge(f64x2 a, f64x2 b){ return vcgeq_f64(a.v, b.v); }
+    friend mask lt(f64x2 a, f64x2 b){ return vcltq_f64(a.v, b.v); }
+    friend mask eq(f64x2 a, f64x2 b){ return vceqq_f64(a.v, b.v); }
+    friend double reduce_add(f64x2 a){ return vaddvq_f64(a.v); }
+};
+using native = f64x2;
+#else
+using native = f64x1;
+#endif
+} // namespace simd
+// Polynomial sin/cos: Cody-Waite reduction by pi/2 to [-pi/4, pi/4] followed
+// by the fdlibm kernel polynomials. The 33-bit head of pi/2 times the quadrant
+// count stays exact for |x| <= 2^20 * pi/2 (about 1.6e6), negative x included,
+// and there the error is below 2.5e-16. The basis callers pass angles wrapped
+// to [0, 2*pi); past the bound the error grows with |x|.
+template <class V>
+constexpr void sincos_lanes(V x, V& s, V& c){
+    const V one = V::set1(1.0);
+    const V two = V::set1(2.0);
+    const V q = floor(fmadd(x, V::set1(0.63661977236758134308), V::set1(0.5)));
+    V r = fmadd(q, V::set1(-1.57079632673412561417e+00), x);
+    r = fmadd(q, V::set1(-6.07710050650619224932e-11), r);
+    const V z = r * r;
+    V ps = fmadd(z, V::set1(1.58969099521155010221e-10), V::set1(-2.50507602534068634195e-08));
+    ps = fmadd(z, ps, V::set1(2.75573137070700676789e-06));
+    ps = fmadd(z, ps, V::set1(-1.98412698298579493134e-04));
+    ps = fmadd(z, ps, V::set1(8.33333333332248946124e-03));
+    ps = fmadd(z, ps, V::set1(-1.66666666666666324348e-01));
+    const V sr = fmadd(r * z, ps, r);
+    V pc = fmadd(z, V::set1(-1.13596475577881948265e-11), V::set1(2.08757232129817482790e-09));
+    pc = fmadd(z, pc, V::set1(-2.75573143513906633035e-07));
+    pc = fmadd(z, pc, V::set1(2.48015872894767294178e-05));
+    pc = fmadd(z, pc, V::set1(-1.38888888888741095749e-03));
+    pc = fmadd(z, pc, V::set1(4.16666666666666019037e-02));
+    const V cr = fmadd(z * z, pc, fmadd(z, V::set1(-0.5), one));
+    const V quadrant = fmadd(floor(q * V::set1(0.25)), V::set1(-4.0), q);
+    const V half = V::select(ge(quadrant, two), quadrant - two, quadrant);
+    const auto odd = eq(half, one);
+    const V sin_sign = V::select(ge(quadrant, two), V::set1(-1.0), one);
+    V cos_quadrant = quadrant + one;
+    cos_quadrant = V::select(ge(cos_quadrant, V::set1(4.0)), cos_quadrant - V::set1(4.0), cos_quadrant);
+    const V cos_sign = V::select(ge(cos_quadrant, two), V::set1(-1.0), one);
+    s = V::select(odd, cr, sr) * sin_sign;
+    c = V::select(odd, sr, cr) * cos_sign;
+}
+// [1, cos x, sin x, ..., cos Nx, sin Nx] from cos x and sin x by angle addition.
+template <class V, int N>
+constexpr void harmonic_series_lanes(V c, V s, V (&basis)[2 * N + 1]){
+    basis[0] = V::set1(1.0);
+    for(int k = 1; k <= N; ++k){
+        if (k == 1) {
+            basis[1] = c;
+            basis[2] = s;
+            continue;
+        }
+        basis[2*k - 1] = fmadd(basis[2*k - 3], basis[1], V::set1(0.0) - basis[2*k - 2] * basis[2]);
+        basis[2*k] = fmadd(basis[2*k - 2], basis[1], basis[2*k - 3] * basis[2]);
+    }
+}
+// Lane version of harmonic_basis(): [1, cos x, sin x, ..., cos Nx, sin Nx].
+template <class V, int N>
+constexpr void harmonic_basis_lanes(V angle, V (&basis)[2 * N + 1]){
+    V s = V::set1(0.0), c = V::set1(0.0);
+    sincos_lanes(angle, s, c);
+    harmonic_series_lanes<V, N>(c, s, basis);
+}
+// Phasor (c, s) = (cos x, sin x) advanced to x + d, given cos d and sin d.
+template <class V>
+constexpr void rotate_lanes(V& c, V& s, V cos_d, V sin_d){
+    const V next_c = fmadd(c, cos_d, V::set1(0.0) - s * sin_d);
+    s = fmadd(s, cos_d, c * sin_d);
+    c = next_c;
+}
+// One Newton step of 1/sqrt(c^2 + s^2) around 1: pulls the phasor back to unit
+// length, squaring the relative drift, without a division or a square root.
+template <class V>
+constexpr void renormalize_lanes(V& c, V& s){
+    const V scale = fmadd(fmadd(c, c, s * s), V::set1(-0.5), V::set1(1.5));
+    c = c * scale;
+    s = s * scale;
+}
+// sin(x) / x, with its Taylor expansion near 0. x is not wrapped: window means
+// stay inside the exact range of sincos_lanes for windows up to about 90 years
+// at 15 diurnal harmonics, and past it the reduction error is divided by |x|.
+template <class V>
+inline V sinc_lanes(V x){
+    const V x2 = x * x;
+    const auto small = lt(x2, V::set1(1e-8));
+    V s = V::set1(0.0), c = V::set1(0.0);
+    sincos_lanes(x, s, c);
+    return V::select(small, fmadd(x2, V::set1(-1.0 / 6.0), V::set1(1.0)), s / V::select(small, V::set1(1.0), x));
+}
+// One packed coefficient row ([diurnal term][annual term]) against per-lane bases.
+template <class V, int A, int D>
+constexpr V evaluate_packed_lanes(const double* coeffs, const V (&annual)[A], const V (&diurnal)[D]){
+    V result = V::set1(0.0);
+    for(int p = 0; p < D; ++p){
+        V inner = V::set1(0.0);
+        for(int j = 0; j < A; ++j){
+            inner = fmadd(V::set1(coeffs[p * A + j]), annual[j], inner);
+        }
+        result = fmadd(inner, diurnal[p], result);
+    }
+    return result;
 }
+// exp(x) for |x| < 708: Cody-Waite reduction by ln 2 and a degree-13 Taylor
+// polynomial on |r| <= ln(2)/2 (< 1 ulp before the final rounding).
+template <class V>
+inline V exp_lanes(V x){
+    const V n = floor(fmadd(x, V::set1(1.44269504088896340736), V::set1(0.5)));
+    V r = fmadd(n, V::set1(-6.93147180369123816490e-01), x);
+    r = fmadd(n, V::set1(-1.90821492927058770002e-10), r);
+    V p = V::set1(1.0 / 6227020800.0);
+    const double inverse_factorials[] = {1.0 / 479001600.0, 1.0 / 39916800.0, 1.0 / 3628800.0, 1.0 / 362880.0, 1.0 / 40320.0, 1.0 / 5040.0, 1.0 / 720.0, 1.0 / 120.0, 1.0 / 24.0, 1.0 / 6.0, 0.5, 1.0, 1.0};
+    for(double c : inverse_factorials) p = fmadd(p, r, V::set1(c));
+    return ldexp(p, n);
+}
+// log(x) for positive normal x: x = m * 2^e with m in [sqrt(1/2), sqrt(2)), then
+// log(m) = 2 atanh(s), s = (m - 1) / (m + 1), |s| < 0.172, as an odd series.
+template <class V>
+inline V log_lanes(V x){
+    V e = V::set1(0.0);
+    V m = split_exponent(x, e);
+    const auto high = ge(m, V::set1(1.41421356237309504880));
+    m = V::select(high, m * V::set1(0.5), m);
+    e = V::select(high, e + V::set1(1.0), e);
+    const V s = (m - V::set1(1.0)) / (m + V::set1(1.0));
+    const V z = s * s;
+    V p = V::set1(1.0 / 21.0);
+    const double odd_inverses[] = {1.0 / 19.0, 1.0 / 17.0, 1.0 / 15.0, 1.0 / 13.0, 1.0 / 11.0, 1.0 / 9.0, 1.0 / 7.0, 1.0 / 5.0, 1.0 / 3.0};
+    for(double c : odd_inverses) p = fmadd(p, z, V::set1(c));
+    const V log_m = V::set1(2.0) * fmadd(s * z, p, s);
+    return fmadd(e, V::set1(6.93147180369123816490e-01), fmadd(e, V::set1(1.90821492927058770002e-10), log_m));
+}
+template <class V>
+constexpr V wrap_lanes(V x, double period){
+    const V p = V::set1(period);
+    x = fmadd(floor(x * V::set1(1.0 / period)), V::set1(-period), x);
+    x = V::select(ge(x, p), x - p, x);
+    return V::select(lt(x, V::set1(0.0)), x + p, x);
+}
+} // namespace detail
+#endif
+namespace fr_lille_lesquin {
+static constexpr double longitude_deg = 3.0975000858306885;
+static constexpr double latitude_deg = 50.569999694824219;
+static constexpr double delta_utc_solar_h = 0.20650000572204597;
+// Temperature, specific humidity and pressure, from the bundles' error_envelope.
+static constexpr ErrorEnvelope error_envelope[3] = {
+    {2.8588542190208845, -4.204185585836528e-16, -5.6387937688299994, 6.1525404262379046},
+    {0.0012410649999054979, -1.9107063397168713e-18, -0.0023650716758306539, 0.002714834961874146},
+    {7.5135671693318216, 2.4873417220819382e-13, -17.292451639697521, 15.044466565302663},
+};
+namespace detail {
+using namespace ::harmoclimat::detail;
+static constexpr int max_annual_harmonics = 3;
+static constexpr int max_diurnal_harmonics = 3;
+static constexpr int annual_basis_size = 2 * max_annual_harmonics + 1;
+static constexpr int diurnal_basis_size = 2 * max_diurnal_harmonics + 1;
 } // namespace detail
 namespace temperature_model {
 static constexpr int n_diurnal = 3;
@@ -63,14 +587,16 @@ static constexpr double b3_coeffs[] = {
     -0.080588409870119615, 0.14796525686736237, -0.019617163506910854, -0.055832235047913174, -0.00089679804827941202, -0.05099949784114486, -0.0092626923201209795
 };
 inline double evaluate(double day_solar, double hour_solar) {
-    double result = detail::eval_annual(c0_coeffs, c0_coeffs_n_annual, day_solar);
-    const double ome_d = detail::omega_diurnal;
-    result += detail::eval_annual(a1_coeffs, a1_coeffs_n_annual, day_solar) * std::cos(1 * ome_d * hour_solar);
-    result += detail::eval_annual(b1_coeffs, b1_coeffs_n_annual, day_solar) * std::sin(1 * ome_d * hour_solar);
-    result += detail::eval_annual(a2_coeffs, a2_coeffs_n_annual, day_solar) * std::cos(2 * ome_d * hour_solar);
-    result += detail::eval_annual(b2_coeffs, b2_coeffs_n_annual, day_solar) * std::sin(2 * ome_d * hour_solar);
-    result += detail::eval_annual(a3_coeffs, a3_coeffs_n_annual, day_solar) * std::cos(3 * ome_d * hour_solar);
-    result += detail::eval_annual(b3_coeffs, b3_coeffs_n_annual, day_solar) * std::sin(3 * ome_d * hour_solar);
+    double annual[detail::annual_basis_size], diurnal[detail::diurnal_basis_size];
+    detail::harmonic_basis<detail::max_annual_harmonics>(detail::omega_annual * day_solar, annual);
+    detail::harmonic_basis<detail::max_diurnal_harmonics>(detail::omega_diurnal * hour_solar, diurnal);
+    double result = detail::eval_annual(c0_coeffs, c0_coeffs_n_annual, annual);
+    result += detail::eval_annual(a1_coeffs, a1_coeffs_n_annual, annual) * diurnal[1];
+    result += detail::eval_annual(b1_coeffs, b1_coeffs_n_annual, annual) * diurnal[2];
+    result += detail::eval_annual(a2_coeffs, a2_coeffs_n_annual, annual) * diurnal[3];
+    result += detail::eval_annual(b2_coeffs, b2_coeffs_n_annual, annual) * diurnal[4];
+    result += detail::eval_annual(a3_coeffs, a3_coeffs_n_annual, annual) * diurnal[5];
+    result += detail::eval_annual(b3_coeffs, b3_coeffs_n_annual, annual) * diurnal[6];
     return result;
 }
 } // namespace temperature_model
@@ -105,14 +631,16 @@ static constexpr double b3_coeffs[] = {
     -1.4009818421916742e-05, 5.0319556221879818e-05, 4.1991654326294195e-06, -7.0487664291354366e-06, -4.0953049897741405e-06, -1.7989456257457413e-05, -2.6370680057067326e-07
 };
 inline double evaluate(double day_solar, double hour_solar) {
-    double result = detail::eval_annual(c0_coeffs, c0_coeffs_n_annual, day_solar);
-    const double ome_d = detail::omega_diurnal;
-    result += detail::eval_annual(a1_coeffs, a1_coeffs_n_annual, day_solar) * std::cos(1 * ome_d * hour_solar);
-    result += detail::eval_annual(b1_coeffs, b1_coeffs_n_annual, day_solar) * std::sin(1 * ome_d * hour_solar);
-    result += detail::eval_annual(a2_coeffs, a2_coeffs_n_annual, day_solar) * std::cos(2 * ome_d * hour_solar);
-    result += detail::eval_annual(b2_coeffs, b2_coeffs_n_annual, day_solar) * std::sin(2 * ome_d * hour_solar);
-    result += detail::eval_annual(a3_coeffs, a3_coeffs_n_annual, day_solar) * std::cos(3 * ome_d * hour_solar);
-    result += detail::eval_annual(b3_coeffs, b3_coeffs_n_annual, day_solar) * std::sin(3 * ome_d * hour_solar);
+    double annual[detail::annual_basis_size], diurnal[detail::diurnal_basis_size];
+    detail::harmonic_basis<detail::max_annual_harmonics>(detail::omega_annual * day_solar, annual);
+    detail::harmonic_basis<detail::max_diurnal_harmonics>(detail::omega_diurnal * hour_solar, diurnal);
+    double result = detail::eval_annual(c0_coeffs, c0_coeffs_n_annual, annual);
+    result += detail::eval_annual(a1_coeffs, a1_coeffs_n_annual, annual) * diurnal[1];
+    result += detail::eval_annual(b1_coeffs, b1_coeffs_n_annual, annual) * diurnal[2];
+    result += detail::eval_annual(a2_coeffs, a2_coeffs_n_annual, annual) * diurnal[3];
+    result += detail::eval_annual(b2_coeffs, b2_coeffs_n_annual, annual) * diurnal[4];
+    result += detail::eval_annual(a3_coeffs, a3_coeffs_n_annual, annual) * diurnal[5];
+    result += detail::eval_annual(b3_coeffs, b3_coeffs_n_annual, annual) * diurnal[6];
     return result;
 }
 } // namespace specific_humidity_model
@@ -147,17 +675,79 @@ static constexpr double b3_coeffs[] = {
     0.038092107970944984, 0.092687879086331956, 0.0027565430584841422, 0.01549969136777361, 0.01073183603496356, 0.0023333002838517611, 0.0075703663371655058
 };
 inline double evaluate(double day_solar, double hour_solar) {
-    double result = detail::eval_annual(c0_coeffs, c0_coeffs_n_annual, day_solar);
-    const double ome_d = detail::omega_diurnal;
-    result += detail::eval_annual(a1_coeffs, a1_coeffs_n_annual, day_solar) * std::cos(1 * ome_d * hour_solar);
-    result += detail::eval_annual(b1_coeffs, b1_coeffs_n_annual, day_solar) * std::sin(1 * ome_d * hour_solar);
-    result += detail::eval_annual(a2_coeffs, a2_coeffs_n_annual, day_solar) * std::cos(2 * ome_d * hour_solar);
-    result += detail::eval_annual(b2_coeffs, b2_coeffs_n_annual, day_solar) * std::sin(2 * ome_d * hour_solar);
-    result += detail::eval_annual(a3_coeffs, a3_coeffs_n_annual, day_solar) * std::cos(3 * ome_d * hour_solar);
-    result += detail::eval_annual(b3_coeffs, b3_coeffs_n_annual, day_solar) * std::sin(3 * ome_d * hour_solar);
+    double annual[detail::annual_basis_size], diurnal[detail::diurnal_basis_size];
+    detail::harmonic_basis<detail::max_annual_harmonics>(detail::omega_annual * day_solar, annual);
+    detail::harmonic_basis<detail::max_diurnal_harmonics>(detail::omega_diurnal * hour_solar, diurnal);
+    double result = detail::eval_annual(c0_coeffs, c0_coeffs_n_annual, annual);
+    result += detail::eval_annual(a1_coeffs, a1_coeffs_n_annual, annual) * diurnal[1];
+    result += detail::eval_annual(b1_coeffs, b1_coeffs_n_annual, annual) * diurnal[2];
+    result += detail::eval_annual(a2_coeffs, a2_coeffs_n_annual, annual) * diurnal[3];
+    result += detail::eval_annual(b2_coeffs, b2_coeffs_n_annual, annual) * diurnal[4];
+    result += detail::eval_annual(a3_coeffs, a3_coeffs_n_annual, annual) * diurnal[5];
+    result += detail::eval_annual(b3_coeffs, b3_coeffs_n_annual, annual) * diurnal[6];
     return result;
 }
 } // namespace pressure_model
+namespace detail {
+static constexpr int n_targets = 3;
+static constexpr int packed_size = annual_basis_size * diurnal_basis_size;
+static constexpr int packed_stride = (packed_size + 7) / 8 * 8;
+// Rows: temperature, specific humidity, pressure; each laid out as
+// [diurnal term][annual term] and zero-padded to packed_stride.
+alignas(64) static constexpr double packed_coeffs[n_targets][packed_stride] = {
+    {
+        11.408654848672338, -6.987343700258803, -2.9179685617235673, -0.13995770381612049, 0.44077815794611264, 0.012565579018429829, -0.060345782938747879,
+        -2.7465633763375581, 1.6902694771226157, 0.049014444714791952, 0.41139367751984252, -0.024524873204841938, -0.14359093439849255, 0.017862772977913777,
+        -0.74141510777474617, -0.021568555941127606, -0.25756068173587549, 0.14275433841410234, -0.13148605507450678, 0.13632606935425207, 0.12325410803101551,
+        0.43840019787620538, 0.23368618419467413, -0.081562313110486687, -0.23618081952564074, 0.039379526511920573, -0.021897427442306258, -0.0059644778873301166,
+        -0.093737503912091166, 0.19952948390758393, 0.094608922789077191, 0.13189989993482448, 0.056463503200789279, -0.08273141955274442, -0.03330344278907231,
+        0.092218577551689662, -0.27312455071837172, 0.017600094219537673, -0.068122973971125586, 0.029995955384786294, 0.061557225750277327, -0.015785071123948505,
+        -0.080588409870119615, 0.14796525686736237, -0.019617163506910854, -0.055832235047913174, -0.00089679804827941202, -0.05099949784114486, -0.0092626923201209795,
+        0, 0, 0, 0, 0, 0, 0
+    },
+    {
+        0.0067742570969763554, -0.0021202323827605304, -0.0014846987076769136, 0.00012637073364495452, 0.00031733075901297123, -6.589433218277688e-05, 4.9349437606270303e-05,
+        -0.0001070834542893885, -7.9543128361386916e-05, 2.7633231378070161e-05, 3.2288329359905383e-05, 5.7438809488565739e-05, 4.1817537102899343e-05, -4.1440335364689913e-05,
+        4.6976544858656557e-06, -0.0001189566618470402, -2.0562902005436045e-05, 2.4097874334934446e-05, 2.0483019881068099e-05, 2.8604605349686728e-05, -1.1510547692529119e-05,
+        -4.3969500372222767e-05, 0.00011625162228902136, 2.3014507471377959e-05, 2.3154068586271932e-05, -2.7326658305474611e-05, -3.1849957999336529e-05, -3.057972836642338e-06,
+        -6.4703714971221218e-05, 4.2397942886154483e-05, 1.4865620757772344e-05, 4.2479214895768868e-05, -6.8734674000957332e-06, -9.8901699432207509e-06, -3.8402699623320754e-06,
+        1.0006087344088268e-05, -1.8264077226422416e-06, -1.9729971733246366e-05, -4.3312393797779651e-05, 5.2001855378064636e-06, 6.9152678340134353e-06, 1.1284563113090815e-05,
+        -1.4009818421916742e-05, 5.0319556221879818e-05, 4.1991654326294195e-06, -7.0487664291354366e-06, -4.0953049897741405e-06, -1.7989456257457413e-05, -2.6370680057067326e-07,
+        0, 0, 0, 0, 0, 0, 0
+    },
+    {
+        1010.3909377864024, -0.095078501955901354, 0.25977347386858224, 0.36417538430435442, 0.66514263832737852, 0.30914287603371382, 0.72746563798975983,
+        0.033560892859495421, 0.0033342945176492388, 0.023750213072460901, 0.0098299327585000679, 0.0049706137511222326, 0.023217229415634463, 0.0053046686557678899,
+        0.058277992330785518, -0.092701894506559079, 0.031866926317183887, -0.024477953002711456, -0.0072044581183638573, 0.010818370287293551, -0.0052548937371748317,
+        -0.10396053173322184, 0.084653394921198791, 0.041840301200829481, 0.04899738027170257, 0.040910343369644511, -0.041669161243383164, -0.009645049776572193,
+        -0.33784088341629376, -0.016830356266891073, -0.032903841581298957, 0.03451181582601557, -0.014417074728272748, 0.0033532364537678097, 0.01819868053364334,
+        0.010516750653604447, 0.094535288050565464, -0.028608653925413244, -0.014678477995138722, -0.012649051875013806, -0.0049927712484426822, 0.001947906855380358,
+        0.038092107970944984, 0.092687879086331956, 0.0027565430584841422, 0.01549969136777361, 0.01073183603496356, 0.0023333002838517611, 0.0075703663371655058,
+        0, 0, 0, 0, 0, 0, 0
+    },
+};
+// Every target from one shared basis: the outer product of the diurnal and
+// annual bases is built once, then dotted with each packed coefficient row.
+inline void evaluate_fused(double day_solar, double hour_solar, double (&values)[n_targets]){
+    double annual[annual_basis_size], diurnal[diurnal_basis_size];
+    harmonic_basis<max_annual_harmonics>(omega_annual * day_solar, annual);
+    harmonic_basis<max_diurnal_harmonics>(omega_diurnal * hour_solar, diurnal);
+    alignas(64) double basis[packed_stride] = {};
+    for(int p = 0; p < diurnal_basis_size; ++p){
+        for(int j = 0; j < annual_basis_size; ++j){
+            basis[p * annual_basis_size + j] = diurnal[p] * annual[j];
+        }
+    }
+    using V = simd::native;
+    for(int t = 0; t < n_targets; ++t){
+        V acc = V::set1(0.0);
+        for(int i = 0; i < packed_stride; i += static_cast<int>(V::width)){
+            acc = fmadd(V::load(packed_coeffs[t] + i), V::load(basis + i), acc);
+        }
+        values[t] = reduce_add(acc);
+    }
+}
+} // namespace detail
 inline double predict_temperature(double day_utc, double hour_utc){
     double hour_solar = detail::wrap_hour(hour_utc + delta_utc_solar_h);
     double day_solar  = detail::wrap_day(day_utc + (delta_utc_solar_h / 24.0));
@@ -176,8 +766,575 @@ inline double predict_pressure(double day_utc, double hour_utc){
 inline void predict(double day_utc, double hour_utc, double& temperature_c, double& specific_humidity_kg_kg, double& pressure_hpa){
     double hour_solar = detail::wrap_hour(hour_utc + delta_utc_solar_h);
     double day_solar  = detail::wrap_day(day_utc + (delta_utc_solar_h / 24.0));
-    temperature_c = temperature_model::evaluate(day_solar, hour_solar);
-    specific_humidity_kg_kg = specific_humidity_model::evaluate(day_solar, hour_solar);
-    pressure_hpa = pressure_model::evaluate(day_solar, hour_solar);
+    double values[detail::n_targets];
+    detail::evaluate_fused(day_solar, hour_solar, values);
+    temperature_c = values[0];
+    specific_humidity_kg_kg = values[1];
+    pressure_hpa = values[2];
+}
+namespace detail {
+template <class V>
+constexpr void predict_solar_lanes(V day_solar, V hour_solar, double* temperature_c, double* specific_humidity_kg_kg, double* pressure_hpa){
+    V annual[annual_basis_size] = {}, diurnal[diurnal_basis_size] = {};
+    harmonic_basis_lanes<V, max_annual_harmonics>(day_solar * V::set1(omega_annual), annual);
+    harmonic_basis_lanes<V, max_diurnal_harmonics>(hour_solar * V::set1(omega_diurnal), diurnal);
+    double* outputs[n_targets] = {temperature_c, specific_humidity_kg_kg, pressure_hpa};
+    for(int t = 0; t < n_targets; ++t){
+        evaluate_packed_lanes(packed_coeffs[t], annual, diurnal).store(outputs[t]);
+    }
+}
+template <class V>
+constexpr void predict_lanes(const double* day_utc, const double* hour_utc, double* temperature_c, double* specific_humidity_kg_kg, double* pressure_hpa){
+    const V day_solar  = wrap_lanes(V::load(day_utc) + V::set1(delta_utc_solar_h / 24.0), solar_year_days);
+    const V hour_solar = wrap_lanes(V::load(hour_utc) + V::set1(delta_utc_solar_h), 24.0);
+    predict_solar_lanes(day_solar, hour_solar, temperature_c, specific_humidity_kg_kg, pressure_hpa);
+}
+} // namespace detail
+// Structure-of-arrays batch evaluation; results match predict() up to rounding.
+inline void predict_batch(const double* day_utc, const double* hour_utc, std::size_t count, double* temperature_c, double* specific_humidity_kg_kg, double* pressure_hpa){
+    using V = detail::simd::native;
+    std::size_t i = 0;
+    for (; i + V::width <= count; i += V::width) {
+        detail::predict_lanes<V>(day_utc + i, hour_utc + i, temperature_c + i, specific_humidity_kg_kg + i, pressure_hpa + i);
+    }
+    const std::size_t rem = count - i;  // fewer than V::width left
+    for (std::size_t k = 0; k < rem; ++k, ++i) {
+        detail::predict_lanes<detail::simd::f64x1>(day_utc + i, hour_utc + i, temperature_c + i, specific_humidity_kg_kg + i, pressure_hpa + i);
+    }
+}
+#if defined(__cpp_lib_span)
+// Span overload; every span must hold at least day_utc.size() elements.
+inline void predict_batch(std::span<const double> day_utc, std::span<const double> hour_utc, std::span<double> temperature_c, std::span<double> specific_humidity_kg_kg, std::span<double> pressure_hpa){
+    predict_batch(day_utc.data(), hour_utc.data(), day_utc.size(), temperature_c.data(), specific_humidity_kg_kg.data(), pressure_hpa.data());
+}
+#endif
+// Timestamp entry points. These follow harmoclimate.core.compute_solar_time, the
+// definition the model was fitted on, which shifts the day by longitude / 360 of a
+// year rather than by delta_utc_solar_h / 24 as the (day_utc, hour_utc) overloads do.
+// Sub-second parts are dropped, as in the Python path.
+inline SolarTime solar_time(std::int64_t unix_seconds){
+    return detail::solar_time_from_unix(unix_seconds, longitude_deg);
+}
+inline void solar_time_batch(const std::int64_t* unix_seconds, std::size_t count, double* day_solar, double* hour_solar){
+    for (std::size_t i = 0; i < count; ++i) {
+        const SolarTime solar = solar_time(unix_seconds[i]);
+        day_solar[i] = solar.day;
+        hour_solar[i] = solar.hour;
+    }
+}
+inline void predict(std::int64_t unix_seconds, double& temperature_c, double& specific_humidity_kg_kg, double& pressure_hpa){
+    const SolarTime solar = solar_time(unix_seconds);
+    double values[detail::n_targets];
+    detail::evaluate_fused(solar.day, solar.hour, values);
+    temperature_c = values[0];
+    specific_humidity_kg_kg = values[1];
+    pressure_hpa = values[2];
+}
+inline void predict_batch(const std::int64_t* unix_seconds, std::size_t count, double* temperature_c, double* specific_humidity_kg_kg, double* pressure_hpa){
+    using V = detail::simd::native;
+    alignas(64) double day_solar[V::width], hour_solar[V::width];
+    std::size_t i = 0;
+    for (; i + V::width <= count; i += V::width) {
+        solar_time_batch(unix_seconds + i, V::width, day_solar, hour_solar);
+        detail::predict_solar_lanes(V::load(day_solar), V::load(hour_solar), temperature_c + i, specific_humidity_kg_kg + i, pressure_hpa + i);
+    }
+    const std::size_t rem = count - i;  // fewer than V::width left
+    for (std::size_t k = 0; k < rem; ++k, ++i) {
+        const SolarTime solar = solar_time(unix_seconds[i]);
+        detail::predict_solar_lanes(detail::simd::f64x1::set1(solar.day), detail::simd::f64x1::set1(solar.hour), 
+                                    temperature_c + i, specific_humidity_kg_kg + i, pressure_hpa + i);
+    }
+}
+#if __cplusplus >= 202002L
+template <class Duration>
+inline SolarTime solar_time(std::chrono::sys_time<Duration> time){
+    return solar_time(std::chrono::floor<std::chrono::seconds>(time).time_since_epoch().count());
+}
+template <class Duration>
+inline void predict(std::chrono::sys_time<Duration> time, double& temperature_c, double& specific_humidity_kg_kg, double& pressure_hpa){
+    predict(std::chrono::floor<std::chrono::seconds>(time).time_since_epoch().count(), temperature_c, specific_humidity_kg_kg, pressure_hpa);
+}
+#endif
+namespace detail {
+// 1.6448536... = Phi^-1(0.95): a Gaussian with the envelope's 90% band has this sigma.
+static constexpr double envelope_z95 = 1.6448536269514722;
+template <class V>
+inline void score_lanes(const std::int64_t* unix_seconds, std::size_t i, const Observations& observations,
+                        const ScoreOutputs& outputs){
+    alignas(64) double day_solar[V::width], hour_solar[V::width];
+    for (std::size_t l = 0; l < V::width; ++l) {
+        const SolarTime solar = solar_time_from_unix(unix_seconds[i + l], longitude_deg);
+        day_solar[l] = solar.day;
+        hour_solar[l] = solar.hour;
+    }
+    alignas(64) double predicted[n_targets][V::width];
+    predict_solar_lanes(V::load(day_solar), V::load(hour_solar), predicted[0], predicted[1], predicted[2]);
+    const double* observed[n_targets] = {observations.temperature_c, observations.specific_humidity_kg_kg,
+                                         observations.pressure_hpa};
+    std::uint8_t flags[V::width] = {};
+    for(int t = 0; t < n_targets; ++t){
+        if (!observed[t]) continue;
+        const ErrorEnvelope& envelope = error_envelope[t];
+        const V residual = V::load(observed[t] + i) - V::load(predicted[t]);
+        if (outputs.residual[t]) residual.store(outputs.residual[t] + i);
+        if (outputs.standardized[t]) {
+            const double center = 0.5 * (envelope.p05 + envelope.p95);
+            const double inverse_sigma = 2.0 * envelope_z95 / (envelope.p95 - envelope.p05);
+            ((residual - V::set1(center)) * V::set1(inverse_sigma)).store(outputs.standardized[t] + i);
+        }
+        if (outputs.out_of_band) {
+            alignas(64) double lanes[V::width];
+            residual.store(lanes);
+            for (std::size_t l = 0; l < V::width; ++l) {
+                const bool outside = lanes[l] < envelope.p05 || lanes[l] > envelope.p95;
+                flags[l] = static_cast<std::uint8_t>(flags[l] | (outside ? 1u << t : 0u));
+            }
+        }
+    }
+    if (outputs.out_of_band) {
+        for (std::size_t l = 0; l < V::width; ++l) outputs.out_of_band[i + l] = flags[l];
+    }
+}
+} // namespace detail
+// Scores observations taken at Unix timestamps against the model and its
+// error_envelope in one vectorised pass. The residual is observed - predicted,
+// on the same solar-time definition as training. The standardized score centres it
+// on the [p05, p95] band and divides by that band's Gaussian sigma, so up to
+// rounding at the edges |score| > 1.645 exactly when the out-of-band bit is set.
+// NaN observations give NaN residuals and no flag.
+inline void score(const Observations& observations, const std::int64_t* unix_seconds, std::size_t count,
+                  const ScoreOutputs& outputs){
+    using V = detail::simd::native;
+    std::size_t i = 0;
+    for (; i + V::width <= count; i += V::width) {
+        detail::score_lanes<V>(unix_seconds, i, observations, outputs);
+    }
+    const std::size_t rem = count - i;  // fewer than V::width left
+    for (std::size_t k = 0; k < rem; ++k, ++i) {
+        detail::score_lanes<detail::simd::f64x1>(unix_seconds, i, observations, outputs);
+    }
+}
+// Same model as predict(), through the libm-free one-lane kernels, so it can run
+// in constant expressions; at runtime it agrees with predict() up to rounding.
+constexpr Prediction predict_constexpr(double day_utc, double hour_utc){
+    Prediction out{0.0, 0.0, 0.0};
+    detail::predict_lanes<detail::simd::f64x1>(&day_utc, &hour_utc, &out.temperature_c, &out.specific_humidity_kg_kg, &out.pressure_hpa);
+    return out;
+}
+#if defined(__cpp_consteval)
+// Compile-time table for ROM images, e.g. 8760 hourly values:
+//   static constexpr auto table = year_grid();
+// The annual series are collapsed once per day and the diurnal basis once per step.
+template <int Days = 365, int StepsPerDay = 24>
+consteval YearGrid<Days, StepsPerDay> year_grid(){
+    using V = detail::simd::f64x1;
+    YearGrid<Days, StepsPerDay> grid{};
+    double diurnal[StepsPerDay][detail::diurnal_basis_size] = {};
+    for(int step = 0; step < StepsPerDay; ++step){
+        const V hour_solar = detail::wrap_lanes(V::set1(step * (24.0 / StepsPerDay) + delta_utc_solar_h), 24.0);
+        V basis[detail::diurnal_basis_size] = {};
+        detail::harmonic_basis_lanes<V, detail::max_diurnal_harmonics>(hour_solar * V::set1(detail::omega_diurnal), basis);
+        for(int p = 0; p < detail::diurnal_basis_size; ++p) diurnal[step][p] = basis[p].v;
+    }
+    // Plain doubles below: constant evaluation cost is what limits the grid size.
+    for(int day = 0; day < Days; ++day){
+        const V day_solar = detail::wrap_lanes(V::set1(day + delta_utc_solar_h / 24.0), detail::solar_year_days);
+        V annual[detail::annual_basis_size] = {};
+        detail::harmonic_basis_lanes<V, detail::max_annual_harmonics>(day_solar * V::set1(detail::omega_annual), annual);
+        double day_coeffs[detail::n_targets][detail::diurnal_basis_size] = {};
+        for(int t = 0; t < detail::n_targets; ++t){
+            for(int p = 0; p < detail::diurnal_basis_size; ++p){
+                const double* row = detail::packed_coeffs[t] + p * detail::annual_basis_size;
+                double inner = 0.0;
+                for(int j = 0; j < detail::annual_basis_size; ++j) inner += row[j] * annual[j].v;
+                day_coeffs[t][p] = inner;
+            }
+        }
+        for(int step = 0; step < StepsPerDay; ++step){
+            double values[detail::n_targets] = {};
+            for(int t = 0; t < detail::n_targets; ++t){
+                for(int p = 0; p < detail::diurnal_basis_size; ++p){
+                    values[t] += day_coeffs[t][p] * diurnal[step][p];
+                }
+            }
+            const std::size_t index = static_cast<std::size_t>(day) * StepsPerDay + step;
+            grid.temperature_c[index] = values[0];
+            grid.specific_humidity_kg_kg[index] = values[1];
+            grid.pressure_hpa[index] = values[2];
+        }
+    }
+    return grid;
+}
+#endif
+namespace detail {
+static constexpr int year_profile_days = 366;
+template <class V>
+inline void day_profile_lanes(const double (&coeffs)[n_targets][diurnal_basis_size], const double* hour_utc, double* temperature_c, double* specific_humidity_kg_kg, double* pressure_hpa){
+    const V hour_solar = wrap_lanes(V::load(hour_utc) + V::set1(delta_utc_solar_h), 24.0);
+    V diurnal[diurnal_basis_size];
+    harmonic_basis_lanes<V, max_diurnal_harmonics>(hour_solar * V::set1(omega_diurnal), diurnal);
+    double* outputs[n_targets] = {temperature_c, specific_humidity_kg_kg, pressure_hpa};
+    for(int t = 0; t < n_targets; ++t){
+        V value = V::set1(0.0);
+        for(int p = 0; p < diurnal_basis_size; ++p){
+            value = fmadd(V::set1(coeffs[t][p]), diurnal[p], value);
+        }
+        value.store(outputs[t]);
+    }
+}
+} // namespace detail
+// Annual series of every target evaluated once for a solar day, leaving the
+// diurnal Fourier coefficients (c0, a1, b1, a2, b2, ...). Each hour of that day
+// then costs one diurnal sincos and a short dot product per target.
+struct DayProfile {
+    double day_solar = 0.0;
+    double coeffs[detail::n_targets][detail::diurnal_basis_size] = {};
+    static DayProfile from_solar_day(double day_solar){
+        DayProfile profile;
+        profile.day_solar = day_solar;
+        double annual[detail::annual_basis_size];
+        detail::harmonic_basis<detail::max_annual_harmonics>(detail::omega_annual * day_solar, annual);
+        for(int t = 0; t < detail::n_targets; ++t){
+            for(int p = 0; p < detail::diurnal_basis_size; ++p){
+                const double* row = detail::packed_coeffs[t] + p * detail::annual_basis_size;
+                double value = 0.0;
+                for(int j = 0; j < detail::annual_basis_size; ++j){
+                    value += row[j] * annual[j];
+                }
+                profile.coeffs[t][p] = value;
+            }
+        }
+        return profile;
+    }
+    // Same day convention as predict(): only day_utc selects the solar day.
+    static DayProfile from_utc_day(double day_utc){
+        return from_solar_day(detail::wrap_day(day_utc + (delta_utc_solar_h / 24.0)));
+    }
+    void predict(double hour_utc, double& temperature_c, double& specific_humidity_kg_kg, double& pressure_hpa) const {
+        double diurnal[detail::diurnal_basis_size];
+        const double hour_solar = detail::wrap_hour(hour_utc + delta_utc_solar_h);
+        detail::harmonic_basis<detail::max_diurnal_harmonics>(detail::omega_diurnal * hour_solar, diurnal);
+        double values[detail::n_targets];
+        for(int t = 0; t < detail::n_targets; ++t){
+            double value = 0.0;
+            for(int p = 0; p < detail::diurnal_basis_size; ++p){
+                value += coeffs[t][p] * diurnal[p];
+            }
+            values[t] = value;
+        }
+        temperature_c = values[0];
+        specific_humidity_kg_kg = values[1];
+        pressure_hpa = values[2];
+    }
+    void predict_batch(const double* hour_utc, std::size_t count, double* temperature_c, double* specific_humidity_kg_kg, double* pressure_hpa) const {
+        using V = detail::simd::native;
+        std::size_t i = 0;
+        for (; i + V::width <= count; i += V::width) {
+            detail::day_profile_lanes<V>(coeffs, hour_utc + i, temperature_c + i, specific_humidity_kg_kg + i, pressure_hpa + i);
+        }
+        const std::size_t rem = count - i;  // fewer than V::width left
+        for (std::size_t k = 0; k < rem; ++k, ++i) {
+            detail::day_profile_lanes<detail::simd::f64x1>(coeffs, hour_utc + i, temperature_c + i, specific_humidity_kg_kg + i, pressure_hpa + i);
+        }
+    }
+    // Exact daily mean, min and max of every target for this solar day, with the
+    // UTC hours of the extrema (see detail::diurnal_extremes).
+    DailyStats stats() const {
+        return {
+            detail::diurnal_extremes<detail::max_diurnal_harmonics>(coeffs[0], delta_utc_solar_h),
+            detail::diurnal_extremes<detail::max_diurnal_harmonics>(coeffs[1], delta_utc_solar_h),
+            detail::diurnal_extremes<detail::max_diurnal_harmonics>(coeffs[2], delta_utc_solar_h),
+        };
+    }
+};
+// DayProfile of every integer solar day 0..365 (the last covers the trailing
+// 0.24 day of the solar year). Lookups floor the solar day like the Python
+// display helpers, so results differ from predict() by up to one day of
+// annual drift. Roughly 64 KiB; build it once and share it.
+struct YearProfiles {
+    DayProfile days[detail::year_profile_days];
+    YearProfiles(){
+        for(int d = 0; d < detail::year_profile_days; ++d){
+            days[d] = DayProfile::from_solar_day(static_cast<double>(d));
+        }
+    }
+    const DayProfile& for_utc_day(double day_utc) const {
+        const double day_solar = detail::wrap_day(day_utc + (delta_utc_solar_h / 24.0));
+        return days[static_cast<int>(day_solar)];
+    }
+};
+// Daily statistics of every integer solar day 0..365 in one pass over the year;
+// entry d describes the same day as YearProfiles::days[d].
+inline void year_daily_stats(DailyStats (&stats)[detail::year_profile_days]){
+    for(int d = 0; d < detail::year_profile_days; ++d){
+        stats[d] = DayProfile::from_solar_day(static_cast<double>(d)).stats();
+    }
+}
+namespace detail {
+static constexpr std::size_t stepper_renormalize_interval = 256;
+template <class V>
+inline void stepper_lanes(V annual_cos, V annual_sin, V diurnal_cos, V diurnal_sin, double* temperature_c, double* specific_humidity_kg_kg, double* pressure_hpa){
+    V annual[annual_basis_size], diurnal[diurnal_basis_size];
+    harmonic_series_lanes<V, max_annual_harmonics>(annual_cos, annual_sin, annual);
+    harmonic_series_lanes<V, max_diurnal_harmonics>(diurnal_cos, diurnal_sin, diurnal);
+    double* outputs[n_targets] = {temperature_c, specific_humidity_kg_kg, pressure_hpa};
+    for(int t = 0; t < n_targets; ++t){
+        evaluate_packed_lanes(packed_coeffs[t], annual, diurnal).store(outputs[t]);
+    }
+}
+} // namespace detail
+// Fixed-step series: element n is predict(day_utc + n * step_hours / 24,
+// hour_utc + n * step_hours), i.e. continuous time t = day_utc * 24 advanced
+// in step_hours increments. The annual and diurnal phasors advance by one
+// complex multiplication per step, so no trig runs after construction; every
+// detail::stepper_renormalize_interval steps they are pulled back to unit length.
+// Iterate it in a range-for, or use fill() for whole series (SIMD across steps).
+struct TimeSeriesStepper {
+    double annual_angle = 0.0;
+    double diurnal_angle = 0.0;
+    double annual_step = 0.0;
+    double diurnal_step = 0.0;
+    std::size_t count = 0;
+
+    struct iterator {
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Prediction;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Prediction*;
+        using reference = Prediction;
+
+        std::size_t index = 0;
+        double annual_cos = 1.0, annual_sin = 0.0;
+        double diurnal_cos = 1.0, diurnal_sin = 0.0;
+        double annual_step_cos = 1.0, annual_step_sin = 0.0;
+        double diurnal_step_cos = 1.0, diurnal_step_sin = 0.0;
+
+        Prediction operator*() const {
+            using V = detail::simd::f64x1;
+            Prediction out{0.0, 0.0, 0.0};
+            detail::stepper_lanes<V>(V::set1(annual_cos), V::set1(annual_sin), V::set1(diurnal_cos), V::set1(diurnal_sin), &out.temperature_c, &out.specific_humidity_kg_kg, &out.pressure_hpa);
+            return out;
+        }
+        iterator& operator++(){
+            using V = detail::simd::f64x1;
+            V ac = V::set1(annual_cos), as = V::set1(annual_sin);
+            V dc = V::set1(diurnal_cos), ds = V::set1(diurnal_sin);
+            detail::rotate_lanes(ac, as, V::set1(annual_step_cos), V::set1(annual_step_sin));
+            detail::rotate_lanes(dc, ds, V::set1(diurnal_step_cos), V::set1(diurnal_step_sin));
+            if (++index % detail::stepper_renormalize_interval == 0) {
+                detail::renormalize_lanes(ac, as);
+                detail::renormalize_lanes(dc, ds);
+            }
+            annual_cos = ac.v; annual_sin = as.v;
+            diurnal_cos = dc.v; diurnal_sin = ds.v;
+            return *this;
+        }
+        iterator operator++(int){
+            iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+        friend bool operator==(const iterator& a, const iterator& b){ return a.index == b.index; }
+        friend bool operator!=(const iterator& a, const iterator& b){ return a.index != b.index; }
+    };
+
+    TimeSeriesStepper(double day_utc, double hour_utc, double step_hours, std::size_t steps)
+        : annual_angle(detail::omega_annual * detail::wrap_day(day_utc + (delta_utc_solar_h / 24.0))),
+          diurnal_angle(detail::omega_diurnal * detail::wrap_hour(hour_utc + delta_utc_solar_h)),
+          annual_step(detail::omega_annual * (step_hours / 24.0)),
+          diurnal_step(detail::omega_diurnal * step_hours),
+          count(steps) {}
+
+    std::size_t size() const { return count; }
+    iterator begin() const {
+        iterator it;
+        it.annual_cos = std::cos(annual_angle);
+        it.annual_sin = std::sin(annual_angle);
+        it.diurnal_cos = std::cos(diurnal_angle);
+        it.diurnal_sin = std::sin(diurnal_angle);
+        it.annual_step_cos = std::cos(annual_step);
+        it.annual_step_sin = std::sin(annual_step);
+        it.diurnal_step_cos = std::cos(diurnal_step);
+        it.diurnal_step_sin = std::sin(diurnal_step);
+        return it;
+    }
+    iterator end() const {
+        iterator it;
+        it.index = count;
+        return it;
+    }
+
+    // Writes size() values per output. Lane i of each SIMD block starts i steps
+    // ahead and every block rotates all lanes by V::width steps.
+    void fill(double* temperature_c, double* specific_humidity_kg_kg, double* pressure_hpa) const {
+        using V = detail::simd::native;
+        constexpr std::size_t width = V::width;
+        double lane_annual_cos[width], lane_annual_sin[width], lane_diurnal_cos[width], lane_diurnal_sin[width];
+        for(std::size_t i = 0; i < width; ++i){
+            const double lane = static_cast<double>(i);
+            lane_annual_cos[i] = std::cos(annual_angle + lane * annual_step);
+            lane_annual_sin[i] = std::sin(annual_angle + lane * annual_step);
+            lane_diurnal_cos[i] = std::cos(diurnal_angle + lane * diurnal_step);
+            lane_diurnal_sin[i] = std::sin(diurnal_angle + lane * diurnal_step);
+        }
+        V ac = V::load(lane_annual_cos), as = V::load(lane_annual_sin);
+        V dc = V::load(lane_diurnal_cos), ds = V::load(lane_diurnal_sin);
+        const double block = static_cast<double>(width);
+        const V annual_block_cos = V::set1(std::cos(block * annual_step));
+        const V annual_block_sin = V::set1(std::sin(block * annual_step));
+        const V diurnal_block_cos = V::set1(std::cos(block * diurnal_step));
+        const V diurnal_block_sin = V::set1(std::sin(block * diurnal_step));
+        constexpr std::size_t renormalize_blocks = (detail::stepper_renormalize_interval + width - 1) / width;
+        std::size_t i = 0;
+        for (std::size_t blocks = 1; i + width <= count; i += width, ++blocks) {
+            detail::stepper_lanes<V>(ac, as, dc, ds, temperature_c + i, specific_humidity_kg_kg + i, pressure_hpa + i);
+            detail::rotate_lanes(ac, as, annual_block_cos, annual_block_sin);
+            detail::rotate_lanes(dc, ds, diurnal_block_cos, diurnal_block_sin);
+            if (blocks % renormalize_blocks == 0) {
+                detail::renormalize_lanes(ac, as);
+                detail::renormalize_lanes(dc, ds);
+            }
+        }
+        if (i < count) {
+            double tail[detail::n_targets][width];
+            detail::stepper_lanes<V>(ac, as, dc, ds, tail[0], tail[1], tail[2]);
+            const std::size_t rem = count - i;  // fewer than width left
+            for(std::size_t k = 0; k < rem; ++k){
+                temperature_c[i + k] = tail[0][k];
+                specific_humidity_kg_kg[i + k] = tail[1][k];
+                pressure_hpa[i + k] = tail[2][k];
+            }
+        }
+    }
+#if defined(__cpp_lib_span)
+    // Span overload; every span must hold at least size() elements.
+    void fill(std::span<double> temperature_c, std::span<double> specific_humidity_kg_kg, std::span<double> pressure_hpa) const {
+        fill(temperature_c.data(), specific_humidity_kg_kg.data(), pressure_hpa.data());
+    }
+#endif
+};
+namespace detail {
+// Window mean of every target. Each packed term is a product of an annual and a
+// diurnal sinusoid, i.e. two sinusoids of frequencies k*omega_d +/- m*omega_a/24
+// (per hour); over a window of half-length h a sinusoid averages to its midpoint
+// value times sinc(frequency * h). Regrouped on the midpoint bases, with S and D the
+// half sum and half difference of the two sinc factors:
+//   cos cos -> S cos cos - D sin sin     cos sin -> S cos sin + D sin cos
+//   sin cos -> S sin cos + D cos sin     sin sin -> S sin sin - D cos cos
+template <class V>
+inline void window_mean_lanes(V day_utc, V hour_utc, V duration_hours, V (&means)[n_targets]){
+    const V half = duration_hours * V::set1(0.5);
+    const V day_mid = wrap_lanes(fmadd(half, V::set1(1.0 / 24.0), day_utc + V::set1(delta_utc_solar_h / 24.0)), solar_year_days);
+    const V hour_mid = wrap_lanes(hour_utc + V::set1(delta_utc_solar_h) + half, 24.0);
+    V annual[annual_basis_size] = {}, diurnal[diurnal_basis_size] = {};
+    harmonic_basis_lanes<V, max_annual_harmonics>(day_mid * V::set1(omega_annual), annual);
+    harmonic_basis_lanes<V, max_diurnal_harmonics>(hour_mid * V::set1(omega_diurnal), diurnal);
+    V sum[max_diurnal_harmonics + 1][max_annual_harmonics + 1] = {};
+    V difference[max_diurnal_harmonics + 1][max_annual_harmonics + 1] = {};
+    for(int k = 0; k <= max_diurnal_harmonics; ++k){
+        for(int m = 0; m <= max_annual_harmonics; ++m){
+            const V plus = sinc_lanes(half * V::set1(k * omega_diurnal + m * omega_annual / 24.0));
+            const V minus = m == 0 ? plus : sinc_lanes(half * V::set1(k * omega_diurnal - m * omega_annual / 24.0));
+            sum[k][m] = (plus + minus) * V::set1(0.5);
+            difference[k][m] = (plus - minus) * V::set1(0.5);
+        }
+    }
+    for(int t = 0; t < n_targets; ++t) means[t] = V::set1(0.0);
+    for(int p = 0; p < diurnal_basis_size; ++p){
+        const int k = (p + 1) / 2;
+        for(int j = 0; j < annual_basis_size; ++j){
+            const int m = (j + 1) / 2;
+            V term = sum[k][m] * diurnal[p] * annual[j];
+            if (k > 0 && m > 0) {
+                const V partner = diurnal[p % 2 ? p + 1 : p - 1] * annual[j % 2 ? j + 1 : j - 1];
+                const V d = p % 2 == j % 2 ? V::set1(0.0) - difference[k][m] : difference[k][m];
+                term = fmadd(d, partner, term);
+            }
+            for(int t = 0; t < n_targets; ++t){
+                means[t] = fmadd(V::set1(packed_coeffs[t][p * annual_basis_size + j]), term, means[t]);
+            }
+        }
+    }
+}
+template <class V>
+inline void integrate_lanes(const double* day_utc, const double* hour_utc, const double* duration_hours,
+                            double* temperature_c, double* specific_humidity_kg_kg, double* pressure_hpa){
+    const V duration = V::load(duration_hours);
+    V means[n_targets];
+    window_mean_lanes(V::load(day_utc), V::load(hour_utc), duration, means);
+    (means[0] * duration).store(temperature_c);
+    (means[1] * duration).store(specific_humidity_kg_kg);
+    (means[2] * duration).store(pressure_hpa);
+}
+} // namespace detail
+// Exact integrals (value x hours) of T, Q and P over duration_hours starting at
+// (day_utc, hour_utc), along the continuous timeline of TimeSeriesStepper: the point
+// s hours in is predict(day_utc + s / 24, hour_utc + s). Constant cost for any
+// window length; a negative duration integrates backwards.
+inline Prediction integrate(double day_utc, double hour_utc, double duration_hours){
+    Prediction out{};
+    detail::integrate_lanes<detail::simd::f64x1>(&day_utc, &hour_utc, &duration_hours, &out.temperature_c,
+                                                 &out.specific_humidity_kg_kg, &out.pressure_hpa);
+    return out;
+}
+// integrate() divided by the duration; a zero duration gives the point value.
+inline Prediction window_mean(double day_utc, double hour_utc, double duration_hours){
+    using V = detail::simd::f64x1;
+    V means[detail::n_targets];
+    detail::window_mean_lanes(V::set1(day_utc), V::set1(hour_utc), V::set1(duration_hours), means);
+    return {means[0].v, means[1].v, means[2].v};
+}
+// integrate() for many windows at once, vectorised across windows.
+inline void integrate_batch(const double* day_utc, const double* hour_utc, const double* duration_hours,
+                            std::size_t count, double* temperature_c, double* specific_humidity_kg_kg,
+                            double* pressure_hpa){
+    using V = detail::simd::native;
+    std::size_t i = 0;
+    for (; i + V::width <= count; i += V::width) {
+        detail::integrate_lanes<V>(day_utc + i, hour_utc + i, duration_hours + i, temperature_c + i,
+                                   specific_humidity_kg_kg + i, pressure_hpa + i);
+    }
+    const std::size_t rem = count - i;  // fewer than V::width left
+    for (std::size_t k = 0; k < rem; ++k, ++i) {
+        detail::integrate_lanes<detail::simd::f64x1>(day_utc + i, hour_utc + i, duration_hours + i, temperature_c + i,
+                                                     specific_humidity_kg_kg + i, pressure_hpa + i);
+    }
+}
+#if defined(HARMOCLIMAT_PSYCHROMETRICS)
+// predict() plus relative humidity, dew point and vapour pressure derived as in
+// harmoclimate.psychrometrics; tolerances are listed in harmoclimat_psychrometrics.hpp.
+inline FullPrediction predict_full(double day_utc, double hour_utc){
+    double values[detail::n_targets];
+    double derived[3];
+    predict(day_utc, hour_utc, values[0], values[1], values[2]);
+    psychrometrics::detail::derive_lanes<detail::simd::f64x1>(values, values + 1, values + 2,
+                                                              derived, derived + 1, derived + 2);
+    return {values[0], values[1], values[2], derived[0], derived[1], derived[2]};
+}
+// Fused batch: each SIMD block is predicted and converted before moving on, so the
+// T/Q/P lanes are still in L1 when RH, Td and E are derived from them.
+inline void predict_full_batch(const double* day_utc, const double* hour_utc, std::size_t count,
+                               double* temperature_c, double* specific_humidity_kg_kg, double* pressure_hpa,
+                               double* relative_humidity_percent, double* dew_point_c, double* vapor_pressure_hpa){
+    using V = detail::simd::native;
+    std::size_t i = 0;
+    for (; i + V::width <= count; i += V::width) {
+        detail::predict_lanes<V>(day_utc + i, hour_utc + i, temperature_c + i, specific_humidity_kg_kg + i, pressure_hpa + i);
+        psychrometrics::detail::derive_lanes<V>(temperature_c + i, specific_humidity_kg_kg + i, pressure_hpa + i,
+                                                relative_humidity_percent + i, dew_point_c + i, vapor_pressure_hpa + i);
+    }
+    const std::size_t rem = count - i;  // fewer than V::width left
+    for (std::size_t k = 0; k < rem; ++k, ++i) {
+        detail::predict_lanes<detail::simd::f64x1>(day_utc + i, hour_utc + i, temperature_c + i,
+                                                   specific_humidity_kg_kg + i, pressure_hpa + i);
+        psychrometrics::detail::derive_lanes<detail::simd::f64x1>(temperature_c + i, specific_humidity_kg_kg + i,
+                                                                  pressure_hpa + i, relative_humidity_percent + i,
+                                                                  dew_point_c + i, vapor_pressure_hpa + i);
+    }
 }
+#endif
+} // namespace fr_lille_lesquin
+// Keeps harmoclimat::predict() and friends working when a single station header
+// is included; with several, name the station (harmoclimat::fr_lille_lesquin::predict).
+using namespace fr_lille_lesquin;
 } // namespace harmoclimat
\ No newline at end of file
@@ -0,0 +1,55 @@
+// Auto-generated registry of the HarmoClimate station headers
+// Stations : 11
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include "fr_bordeaux_merignac.hpp"
+#include "fr_bourges.hpp"
+#include "fr_clermont_fd.hpp"
+#include "fr_lille_lesquin.hpp"
+#include "fr_lyon_bron.hpp"
+#include "fr_marignane.hpp"
+#include "fr_nantes_bouguenais.hpp"
+#include "fr_paris_montsouris.hpp"
+#include "fr_strasbourg_entzheim.hpp"
+#include "fr_toulouse_blagnac.hpp"
+#include "fr_trappes.hpp"
+namespace harmoclimat {
+// One row per station. Calling a station namespace directly
+// (harmoclimat::fr_bourges::predict) is a plain inline call; the function
+// pointers here serve runtime selection by station code.
+struct StationEntry {
+    std::string_view code;
+    std::string_view name;
+    double longitude_deg;
+    double latitude_deg;
+    double delta_utc_solar_h;
+    void (*predict)(double, double, double&, double&, double&);
+    void (*predict_batch)(const double*, const double*, std::size_t, double*, double*, double*);
+    void (*predict_batch_unix)(const std::int64_t*, std::size_t, double*, double*, double*);
+};
+inline constexpr StationEntry stations[] = {
+    {"33281001", "BORDEAUX-MERIGNAC", fr_bordeaux_merignac::longitude_deg, 44.830665588378906, fr_bordeaux_merignac::delta_utc_solar_h, &fr_bordeaux_merignac::predict, &fr_bordeaux_merignac::predict_batch, &fr_bordeaux_merignac::predict_batch},
+    {"18033001", "BOURGES", fr_bourges::longitude_deg, 47.059165954589844, fr_bourges::delta_utc_solar_h, &fr_bourges::predict, &fr_bourges::predict_batch, &fr_bourges::predict_batch},
+    {"63113001", "CLERMONT-FD", fr_clermont_fd::longitude_deg, 45.786834716796875, fr_clermont_fd::delta_utc_solar_h, &fr_clermont_fd::predict, &fr_clermont_fd::predict_batch, &fr_clermont_fd::predict_batch},
+    {"59343001", "LILLE-LESQUIN", fr_lille_lesquin::longitude_deg, 50.569999694824219, fr_lille_lesquin::delta_utc_solar_h, &fr_lille_lesquin::predict, &fr_lille_lesquin::predict_batch, &fr_lille_lesquin::predict_batch},
+    {"69029001", "LYON-BRON", fr_lyon_bron::longitude_deg, 45.721332550048828, fr_lyon_bron::delta_utc_solar_h, &fr_lyon_bron::predict, &fr_lyon_bron::predict_batch, &fr_lyon_bron::predict_batch},
+    {"13054001", "MARIGNANE", fr_marignane::longitude_deg, 43.437667846679688, fr_marignane::delta_utc_solar_h, &fr_marignane::predict, &fr_marignane::predict_batch, &fr_marignane::predict_batch},
+    {"44020001", "NANTES-BOUGUENAIS", fr_nantes_bouguenais::longitude_deg, 47.150001525878906, fr_nantes_bouguenais::delta_utc_solar_h, &fr_nantes_bouguenais::predict, &fr_nantes_bouguenais::predict_batch, &fr_nantes_bouguenais::predict_batch},
+    {"75114001", "PARIS-MONTSOURIS", fr_paris_montsouris::longitude_deg, 48.821666717529297, fr_paris_montsouris::delta_utc_solar_h, &fr_paris_montsouris::predict, &fr_paris_montsouris::predict_batch, &fr_paris_montsouris::predict_batch},
+    {"67124001", "STRASBOURG-ENTZHEIM", fr_strasbourg_entzheim::longitude_deg, 48.54949951171875, fr_strasbourg_entzheim::delta_utc_solar_h, &fr_strasbourg_entzheim::predict, &fr_strasbourg_entzheim::predict_batch, &fr_strasbourg_entzheim::predict_batch},
+    {"31069001", "TOULOUSE-BLAGNAC", fr_toulouse_blagnac::longitude_deg, 43.620998382568359, fr_toulouse_blagnac::delta_utc_solar_h, &fr_toulouse_blagnac::predict, &fr_toulouse_blagnac::predict_batch, &fr_toulouse_blagnac::predict_batch},
+    {"78621001", "TRAPPES", fr_trappes::longitude_deg, 48.774333953857422, fr_trappes::delta_utc_solar_h, &fr_trappes::predict, &fr_trappes::predict_batch, &fr_trappes::predict_batch},
+};
+inline constexpr std::size_t station_count = sizeof(stations) / sizeof(stations[0]);
+// Station with the given code, or nullptr. Usable in constant expressions:
+//   constexpr const StationEntry* bourges = find_station("18033001");
+constexpr const StationEntry* find_station(std::string_view code){
+    for (std::size_t i = 0; i < station_count; ++i) {
+        if (stations[i].code == code) return &stations[i];
+    }
+    return nullptr;
+}
+} // namespace harmoclimat
\ No newline at end of file
@@ -12,11 +12,16 @@ if str(SRC_ROOT) not in sys.path:
 
 from harmoclimate.display import DISPLAY_VARIABLE_CHOICES  # noqa: E402
 from harmoclimate.pipeline import (  # noqa: E402
+    bench_pipeline,
     clean_pipeline,
+    department_pipeline,
     display_pipeline,
     generate_pipeline,
+    pack_pipeline,
+    parity_pipeline,
     regenerate_pipeline,
     run_pipeline,
+    sweep_pipeline,
     template_pipeline,
 )
 
@@ -33,6 +38,36 @@ def build_parser() -> argparse.ArgumentParser:
         "station_code",
         help="Météo-France station code (NUM_POSTE) used to filter the source dataset.",
     )
+    generate_parser.add_argument(
+        "--archive",
+        action="append",
+        help="Local .csv.gz archive to read instead of the department URLs (repeatable).",
+    )
+
+    department_parser = subparsers.add_parser(
+        "department",
+        help="Read a department's archives once and generate model artefacts for each station.",
+    )
+    department_parser.add_argument(
+        "department_code",
+        help="Météo-France department code (e.g. 18) whose archives are read.",
+    )
+    department_parser.add_argument(
+        "--station",
+        action="append",
+        help="Station code (NUM_POSTE) to generate, repeatable. Defaults to every station in the archives.",
+    )
+    department_parser.add_argument(
+        "--archive",
+        action="append",
+        help="Local .csv.gz archive to read instead of the department URLs (repeatable).",
+    )
+    department_parser.add_argument(
+        "--min-rows",
+        type=int,
+        default=8760,
+        help="Skip stations with fewer kept hourly rows (default: 8760, one year).",
+    )
 
     regenerate_parser = subparsers.add_parser(
         "regenerate",
@@ -85,6 +120,145 @@ def build_parser() -> argparse.ArgumentParser:
         "language",
         help="Target template language (currently only 'cpp').",
     )
+    template_parser.add_argument(
+        "--numeric",
+        choices=("double", "float", "q15", "q31"),
+        default="double",
+        help=(
+            "Arithmetic of the generated header. 'float', 'q15' and 'q31' write a freestanding "
+            "microcontroller variant (no <cmath>) under generated/templates/embedded."
+        ),
+    )
+    template_parser.add_argument(
+        "--embedded-dir",
+        help="Directory of the freestanding variants (defaults to generated/templates/embedded).",
+    )
+    template_parser.add_argument(
+        "--psychrometrics",
+        action="store_true",
+        help="Also write harmoclimat_psychrometrics.hpp next to the double headers (needs wsp2p).",
+    )
+
+    pack_parser = subparsers.add_parser(
+        "pack",
+        help="Bundle every station model under generated/models into a binary model pack.",
+    )
+    pack_parser.add_argument(
+        "--output",
+        help="Destination file (defaults to generated/models/harmoclimate_models.hcpack).",
+    )
+
+    sweep_parser = subparsers.add_parser(
+        "sweep",
+        help="LOYO sweep of harmonic orders and ridge lambdas on a cached station dataset (JSON report).",
+    )
+    sweep_parser.add_argument(
+        "model_name",
+        help="Model basename or JSON file whose cached dataset is used (e.g. fr_bourges).",
+    )
+    sweep_parser.add_argument(
+        "--target",
+        nargs="+",
+        choices=("T", "Q", "P"),
+        default=["T", "Q", "P"],
+        help="Targets to sweep (default: T Q P).",
+    )
+    sweep_parser.add_argument(
+        "--n-diurnal",
+        nargs="+",
+        type=int,
+        default=[1, 2, 3, 4],
+        help="Diurnal harmonic counts (default: 1 2 3 4).",
+    )
+    sweep_parser.add_argument(
+        "--mean-annual",
+        nargs="+",
+        type=int,
+        default=[1, 2, 3, 4, 5],
+        help="Annual harmonic counts of the daily mean c0 (default: 1 2 3 4 5).",
+    )
+    sweep_parser.add_argument(
+        "--diurnal-annual",
+        nargs="+",
+        type=int,
+        default=[0, 1, 2, 3],
+        help="Annual harmonic counts of every diurnal coefficient aₘ/bₘ (default: 0 1 2 3).",
+    )
+    sweep_parser.add_argument(
+        "--lambda",
+        dest="ridge_lambdas",
+        nargs="+",
+        type=float,
+        default=[0.0, 1.0, 100.0, 10000.0],
+        help="Ridge lambdas (default: 0 1 100 10000).",
+    )
+    sweep_parser.add_argument("--threads", type=int, help="Worker threads (defaults to the CPU count).")
+    sweep_parser.add_argument(
+        "--output",
+        help="Destination JSON (defaults to generated/bench/<model>_sweep.json).",
+    )
+
+    bench_parser = subparsers.add_parser(
+        "bench",
+        help="Compile and benchmark every C++ header under generated/templates (JSON report).",
+    )
+    bench_parser.add_argument(
+        "--flags",
+        action="append",
+        help=(
+            "Compiler flag set, repeatable (e.g. --flags '-O3 -march=native'). "
+            "Defaults to -O2, -O3, -O3 -march=native and -O3 -march=native -ffast-math."
+        ),
+    )
+    bench_parser.add_argument("--compiler", help="C++ compiler (defaults to $CXX, then c++).")
+    bench_parser.add_argument(
+        "--header",
+        action="append",
+        help="Restrict to a station header, repeatable (e.g. --header fr_bourges).",
+    )
+    bench_parser.add_argument(
+        "--min-seconds",
+        type=float,
+        default=0.25,
+        help="Minimum measuring time per benchmark case (default: 0.25).",
+    )
+    bench_parser.add_argument(
+        "--output",
+        help="Destination JSON (defaults to generated/bench/bench_templates.json).",
+    )
+
+    parity_parser = subparsers.add_parser(
+        "parity",
+        help="Check every C++ header under generated/templates against the Python model.",
+    )
+    parity_parser.add_argument(
+        "--steps-per-day",
+        type=int,
+        default=96,
+        help="Sub-hourly grid steps per solar day (default: 96).",
+    )
+    parity_parser.add_argument(
+        "--tolerance",
+        type=float,
+        default=1e-12,
+        help="Maximum error relative to each target's largest value (default: 1e-12).",
+    )
+    parity_parser.add_argument("--flags", help="Compiler flags (default: -O2).")
+    parity_parser.add_argument("--compiler", help="C++ compiler (defaults to $CXX, then c++).")
+    parity_parser.add_argument(
+        "--header",
+        action="append",
+        help="Restrict to a station header, repeatable (e.g. --header fr_bourges).",
+    )
+    parity_parser.add_argument(
+        "--psychrometrics",
+        action="store_true",
+        help="Also check predict_full(), generating harmoclimat_psychrometrics.hpp for the run if absent.",
+    )
+    parity_parser.add_argument(
+        "--output",
+        help="Destination JSON (defaults to generated/bench/parity.json).",
+    )
 
     subparsers.add_parser(
         "clean",
@@ -99,7 +273,15 @@ def main(argv: list[str] | None = None) -> int:
     args = parser.parse_args(argv)
 
     if args.command == "generate":
-        generate_pipeline(args.station_code)
+        generate_pipeline(args.station_code, archives=args.archive)
+        return 0
+    if args.command == "department":
+        department_pipeline(
+            args.department_code,
+            station_codes=args.station,
+            archives=args.archive,
+            min_rows=args.min_rows,
+        )
         return 0
     if args.command == "regenerate":
         regenerate_pipeline(args.model_json)
@@ -113,8 +295,49 @@ def main(argv: list[str] | None = None) -> int:
         )
         return 0
     if args.command == "template":
-        template_pipeline(args.model_name, args.language)
+        template_pipeline(
+            args.model_name,
+            args.language,
+            numeric=args.numeric,
+            embedded_dir=args.embedded_dir,
+            psychrometrics=args.psychrometrics,
+        )
+        return 0
+    if args.command == "pack":
+        pack_pipeline(args.output)
+        return 0
+    if args.command == "sweep":
+        sweep_pipeline(
+            args.model_name,
+            targets=args.target,
+            n_diurnal_values=args.n_diurnal,
+            mean_annual_values=args.mean_annual,
+            diurnal_annual_values=args.diurnal_annual,
+            ridge_lambdas=args.ridge_lambdas,
+            threads=args.threads,
+            output_path=args.output,
+        )
         return 0
+    if args.command == "bench":
+        bench_pipeline(
+            flag_sets=args.flags,
+            compiler=args.compiler,
+            output_path=args.output,
+            min_seconds=args.min_seconds,
+            headers=args.header,
+        )
+        return 0
+    if args.command == "parity":
+        passed = parity_pipeline(
+            steps_per_day=args.steps_per_day,
+            tolerance=args.tolerance,
+            compiler=args.compiler,
+            flags=args.flags,
+            output_path=args.output,
+            headers=args.header,
+            psychrometrics=args.psychrometrics,
+        )
+        return 0 if passed else 1
     if args.command == "clean":
         clean_pipeline()
         return 0
@@ -0,0 +1,123 @@
+"""Benchmark runner for the generated C++ station headers.
+
+Compiles ``cpp/bench/bench_templates.cpp`` once per station header and flag
+set, runs it, and merges the per-run JSON into one report so regenerated
+headers, emitter changes and compiler flags can be compared.
+"""
+
+from __future__ import annotations
+
+import json
+import os
+import platform
+import shlex
+import shutil
+import subprocess
+import tempfile
+from datetime import datetime, timezone
+from pathlib import Path
+from typing import Sequence
+
+from .config import BENCH_DIR, PROJECT_ROOT, TEMPLATE_DIR
+
+BENCH_SOURCE = PROJECT_ROOT / "cpp" / "bench" / "bench_templates.cpp"
+DEFAULT_FLAG_SETS = (
+    "-O2",
+    "-O3",
+    "-O3 -march=native",
+    "-O3 -march=native -ffast-math",
+)
+
+_STATION_HEADER_BANNER = "// Auto-generated linear harmonic climate model"
+
+
+def station_headers(template_dir: Path) -> list[Path]:
+    """Station headers in ``template_dir`` (the registry and companions are skipped)."""
+
+    headers: list[Path] = []
+    for path in sorted(template_dir.glob("*.hpp")):
+        with open(path, "r", encoding="utf-8") as handle:
+            if handle.readline().rstrip("\n") == _STATION_HEADER_BANNER:
+                headers.append(path)
+    return headers
+
+
+def resolve_compiler(compiler: str | None) -> str:
+    """Path of ``compiler``, else ``$CXX``, else ``c++``."""
+
+    candidate = compiler or os.environ.get("CXX") or "c++"
+    resolved = shutil.which(candidate)
+    if resolved is None:
+        raise FileNotFoundError(f"C++ compiler '{candidate}' not found; set CXX or pass --compiler.")
+    return resolved
+
+
+def run_template_benchmarks(
+    template_dir: Path = TEMPLATE_DIR,
+    flag_sets: Sequence[str] = DEFAULT_FLAG_SETS,
+    compiler: str | None = None,
+    min_seconds: float = 0.25,
+    headers: Sequence[str] | None = None,
+) -> dict[str, object]:
+    """Build and run the benchmark for every header x flag set and return the report."""
+
+    cxx = resolve_compiler(compiler)
+    selected = station_headers(template_dir)
+    if headers:
+        wanted = {Path(name).stem for name in headers}
+        selected = [path for path in selected if path.stem in wanted]
+    if not selected:
+        raise FileNotFoundError(f"No station headers found in {template_dir}.")
+
+    runs: list[dict[str, object]] = []
+    with tempfile.TemporaryDirectory(prefix="harmoclimat_bench_") as scratch:
+        for header in selected:
+            for flags in flag_sets:
+                binary = Path(scratch) / f"{header.stem}_{len(runs)}"
+                command = [
+                    cxx,
+                    "-std=c++20",
+                    *shlex.split(flags),
+                    f"-I{header.parent}",
+                    f'-DHARMOCLIMAT_BENCH_HEADER="{header.name}"',
+                    str(BENCH_SOURCE),
+                    "-o",
+                    str(binary),
+                ]
+                subprocess.run(command, check=True)
+                completed = subprocess.run(
+                    [str(binary), f"{min_seconds}"], check=True, capture_output=True, text=True
+                )
+                run = json.loads(completed.stdout)
+                run["flags"] = flags
+                runs.append(run)
+                print(f"[OK] Benchmarked {header.name} with '{flags}'")
+
+    return {
+        "generated_at_utc": datetime.now(timezone.utc).isoformat(timespec="seconds"),
+        "machine": platform.machine(),
+        "processor": platform.processor(),
+        "compiler_path": cxx,
+        "runs": runs,
+    }
+
+
+def write_benchmark_report(report: dict[str, object], output_path: Path | None = None) -> Path:
+    """Write ``report`` as JSON (default ``generated/bench/bench_templates.json``)."""
+
+    path = output_path or BENCH_DIR / "bench_templates.json"
+    path.parent.mkdir(parents=True, exist_ok=True)
+    with open(path, "w", encoding="utf-8") as handle:
+        json.dump(report, handle, indent=2)
+    print(f"[OK] Benchmark report written to {path}")
+    return path
+
+
+__all__ = [
+    "BENCH_SOURCE",
+    "DEFAULT_FLAG_SETS",
+    "resolve_compiler",
+    "run_template_benchmarks",
+    "station_headers",
+    "write_benchmark_report",
+]
@@ -47,9 +47,14 @@ class ArtifactPaths:
 PROJECT_ROOT = Path(__file__).resolve().parents[2]
 GENERATED_DIR = PROJECT_ROOT / "generated"
 DATA_DIR = GENERATED_DIR / "data"
+# Local copies of the department archives, used instead of the URLs when present.
+ARCHIVE_DIR = DATA_DIR / "archives"
 MODEL_DIR = GENERATED_DIR / "models"
 TEMPLATE_DIR = GENERATED_DIR / "templates"
 MEDIA_DIR = GENERATED_DIR / "media"
+BENCH_DIR = GENERATED_DIR / "bench"
+NATIVE_DIR = GENERATED_DIR / "native"
+MODEL_PACK_PATH = MODEL_DIR / "harmoclimate_models.hcpack"
 
 
 def build_artifact_paths(station_slug: str) -> ArtifactPaths:
@@ -106,7 +111,9 @@ SAMPLES_PER_DAY = 96
 
 __all__ = [
     "ArtifactPaths",
+    "ARCHIVE_DIR",
     "AUTHOR_NAME",
+    "BENCH_DIR",
     "ANNUAL_HARMONICS_PER_PARAM",
     "DEFAULT_ANNUAL_HARMONICS",
     "CHUNK_SIZE",
@@ -115,7 +122,9 @@ __all__ = [
     "GENERATED_DIR",
     "MEDIA_DIR",
     "MODEL_DIR",
+    "MODEL_PACK_PATH",
     "MODEL_VERSION",
+    "NATIVE_DIR",
     "PROJECT_ROOT",
     "SAMPLES_PER_DAY",
     "STATION_CODE",
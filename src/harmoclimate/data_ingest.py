@@ -1,11 +1,24 @@
-"""Data ingestion utilities for HarmoClimate."""
+"""Data ingestion utilities for HarmoClimate.
+
+Archives available as local files (paths, ``file://`` URLs, or copies of the
+remote archives under ``generated/data/archives/``) are filtered by the native
+ingester in ``cpp/native/ingest.cpp`` when the native helpers can be built.
+Remote archives are streamed through pandas. Both paths can keep several
+stations in one pass over a department's archives
+(:func:`stream_stations_to_disk`).
+"""
 
 from __future__ import annotations
 
-from dataclasses import dataclass
+import ctypes
+from dataclasses import dataclass, field
+from datetime import datetime, timezone
+from functools import lru_cache
 from pathlib import Path
-from typing import Iterable, List, Tuple
+from typing import Dict, Iterable, List, Sequence, Tuple
+from zoneinfo import ZoneInfo
 
+import numpy as np
 import pandas as pd
 
 try:
@@ -14,9 +27,12 @@ try:
 except ImportError as exc:  # pragma: no cover - execution stops before tests
     raise ImportError("pyarrow is required for HarmoClimate data ingestion.") from exc
 
-from .config import CHUNK_SIZE, STATION_CODE, build_artifact_paths, slugify_station_name
+from . import native
+from .config import ARCHIVE_DIR, CHUNK_SIZE, STATION_CODE, build_artifact_paths, slugify_station_name
 from .core import DATASET_COLUMNS
 
+SOURCE_TIME_ZONE = "Europe/Paris"
+
 
 @dataclass
 class StationRecord:
@@ -65,7 +81,7 @@ def parse_dt_aaaammjjhh(series: pd.Series) -> pd.Series:
     """Parse AAAAMMJJHH timestamps expressed in local French time."""
 
     s = series.astype("string").str.strip()
-    s = s.str.replace(r"\\.0$", "", regex=True)
+    s = s.str.replace(r"\.0$", "", regex=True)
     s = s.str.pad(10, side="right", fillchar="0")
     s = s.str.slice(0, 10)
     return pd.to_datetime(s, format="%Y%m%d%H", errors="coerce")
@@ -83,22 +99,340 @@ def _normalize_station_code(value: object) -> str:
     return code
 
 
-def stream_filter_to_disk(
-    urls: Iterable[str],
+@lru_cache(maxsize=None)
+def dst_transition_table(
+    zone_name: str = SOURCE_TIME_ZONE,
+    first_year: int = 1900,
+    last_year: int = 2100,
+) -> Tuple[np.ndarray, np.ndarray]:
+    """UTC offset transitions of ``zone_name`` from the tz database.
+
+    Returns ``(transitions, offsets)``: transition instants in UTC seconds and
+    the offset in seconds in force before each of them, plus the final offset.
+    Days are scanned for offset changes, then each change is bisected to the
+    second.
+    """
+
+    zone = ZoneInfo(zone_name)
+
+    def offset_at(instant: int) -> int:
+        return int(datetime.fromtimestamp(instant, zone).utcoffset().total_seconds())
+
+    day = 86_400
+    start = int(datetime(first_year, 1, 1, tzinfo=timezone.utc).timestamp())
+    stop = int(datetime(last_year + 1, 1, 1, tzinfo=timezone.utc).timestamp())
+    transitions: List[int] = []
+    offsets = [offset_at(start)]
+    for instant in range(start + day, stop + 1, day):
+        current = offset_at(instant)
+        if current == offsets[-1]:
+            continue
+        low, high = instant - day, instant
+        while high - low > 1:
+            middle = (low + high) // 2
+            if offset_at(middle) == offsets[-1]:
+                low = middle
+            else:
+                high = middle
+        transitions.append(high)
+        offsets.append(current)
+    return np.array(transitions, dtype=np.int64), np.array(offsets, dtype=np.int32)
+
+
+def _local_archive(source: str | Path) -> Path | None:
+    """Local file for ``source``, or ``None`` when it must be downloaded."""
+
+    if isinstance(source, Path):
+        return source
+    text = str(source)
+    if text.startswith("file://"):
+        return Path(text[len("file://") :])
+    if "://" in text:
+        cached = ARCHIVE_DIR / text.rsplit("/", 1)[-1]
+        return cached if cached.is_file() else None
+    return Path(text)
+
+
+def ingest_station_archives(
+    paths: Sequence[str | Path],
+    station_codes: Sequence[str] | None = None,
+    *,
+    threads: int | None = None,
+) -> Dict[str, Tuple[pd.DataFrame, str]] | None:
+    """Filter local archives for several stations in one native pass.
+
+    Every line is routed to its station through a hash map on ``NUM_POSTE``,
+    so each archive is decompressed and parsed once whatever the number of
+    stations. Returns ``{station_code: (rows, first_name)}`` for the requested
+    codes (every station found when ``station_codes`` is ``None``), with the
+    ``DATASET_COLUMNS`` columns and dtypes of :func:`stream_filter_to_disk`,
+    or ``None`` when the native helpers are unavailable.
+    """
+
+    library = native.load_library()
+    if library is None:
+        return None
+
+    codes = [_normalize_station_code(code) for code in station_codes or ()]
+    transitions, offsets = dst_transition_table()
+    encoded_paths = [str(path).encode() for path in paths]
+    encoded_codes = [code.encode() for code in codes]
+    handle = library.hc_ingest_archives(
+        (ctypes.c_char_p * len(encoded_paths))(*encoded_paths),
+        len(encoded_paths),
+        (ctypes.c_char_p * len(encoded_codes))(*encoded_codes),
+        len(encoded_codes),
+        transitions.ctypes.data_as(ctypes.POINTER(ctypes.c_int64)),
+        offsets.ctypes.data_as(ctypes.POINTER(ctypes.c_int32)),
+        transitions.size,
+        0 if threads is None else int(threads),
+    )
+    if not handle:
+        native.check(-1)
+
+    def pointer(array: np.ndarray, ctype) -> object:
+        return array.ctypes.data_as(ctypes.POINTER(ctype))
+
+    stations: Dict[str, Tuple[pd.DataFrame, str]] = {}
+    try:
+        for station in range(library.hc_ingest_station_count(handle)):
+            code = library.hc_ingest_station_code(handle, station).decode("utf-8", "replace")
+            rows = library.hc_ingest_rows(handle, station)
+            utc_seconds = np.empty(rows, dtype=np.int64)
+            values = {name: np.empty(rows, dtype=np.float32) for name in ("T", "RH", "P", "LON", "LAT", "ALTI")}
+            name_index = np.empty(rows, dtype=np.uint32)
+            library.hc_ingest_columns(
+                handle,
+                station,
+                pointer(utc_seconds, ctypes.c_int64),
+                *(pointer(values[name], ctypes.c_float) for name in ("T", "RH", "P", "LON", "LAT", "ALTI")),
+                pointer(name_index, ctypes.c_uint32),
+            )
+            names = [
+                library.hc_ingest_name(handle, station, index).decode("utf-8", "replace")
+                for index in range(library.hc_ingest_name_count(handle, station))
+            ]
+            first_name = library.hc_ingest_first_name(handle, station).decode("utf-8", "replace")
+            name_codes = name_index.astype(np.int64)
+            if "" in names:
+                # Blank names are trimmed to "" here and are <NA> in _clean_rows.
+                empty = names.index("")
+                name_codes = np.where(name_codes == empty, -1, name_codes - (name_codes > empty))
+                names.pop(empty)
+
+            frame = pd.DataFrame(
+                {
+                    "STATION_CODE": pd.array([code] * rows, dtype="string"),
+                    "STATION_NAME": pd.Categorical.from_codes(name_codes, categories=names).astype("string"),
+                    "DT_UTC": pd.to_datetime(utc_seconds, unit="s", utc=True).as_unit("ns"),
+                    **values,
+                }
+            )
+            stations[code] = (frame[list(DATASET_COLUMNS)], first_name)
+    finally:
+        library.hc_ingest_free(handle)
+    return stations
+
+
+def ingest_local_archives(
+    paths: Sequence[str | Path],
     station_code: str = STATION_CODE,
-    chunk_size: int = CHUNK_SIZE,
-) -> StreamResult:
-    """Stream Meteo-France archives, filter rows, and persist the reduced dataset."""
+    *,
+    threads: int | None = None,
+) -> Tuple[pd.DataFrame, str] | None:
+    """Filter local archives for one station with the native ingester.
+
+    Returns the kept rows with the ``DATASET_COLUMNS`` columns and dtypes of
+    :func:`stream_filter_to_disk`, plus the first non-empty station name, or
+    ``None`` when the native helpers are unavailable.
+    """
 
     station_code_str = _normalize_station_code(station_code)
+    stations = ingest_station_archives(paths, [station_code_str], threads=threads)
+    return None if stations is None else stations[station_code_str]
+
+
+def _station_records(frame: pd.DataFrame) -> List[StationRecord]:
+    """One :class:`StationRecord` per kept row."""
+
+    codes = frame["STATION_CODE"].fillna("").tolist()
+    names = frame["STATION_NAME"].fillna("").tolist()
+    lons = frame["LON"].to_numpy(dtype=float).tolist()
+    lats = frame["LAT"].to_numpy(dtype=float).tolist()
+    altis = frame["ALTI"].to_numpy(dtype=float).tolist()
+    return [
+        StationRecord(
+            station_code=_normalize_station_code(code) or None,
+            station_name=str(name),
+            lon=lon,
+            lat=lat,
+            alti=alti,
+            delta_utc_solar_h=lon / 15.0,
+        )
+        for code, name, lon, lat, alti in zip(codes, names, lons, lats, altis)
+    ]
+
+
+def _write_station_dataset(frame: pd.DataFrame, first_name: str, station_code_str: str) -> StreamResult:
+    station_name = first_name or station_code_str
+    station_slug = slugify_station_name(station_name) or slugify_station_name(station_code_str)
+    parquet_path = build_artifact_paths(station_slug).parquet
+    parquet_path.parent.mkdir(parents=True, exist_ok=True)
+    pq.write_table(pa.Table.from_pandas(frame, preserve_index=False), str(parquet_path))
+
+    print(f"[OK] Wrote {len(frame):,} filtered rows -> {parquet_path}")
+    return StreamResult(
+        station_records=_station_records(frame),
+        parquet_path=parquet_path,
+        station_name=station_name,
+        station_slug=station_slug,
+    )
+
+
+def _clean_rows(chunk: pd.DataFrame, mask: pd.Series, code_series: pd.Series) -> pd.DataFrame:
+    """Parse, clean and localize the rows of ``chunk`` selected by ``mask``."""
+
+    (
+        col_code,
+        col_station,
+        col_dt,
+        col_T,
+        col_U,
+        col_lon,
+        col_lat,
+        col_alti,
+        col_p,
+    ) = choose_columns(list(chunk.columns))
+
+    keep_cols = [col_dt, col_T, col_U, col_lon, col_station, col_lat, col_code, col_alti, col_p]
+    sub = chunk.loc[mask, keep_cols].copy()
+
+    sub["dt_local"] = parse_dt_aaaammjjhh(sub[col_dt])
+    sub["T"] = pd.to_numeric(sub[col_T], errors="coerce")
+    sub["RH"] = pd.to_numeric(sub[col_U], errors="coerce")
+    sub["LON"] = pd.to_numeric(sub[col_lon], errors="coerce")
+    sub["LAT"] = pd.to_numeric(sub[col_lat], errors="coerce")
+    sub["ALTI"] = pd.to_numeric(sub[col_alti], errors="coerce")
+    sub["P"] = pd.to_numeric(sub[col_p], errors="coerce")
+    sub["STATION_CODE"] = code_series[mask].to_numpy()
+    sub["STATION_NAME"] = _station_names(sub[col_station])
+
+    sub = sub.dropna(subset=["dt_local", "T", "RH", "LON", "LAT", "ALTI", "P"])
+
+    sub["dt_local"] = sub["dt_local"].dt.tz_localize(
+        SOURCE_TIME_ZONE,
+        nonexistent="shift_forward",
+        ambiguous="NaT",
+    )
+    sub = sub.dropna(subset=["dt_local"])
+    sub["DT_UTC"] = sub["dt_local"].dt.tz_convert("UTC")
+    sub["T"] = sub["T"].astype("float32")
+    sub["RH"] = sub["RH"].clip(0, 100).astype("float32")
+    sub["P"] = sub["P"].astype("float32")
+    sub["LON"] = sub["LON"].astype("float32")
+    sub["LAT"] = sub["LAT"].astype("float32")
+    sub["ALTI"] = sub["ALTI"].astype("float32")
+    sub["STATION_CODE"] = sub["STATION_CODE"].astype("string")
+    sub["STATION_NAME"] = sub["STATION_NAME"].astype("string")
+
+    return sub[list(DATASET_COLUMNS)]
+
+
+def _station_names(values: pd.Series) -> pd.Series:
+    """NOM_USUEL trimmed as the native ingester does, blank names as <NA>."""
+
+    names = values.astype("string").str.strip(" \t")
+    return names.mask(names == "")
+
 
+def _chunk_codes(chunk: pd.DataFrame) -> pd.Series:
+    col_code = choose_columns(list(chunk.columns))[0]
+    return chunk[col_code].astype("string").str.strip().str.replace(r"\.0$", "", regex=True)
+
+
+@dataclass
+class _StationWriter:
+    """Parquet output of one station while the pandas path streams."""
+
+    station_code: str
+    station_name: str
+    station_slug: str
+    parquet_path: Path
+    named: bool
     writer: pq.ParquetWriter | None = None
-    parquet_path: Path | None = None
-    station_name: str | None = None
-    station_slug: str | None = None
+    writer_path: Path | None = None
+    station_records: List[StationRecord] = field(default_factory=list)
+
+    @classmethod
+    def open(cls, candidate_name: str, station_code_str: str) -> "_StationWriter":
+        writer = cls(station_code_str, "", "", Path(), named=False)
+        writer.rename(candidate_name)
+        return writer
+
+    def rename(self, candidate_name: str) -> None:
+        """Take the first non-empty name, as the native path does; the code stands in until then."""
+
+        if self.named:
+            return
+        self.named = bool(candidate_name)
+        self.station_name = candidate_name or self.station_code
+        self.station_slug = slugify_station_name(self.station_name) or slugify_station_name(self.station_code)
+        self.parquet_path = build_artifact_paths(self.station_slug).parquet
+        self.parquet_path.parent.mkdir(parents=True, exist_ok=True)
+        self.parquet_path.unlink(missing_ok=True)
+
+    def write(self, rows: pd.DataFrame) -> None:
+        self.station_records.extend(_station_records(rows))
+        table = pa.Table.from_pandas(rows, preserve_index=False)
+        if self.writer is None:
+            self.writer_path = self.parquet_path
+            self.writer = pq.ParquetWriter(str(self.writer_path), table.schema)
+        self.writer.write_table(table)
+
+    def close(self) -> StreamResult:
+        if self.writer is not None:
+            self.writer.close()
+            if self.writer_path != self.parquet_path:
+                self.writer_path.replace(self.parquet_path)
+        print(f"[OK] Wrote {len(self.station_records):,} filtered rows -> {self.parquet_path}")
+        return StreamResult(
+            station_records=self.station_records,
+            parquet_path=self.parquet_path,
+            station_name=self.station_name,
+            station_slug=self.station_slug,
+        )
 
+
+def stream_stations_to_disk(
+    urls: Iterable[str],
+    station_codes: Sequence[str] | None = None,
+    chunk_size: int = CHUNK_SIZE,
+) -> Dict[str, StreamResult]:
+    """Read each archive once and persist one dataset per station.
+
+    Rows are routed to the requested ``station_codes`` (every station found
+    when ``None``). Returns the :class:`StreamResult` of each station that
+    appears in the archives, keyed by normalized station code.
+    """
+
+    codes = [_normalize_station_code(code) for code in station_codes] if station_codes else None
+
+    urls = list(urls)
+    local_paths = [_local_archive(url) for url in urls]
+    if urls and all(path is not None for path in local_paths) and native.load_library() is not None:
+        for path in local_paths:
+            print(f"[Stream] {path} (native)")
+        stations = ingest_station_archives(local_paths, codes)
+        if stations is not None:
+            return {
+                code: _write_station_dataset(frame, first_name, code)
+                for code, (frame, first_name) in stations.items()
+                if not (frame.empty and not first_name)
+            }
+
+    wanted = set(codes) if codes is not None else None
+    writers: Dict[str, _StationWriter] = {}
     total_kept = 0
-    station_records: List[StationRecord] = []
 
     for url in urls:
         print(f"[Stream] {url}")
@@ -111,117 +445,56 @@ def stream_filter_to_disk(
             low_memory=True,
         )
         for i, chunk in enumerate(reader, 1):
-            (
-                col_code,
-                col_station,
-                col_dt,
-                col_T,
-                col_U,
-                col_lon,
-                col_lat,
-                col_alti,
-                col_p,
-            ) = choose_columns(list(chunk.columns))
-
-            code_series = chunk[col_code].astype("string").str.strip().str.replace(r"\\.0$", "", regex=True)
-            mask = code_series == station_code_str
+            code_series = _chunk_codes(chunk)
+            if wanted is not None:
+                mask = code_series.isin(wanted)
+            else:
+                mask = code_series.fillna("") != ""
             if not mask.any():
                 continue
 
-            keep_cols = [col_dt, col_T, col_U, col_lon, col_station, col_lat, col_code, col_alti, col_p]
-            sub = chunk.loc[mask, keep_cols].copy()
-            if sub.empty:
-                continue
-
-            if station_name is None:
-                names = sub[col_station].astype("string").str.strip()
-                candidate = next((name for name in names if name), "")
-                fallback_name = station_code_str if not candidate else candidate
-                station_name = candidate or fallback_name
-                station_slug = slugify_station_name(station_name) or slugify_station_name(fallback_name)
-                parquet_path = build_artifact_paths(station_slug).parquet
-                parquet_path.parent.mkdir(parents=True, exist_ok=True)
-                parquet_path.unlink(missing_ok=True)
-
-            sub["dt_local"] = parse_dt_aaaammjjhh(sub[col_dt])
-            sub["T"] = pd.to_numeric(sub[col_T], errors="coerce")
-            sub["RH"] = pd.to_numeric(sub[col_U], errors="coerce")
-            sub["LON"] = pd.to_numeric(sub[col_lon], errors="coerce")
-            sub["LAT"] = pd.to_numeric(sub[col_lat], errors="coerce")
-            sub["ALTI"] = pd.to_numeric(sub[col_alti], errors="coerce")
-            sub["P"] = pd.to_numeric(sub[col_p], errors="coerce")
-            sub["STATION_CODE"] = code_series[mask].to_numpy()
-            sub["STATION_NAME"] = sub[col_station].astype("string").str.strip()
-
-            sub = sub.dropna(subset=["dt_local", "T", "RH", "LON", "LAT", "ALTI", "P"])
-
-            sub["dt_local"] = sub["dt_local"].dt.tz_localize(
-                "Europe/Paris",
-                nonexistent="shift_forward",
-                ambiguous="NaT",
-            )
-            sub = sub.dropna(subset=["dt_local"])
-            sub["DT_UTC"] = sub["dt_local"].dt.tz_convert("UTC")
-            sub["T"] = sub["T"].astype("float32")
-            sub["RH"] = sub["RH"].clip(0, 100).astype("float32")
-            sub["P"] = sub["P"].astype("float32")
-            sub["LON"] = sub["LON"].astype("float32")
-            sub["LAT"] = sub["LAT"].astype("float32")
-            sub["ALTI"] = sub["ALTI"].astype("float32")
-            sub["STATION_CODE"] = sub["STATION_CODE"].astype("string")
-            sub["STATION_NAME"] = sub["STATION_NAME"].astype("string")
-
-            for _, row in sub.iterrows():
-                lon_value = float(row["LON"])
-                name_value = row["STATION_NAME"]
-                if pd.isna(name_value):
-                    name_str = ""
+            kept_codes = code_series[mask]
+            names = _station_names(chunk.loc[mask, choose_columns(list(chunk.columns))[1]]).fillna("")
+            for code in kept_codes.unique():
+                candidate = next((name for name in names[kept_codes == code] if name), "")
+                if code not in writers:
+                    writers[code] = _StationWriter.open(candidate, code)
                 else:
-                    name_str = str(name_value)
-                station_code_value = _normalize_station_code(row["STATION_CODE"])
-                station_records.append(
-                    StationRecord(
-                        station_code=station_code_value or None,
-                        station_name=name_str,
-                        lon=lon_value,
-                        lat=float(row["LAT"]),
-                        alti=float(row["ALTI"]),
-                        delta_utc_solar_h=lon_value / 15.0,
-                    )
-                )
-
-            sub = sub[list(DATASET_COLUMNS)]
-
-            table = pa.Table.from_pandas(sub, preserve_index=False)
-            if parquet_path is None or station_slug is None:
-                raise RuntimeError("Parquet output path was not initialised.")
-            if writer is None:
-                writer = pq.ParquetWriter(str(parquet_path), table.schema)
-            writer.write_table(table)
+                    writers[code].rename(candidate)
+
+            sub = _clean_rows(chunk, mask, code_series)
+            for code, rows in sub.groupby("STATION_CODE", sort=False):
+                writers[str(code)].write(rows)
 
             total_kept += len(sub)
             if i % 50 == 0:
-                print(f"  chunks: {i:4d} | kept rows: {total_kept:,}")
+                print(f"  chunks: {i:4d} | kept rows: {total_kept:,} | stations: {len(writers)}")
 
-    if writer is not None:
-        writer.close()
+    return {code: writer.close() for code, writer in writers.items()}
 
-    if parquet_path is None or station_name is None or station_slug is None:
-        raise RuntimeError(f"No data found for station code {station_code_str}")
 
-    print(f"[OK] Wrote {total_kept:,} filtered rows -> {parquet_path}")
-    return StreamResult(
-        station_records=station_records,
-        parquet_path=parquet_path,
-        station_name=station_name,
-        station_slug=station_slug,
-    )
+def stream_filter_to_disk(
+    urls: Iterable[str],
+    station_code: str = STATION_CODE,
+    chunk_size: int = CHUNK_SIZE,
+) -> StreamResult:
+    """Stream Meteo-France archives, filter rows, and persist the reduced dataset."""
+
+    station_code_str = _normalize_station_code(station_code)
+    results = stream_stations_to_disk(urls, [station_code_str], chunk_size=chunk_size)
+    if station_code_str not in results:
+        raise RuntimeError(f"No data found for station code {station_code_str}")
+    return results[station_code_str]
 
 
 __all__ = [
     "StationRecord",
     "StreamResult",
     "choose_columns",
+    "dst_transition_table",
+    "ingest_local_archives",
+    "ingest_station_archives",
     "parse_dt_aaaammjjhh",
     "stream_filter_to_disk",
+    "stream_stations_to_disk",
 ]
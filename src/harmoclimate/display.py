@@ -14,6 +14,7 @@ from matplotlib.figure import Figure
 
 from .config import SAMPLES_PER_DAY
 from .core import SOLAR_YEAR_DAYS, load_parquet_dataset, prepare_dataset
+from .evaluator import ModelEvaluator, available as native_evaluator_available, diurnal_extremes_batch
 from .psychrometrics import (
     dew_point_c_from_e,
     relative_humidity_percent_from_specific,
@@ -154,6 +155,91 @@ def predict_model_solar(model_payload: dict, day_solar: float, hour_solar: float
     return result
 
 
+def diurnal_coefficients(model_payload: dict, day_solar: float) -> np.ndarray:
+    """Return the diurnal coefficients ``[c0, a1, b1, ...]`` of one solar day.
+
+    The day is floored like :func:`predict_model_solar`; absent terms are zero.
+    """
+
+    mapping = _parameter_map(model_payload)
+    if "c0" not in mapping:
+        raise ValueError("Model payload does not include mandatory parameter 'c0'.")
+
+    day = math.floor(_wrap_day(day_solar))
+    max_day_index = int(math.floor(SOLAR_YEAR_DAYS))
+    if day > max_day_index:
+        day = max_day_index
+
+    n_diurnal = int(model_payload["model"].get("n_diurnal", 0))
+    coefficients = np.zeros(2 * n_diurnal + 1, dtype=np.float64)
+    coefficients[0] = _eval_annual(*mapping["c0"], day)
+    for m in range(1, n_diurnal + 1):
+        if f"a{m}" in mapping:
+            coefficients[2 * m - 1] = _eval_annual(*mapping[f"a{m}"], day)
+        if f"b{m}" in mapping:
+            coefficients[2 * m] = _eval_annual(*mapping[f"b{m}"], day)
+    return coefficients
+
+
+def diurnal_series(coefficients: np.ndarray, hours_solar: np.ndarray) -> np.ndarray:
+    """Evaluate ``c0 + sum(a_m cos(m w h) + b_m sin(m w h))`` at solar hours."""
+
+    angle = (2.0 * math.pi / 24.0) * np.asarray(hours_solar, dtype=np.float64)
+    values = np.full(angle.shape, coefficients[0], dtype=np.float64)
+    for m in range(1, (len(coefficients) - 1) // 2 + 1):
+        values += coefficients[2 * m - 1] * np.cos(m * angle) + coefficients[2 * m] * np.sin(m * angle)
+    return values
+
+
+def _diurnal_grid(rows: np.ndarray, hours_solar: np.ndarray) -> np.ndarray:
+    """:func:`diurnal_series` of every coefficient row at the same hours (rows x hours)."""
+
+    angle = (2.0 * math.pi / 24.0) * np.asarray(hours_solar, dtype=np.float64)
+    basis = np.empty((rows.shape[1], angle.shape[0]), dtype=np.float64)
+    basis[0] = 1.0
+    for m in range(1, (rows.shape[1] - 1) // 2 + 1):
+        basis[2 * m - 1] = np.cos(m * angle)
+        basis[2 * m] = np.sin(m * angle)
+    return rows @ basis
+
+
+def diurnal_extremes(coefficients: np.ndarray) -> Tuple[float, float, float, float, float]:
+    """Return the exact ``(mean, min, max, hour_of_min, hour_of_max)`` of one solar day.
+
+    The mean is the constant term. With ``z = exp(i w h)`` the derivative is a
+    degree-2N polynomial in ``z`` whose unit-circle roots are the critical
+    points; every root angle is kept as a candidate, so near-double roots that
+    drift off the circle cannot be missed. Hours are solar, like the inputs of
+    :func:`predict_model_solar`. The generated C++ header's
+    ``DayProfile::stats()`` returns the same extrema by another route
+    (Lipschitz bracketing of the derivative and safeguarded Newton steps
+    instead of polynomial roots); the two are equivalent up to rounding.
+    """
+
+    n = (len(coefficients) - 1) // 2
+    derivative = np.zeros(2 * n + 1, dtype=np.complex128)
+    for m in range(1, n + 1):
+        a, b = coefficients[2 * m - 1], coefficients[2 * m]
+        derivative[n + m] = 0.5 * m * (b + 1j * a)
+        derivative[n - m] = 0.5 * m * (b - 1j * a)
+
+    candidates = [0.0]
+    if np.any(derivative):
+        roots = np.roots(derivative[::-1])
+        candidates.extend(np.mod(np.angle(roots), 2.0 * math.pi) * (24.0 / (2.0 * math.pi)))
+    hours = np.mod(np.asarray(candidates, dtype=np.float64), 24.0)
+    values = diurnal_series(coefficients, hours)
+    i_min = int(np.argmin(values))
+    i_max = int(np.argmax(values))
+    return (
+        float(coefficients[0]),
+        float(values[i_min]),
+        float(values[i_max]),
+        float(hours[i_min]),
+        float(hours[i_max]),
+    )
+
+
 def climate_predict_solar(
     day_solar: float,
     hour_solar: float,
@@ -199,10 +285,48 @@ def model_daily_stats_one_year_factorized(
     np.ndarray,
     np.ndarray,
 ]:
-    """Compute model-driven daily envelopes for one full year."""
+    """Compute model-driven daily envelopes for one full year.
+
+    Temperature, specific humidity and pressure envelopes are exact (see
+    :func:`diurnal_extremes`); RH, dew point and vapour pressure are sampled at
+    ``samples_per_day`` solar hours. With the native helpers the whole year is
+    evaluated at once (see :mod:`harmoclimate.evaluator`); otherwise day by day.
+    """
 
     hours = np.linspace(0.0, 24.0, samples_per_day, endpoint=False)
     days = np.arange(1, n_days + 1, dtype=int)
+    models = (temperature_model, specific_humidity_model, pressure_model)
+
+    if native_evaluator_available():
+        rows = [ModelEvaluator.from_payload(model).diurnal_coefficients(days) for model in models]
+        T_grid, Q_grid, P_grid = (_diurnal_grid(r, hours) for r in rows)
+        RH_grid = relative_humidity_percent_from_specific(T_grid, Q_grid, P_grid)
+        E_grid = vapor_partial_pressure_hpa_from_q_p(Q_grid, P_grid)
+        Td_grid = dew_point_c_from_e(E_grid)
+        (Tavg, Tmin, Tmax), (Qavg, Qmin, Qmax), (Pavg, Pmin, Pmax) = (
+            diurnal_extremes_batch(r)[:, :3].T.copy() for r in rows
+        )
+        return (
+            days,
+            Tmin,
+            Tmax,
+            Tavg,
+            RH_grid.min(axis=1),
+            RH_grid.max(axis=1),
+            RH_grid.mean(axis=1),
+            Td_grid.min(axis=1),
+            Td_grid.max(axis=1),
+            Td_grid.mean(axis=1),
+            Qmin,
+            Qmax,
+            Qavg,
+            E_grid.min(axis=1),
+            E_grid.max(axis=1),
+            E_grid.mean(axis=1),
+            Pmin,
+            Pmax,
+            Pavg,
+        )
 
     Tmin = np.empty(n_days)
     Tmax = np.empty(n_days)
@@ -224,45 +348,25 @@ def model_daily_stats_one_year_factorized(
     Pavg = np.empty(n_days)
 
     for idx, d in enumerate(days):
-        temps: list[float] = []
-        q_vals: list[float] = []
-        pressures: list[float] = []
-        for h in hours:
-            temp_c, q, p_hpa = climate_predict_solar(
-                float(d),
-                float(h),
-                temperature_model,
-                specific_humidity_model,
-                pressure_model,
-            )
-            temps.append(temp_c)
-            q_vals.append(q)
-            pressures.append(p_hpa)
-        T_array = np.asarray(temps)
-        Q_array = np.asarray(q_vals)
-        P_array = np.asarray(pressures)
+        coefficients = [diurnal_coefficients(model, float(d)) for model in models]
+        T_array, Q_array, P_array = (diurnal_series(c, hours) for c in coefficients)
         RH_array = relative_humidity_percent_from_specific(T_array, Q_array, P_array)
         E_array = vapor_partial_pressure_hpa_from_q_p(Q_array, P_array)
         Td_array = dew_point_c_from_e(E_array)
 
-        Tmin[idx] = float(T_array.min())
-        Tmax[idx] = float(T_array.max())
-        Tavg[idx] = float(T_array.mean())
+        # T, Q and P are exact; the derived variables are nonlinear and stay sampled.
+        Tavg[idx], Tmin[idx], Tmax[idx], _, _ = diurnal_extremes(coefficients[0])
+        Qavg[idx], Qmin[idx], Qmax[idx], _, _ = diurnal_extremes(coefficients[1])
+        Pavg[idx], Pmin[idx], Pmax[idx], _, _ = diurnal_extremes(coefficients[2])
         RHmin[idx] = float(RH_array.min())
         RHmax[idx] = float(RH_array.max())
         RHavg[idx] = float(RH_array.mean())
         Tdmin[idx] = float(Td_array.min())
         Tdmax[idx] = float(Td_array.max())
         Tdavg[idx] = float(Td_array.mean())
-        Qmin[idx] = float(Q_array.min())
-        Qmax[idx] = float(Q_array.max())
-        Qavg[idx] = float(Q_array.mean())
         Emin[idx] = float(E_array.min())
         Emax[idx] = float(E_array.max())
         Eavg[idx] = float(E_array.mean())
-        Pmin[idx] = float(P_array.min())
-        Pmax[idx] = float(P_array.max())
-        Pavg[idx] = float(P_array.mean())
 
     return (
         days,
@@ -547,6 +651,18 @@ def model_intraday_solar(
     samples_per_day: int = SAMPLES_PER_DAY,
 ):
     hours = np.linspace(0.0, 24.0, samples_per_day, endpoint=False)
+    if native_evaluator_available():
+        # Same day convention as predict_model_solar: floored, wrapped solar day.
+        day = min(math.floor(_wrap_day(float(day_solar))), int(math.floor(SOLAR_YEAR_DAYS)))
+        temps_arr, qs_arr, ps_arr = (
+            ModelEvaluator.from_payload(model).predict(float(day), hours)
+            for model in (temperature_model, specific_humidity_model, pressure_model)
+        )
+        e_arr = vapor_partial_pressure_hpa_from_q_p(qs_arr, ps_arr)
+        td_arr = dew_point_c_from_e(e_arr)
+        rh_arr = relative_humidity_percent_from_specific(temps_arr, qs_arr, ps_arr)
+        return hours, temps_arr, qs_arr, ps_arr, rh_arr, td_arr, e_arr
+
     temps, qs, ps = [], [], []
     for h in hours:
         temp_c, q, p = climate_predict_solar(
@@ -702,6 +818,9 @@ __all__ = [
     "DISPLAY_VARIABLE_CHOICES",
     "DISPLAY_VARIABLE_DEFAULT",
     "climate_predict_solar",
+    "diurnal_coefficients",
+    "diurnal_extremes",
+    "diurnal_series",
     "historical_climatology_daily",
     "history_intraday_mean",
     "load_linear_model",
@@ -3,26 +3,178 @@
 Leave-one-year-out (LOYO) validation now evaluates on a no-leap UTC grid while
 models remain trained on the solar feature space. The climatology baseline
 averages each (utc_day_of_year, utc_hour) bucket excluding the held-out year
-and aggregates errors using observation-count weighting.
+and aggregates errors using observation-count weighting. The buckets live in
+dense 365×24 arrays (:class:`ClimatologyBaseline`).
 """
 
 from __future__ import annotations
 
+import ctypes
 import math
-from collections import defaultdict
-from typing import Dict, List, Tuple
+from typing import Dict, List, Sequence, Tuple
 
 import numpy as np
 
+from . import native
 from .training import (
     FINAL_TRAINING_PERIOD_LABEL,
     LeaveOneYearOutReport,
     YearlyDesignStats,
     YearlyValidationMetrics,
+    _pointer,
     solve_normal_equations,
 )
 
 
+CLIMATOLOGY_DAYS = 365
+CLIMATOLOGY_HOURS = 24
+CLIMATOLOGY_CELLS = CLIMATOLOGY_DAYS * CLIMATOLOGY_HOURS
+
+
+def _grid_cells(utc_day_index: np.ndarray, utc_hour: np.ndarray) -> np.ndarray:
+    """Flat ``(day - 1) * 24 + hour`` cell per observation, -1 outside the grid."""
+
+    day = np.asarray(utc_day_index, dtype=np.int64)
+    hour = np.asarray(utc_hour, dtype=np.int64)
+    inside = (day >= 1) & (day <= CLIMATOLOGY_DAYS) & (hour >= 0) & (hour < CLIMATOLOGY_HOURS)
+    return np.where(inside, (day - 1) * CLIMATOLOGY_HOURS + hour, -1)
+
+
+def _as_int64(values: np.ndarray) -> np.ndarray:
+    return np.ascontiguousarray(values, dtype=np.int64)
+
+
+class ClimatologyBaseline:
+    """Dense 365×24 UTC climatology used as the LOYO reference.
+
+    Each year's observations are summed into flat per-cell arrays and the
+    totals add the years in order, so held-out means are the same doubles as
+    per-cell sums kept in dictionaries. References of a held-out year are
+    gathered from ``(total - year) / (count - year count)``. Uses the native
+    engine of ``cpp/native/climatology.cpp`` when it is available, which also
+    averages the fold errors with NumPy's summation order; the NumPy fallback
+    uses ``np.bincount`` and fancy indexing.
+    """
+
+    def __init__(self, stats: Sequence[YearlyDesignStats] = ()) -> None:
+        self._slots: Dict[int, int] = {}
+        self._library = native.load_library()
+        self._handle = None
+        if self._library is not None:
+            self._handle = self._library.hc_climatology_create()
+            if not self._handle:
+                native.check(-1)
+        else:
+            self._year_sums: List[np.ndarray] = []
+            self._year_counts: List[np.ndarray] = []
+            self._total_sum = np.zeros(CLIMATOLOGY_CELLS, dtype=float)
+            self._total_count = np.zeros(CLIMATOLOGY_CELLS, dtype=np.int64)
+        for stat in stats:
+            self.add_year(stat)
+
+    @property
+    def backend(self) -> str:
+        return "native" if self._handle is not None else "numpy"
+
+    def add_year(self, stat: YearlyDesignStats) -> None:
+        if stat.year in self._slots:
+            raise ValueError(f"Year {stat.year} was already added to the climatology.")
+        y = np.ascontiguousarray(stat.y, dtype=float)
+        if self._handle is not None:
+            slot = ctypes.c_size_t(0)
+            native.check(
+                self._library.hc_climatology_add_year(
+                    self._handle,
+                    _pointer(_as_int64(stat.utc_day_index), ctypes.c_int64),
+                    _pointer(_as_int64(stat.utc_hour), ctypes.c_int64),
+                    _pointer(y),
+                    y.shape[0],
+                    ctypes.byref(slot),
+                )
+            )
+            self._slots[stat.year] = int(slot.value)
+            return
+
+        cells = _grid_cells(stat.utc_day_index, stat.utc_hour)
+        keep = (cells >= 0) & np.isfinite(y)
+        sums = np.bincount(cells[keep], weights=y[keep], minlength=CLIMATOLOGY_CELLS)
+        counts = np.bincount(cells[keep], minlength=CLIMATOLOGY_CELLS).astype(np.int64)
+        self._slots[stat.year] = len(self._year_sums)
+        self._year_sums.append(sums)
+        self._year_counts.append(counts)
+        self._total_sum += sums
+        self._total_count += counts
+
+    def reference(self, stat: YearlyDesignStats) -> np.ndarray:
+        """Held-out climatology at each observation of ``stat`` (NaN when unavailable)."""
+
+        slot = self._slots[stat.year]
+        out = np.empty(len(stat.utc_day_index), dtype=float)
+        if self._handle is not None:
+            native.check(
+                self._library.hc_climatology_reference(
+                    self._handle,
+                    slot,
+                    _pointer(_as_int64(stat.utc_day_index), ctypes.c_int64),
+                    _pointer(_as_int64(stat.utc_hour), ctypes.c_int64),
+                    out.shape[0],
+                    _pointer(out),
+                )
+            )
+            return out
+
+        cells = _grid_cells(stat.utc_day_index, stat.utc_hour)
+        inside = cells >= 0
+        others = self._total_count - self._year_counts[slot]
+        sums = self._total_sum - self._year_sums[slot]
+        out.fill(np.nan)
+        gathered = cells[inside]
+        with np.errstate(divide="ignore", invalid="ignore"):
+            out[inside] = np.where(others[gathered] > 0, sums[gathered] / others[gathered], np.nan)
+        return out
+
+    def fold_errors(self, stat: YearlyDesignStats, y_pred: np.ndarray) -> Tuple[float, float, int]:
+        """``(mse_model, mse_ref, n)`` of a held-out year over the observations with both predictions."""
+
+        y = np.ascontiguousarray(stat.y, dtype=float)
+        y_pred = np.ascontiguousarray(y_pred, dtype=float)
+        if self._handle is not None:
+            mse_model = ctypes.c_double(0.0)
+            mse_ref = ctypes.c_double(0.0)
+            valid = ctypes.c_int64(0)
+            native.check(
+                self._library.hc_climatology_fold_errors(
+                    self._handle,
+                    self._slots[stat.year],
+                    _pointer(_as_int64(stat.utc_day_index), ctypes.c_int64),
+                    _pointer(_as_int64(stat.utc_hour), ctypes.c_int64),
+                    _pointer(y),
+                    _pointer(y_pred),
+                    y.shape[0],
+                    ctypes.byref(mse_model),
+                    ctypes.byref(mse_ref),
+                    ctypes.byref(valid),
+                )
+            )
+            if valid.value == 0:
+                return math.nan, math.nan, 0
+            return float(mse_model.value), float(mse_ref.value), int(valid.value)
+
+        ref_values = self.reference(stat)
+        residuals_model = y - y_pred
+        finite_mask = np.isfinite(residuals_model) & np.isfinite(ref_values)
+        if not np.any(finite_mask):
+            return math.nan, math.nan, 0
+        mse_model = float(np.mean(np.square(residuals_model[finite_mask])))
+        mse_ref = float(np.mean(np.square(y[finite_mask] - ref_values[finite_mask])))
+        return mse_model, mse_ref, int(np.count_nonzero(finite_mask))
+
+    def __del__(self) -> None:
+        if getattr(self, "_handle", None) is not None:
+            self._library.hc_climatology_destroy(self._handle)
+            self._handle = None
+
+
 def accumulate_climatology_maps(
     stats: List[YearlyDesignStats],
 ) -> Tuple[
@@ -35,34 +187,36 @@ def accumulate_climatology_maps(
 
     Returns dictionaries for (utc_day_index, utc_hour) → value, keeping both the
     global aggregates and per-year contributions to support held-out exclusion.
+    :class:`ClimatologyBaseline` keeps the same sums in dense arrays.
     """
 
-    total_sum = defaultdict(float)
-    total_count = defaultdict(int)
+    def as_maps(
+        sums: np.ndarray, counts: np.ndarray
+    ) -> Tuple[Dict[Tuple[int, int], float], Dict[Tuple[int, int], int]]:
+        cells = np.flatnonzero(counts).tolist()
+        keys = [(cell // CLIMATOLOGY_HOURS + 1, cell % CLIMATOLOGY_HOURS) for cell in cells]
+        return (
+            dict(zip(keys, sums[cells].tolist())),
+            dict(zip(keys, counts[cells].tolist())),
+        )
+
+    total_sum = np.zeros(CLIMATOLOGY_CELLS, dtype=float)
+    total_count = np.zeros(CLIMATOLOGY_CELLS, dtype=np.int64)
     yearly_sum: Dict[int, Dict[Tuple[int, int], float]] = {}
     yearly_count: Dict[int, Dict[Tuple[int, int], int]] = {}
 
     for stat in stats:
-        sums = defaultdict(float)
-        counts = defaultdict(int)
+        y = np.asarray(stat.y, dtype=float)
+        cells = _grid_cells(stat.utc_day_index, stat.utc_hour)
+        keep = (cells >= 0) & np.isfinite(y)
+        sums = np.bincount(cells[keep], weights=y[keep], minlength=CLIMATOLOGY_CELLS)
+        counts = np.bincount(cells[keep], minlength=CLIMATOLOGY_CELLS).astype(np.int64)
+        yearly_sum[stat.year], yearly_count[stat.year] = as_maps(sums, counts)
+        total_sum += sums
+        total_count += counts
 
-        for utc_day, utc_hour, val in zip(stat.utc_day_index, stat.utc_hour, stat.y):
-            day = int(utc_day)
-            hour = int(utc_hour)
-            if 1 <= day <= 365 and 0 <= hour < 24 and np.isfinite(val):
-                key = (day, hour)
-                sums[key] += float(val)
-                counts[key] += 1
-
-        yearly_sum[stat.year] = dict(sums)
-        yearly_count[stat.year] = dict(counts)
-
-        for key, value in sums.items():
-            total_sum[key] += value
-        for key, value in counts.items():
-            total_count[key] += value
-
-    return dict(total_sum), dict(total_count), yearly_sum, yearly_count
+    total_sum_map, total_count_map = as_maps(total_sum, total_count)
+    return total_sum_map, total_count_map, yearly_sum, yearly_count
 
 
 def evaluate_loyo(
@@ -70,13 +224,15 @@ def evaluate_loyo(
     *,
     ridge_lambda: float,
     reference_spec: Dict[str, object],
+    baseline: ClimatologyBaseline | None = None,
 ) -> LeaveOneYearOutReport:
     """Run leave-one-year-out validation with a UTC climatology baseline.
 
     The baseline computes a mean per (utc_day_index, utc_hour) cell on a
     no-leap (1–365) grid and excludes the held-out year before each
     comparison. Aggregation of RMSE/skill statistics is weighted by the number
-    of valid observations per fold.
+    of valid observations per fold. A ``baseline`` built from the same years
+    can be shared across calls that only change the model.
     """
 
     if not stats:
@@ -105,7 +261,8 @@ def evaluate_loyo(
         b_total += entry.b
         total_obs += entry.n
 
-    total_sum, total_count, yearly_sum, yearly_count = accumulate_climatology_maps(stats)
+    if baseline is None:
+        baseline = ClimatologyBaseline(stats)
 
     year_metrics: List[YearlyValidationMetrics] = []
     weighted_mse = 0.0
@@ -122,43 +279,12 @@ def evaluate_loyo(
         b_excl = b_total - stat.b
         beta = solve_normal_equations(S_excl, b_excl, ridge_lambda)
 
-        y_pred = stat.X @ beta
-        residuals_model = stat.y - y_pred
-
-        sums_excl = yearly_sum.get(year, {})
-        counts_excl = yearly_count.get(year, {})
-
-        valid_mask = np.zeros(stat.n, dtype=bool)
-        ref_values = np.full(stat.n, np.nan, dtype=float)
-
-        for idx in range(stat.n):
-            utc_day = int(stat.utc_day_index[idx])
-            utc_hour = int(stat.utc_hour[idx])
-            if not (1 <= utc_day <= 365 and 0 <= utc_hour < 24):
-                continue
-
-            key = (utc_day, utc_hour)
-            total_cnt = total_count.get(key, 0)
-            cnt_excl = total_cnt - counts_excl.get(key, 0)
-            if cnt_excl <= 0:
-                continue
-
-            sum_excl = total_sum.get(key, 0.0) - sums_excl.get(key, 0.0)
-            ref_values[idx] = sum_excl / cnt_excl
-            valid_mask[idx] = True
-
-        finite_mask = valid_mask & np.isfinite(residuals_model) & np.isfinite(ref_values)
-        if not np.any(finite_mask):
+        mse_model, mse_ref, n_valid = baseline.fold_errors(stat, stat.predict(beta))
+        if n_valid == 0:
             continue
 
-        model_errors = residuals_model[finite_mask]
-        reference_errors = stat.y[finite_mask] - ref_values[finite_mask]
-
-        mse_model = float(np.mean(np.square(model_errors)))
-        mse_ref = float(np.mean(np.square(reference_errors)))
         rmse_model = math.sqrt(mse_model)
         skill = float("nan") if mse_ref <= 0.0 else float(1.0 - (mse_model / mse_ref))
-        n_valid = int(model_errors.size)
 
         year_metrics.append(
             YearlyValidationMetrics(
@@ -202,6 +328,8 @@ def evaluate_loyo(
 
 
 __all__ = [
+    "CLIMATOLOGY_CELLS",
+    "ClimatologyBaseline",
     "accumulate_climatology_maps",
     "evaluate_loyo",
 ]
@@ -0,0 +1,153 @@
+"""Batch evaluation of fitted models for plots and post-processing.
+
+:class:`ModelEvaluator` holds one target model, from a JSON payload or a model
+pack entry, as the coefficient vector of the training design (an absent
+diurnal term becomes a single zero coefficient). Its methods evaluate whole
+arrays through the native helpers of ``cpp/native`` (``design_predict``,
+``design_diurnal`` and ``diurnal_extremes``): outputs are NumPy arrays
+allocated here and filled in place, and contiguous float64 inputs are passed
+without copies. :meth:`ModelEvaluator.predict` and
+:meth:`ModelEvaluator.diurnal_coefficients` fall back to NumPy;
+:func:`diurnal_extremes_batch` needs the native library (see
+:func:`available`).
+"""
+
+from __future__ import annotations
+
+import ctypes
+from typing import Dict, List, Mapping
+
+import numpy as np
+
+from . import native
+from .training import (
+    _parameter_names,
+    _pointer,
+    build_annual_basis,
+    build_params_meta,
+    predict_design,
+)
+
+PACK_TARGETS = ("temperature", "specific_humidity", "pressure")
+
+
+def available() -> bool:
+    """Whether the native helpers are loaded (required by :func:`diurnal_extremes_batch`)."""
+
+    return native.load_library() is not None
+
+
+class ModelEvaluator:
+    """One target model in the layout of :func:`training.build_params_meta`."""
+
+    def __init__(self, n_diurnal: int, annual_per_param: Mapping[str, int], coefficients: np.ndarray):
+        self.n_diurnal = int(n_diurnal)
+        self.params_meta: List[Dict[str, int]] = build_params_meta(
+            n_diurnal=self.n_diurnal,
+            annual_per_param=dict(annual_per_param),
+            default_n_annual=0,
+        )
+        self.n_annual = np.array([int(entry["n_annual"]) for entry in self.params_meta], dtype=np.int32)
+        self.coefficients = np.ascontiguousarray(coefficients, dtype=np.float64)
+        if self.coefficients.shape != (sum(int(entry["length"]) for entry in self.params_meta),):
+            raise ValueError("Coefficient count does not match the parameter layout.")
+
+    @classmethod
+    def from_payload(cls, model_payload: Mapping[str, object]) -> "ModelEvaluator":
+        """Evaluator of a single-target JSON payload (see ``display.load_linear_model``)."""
+
+        model = model_payload["model"]  # type: ignore[index]
+        coefficients = np.asarray(model["coefficients"], dtype=np.float64)
+        layout = {entry["name"]: entry for entry in model["params_layout"]}
+        if "c0" not in layout:
+            raise ValueError("Model payload does not include mandatory parameter 'c0'.")
+        n_diurnal = int(model.get("n_diurnal", 0))
+        annual_per_param: Dict[str, int] = {}
+        blocks: List[np.ndarray] = []
+        for name in _parameter_names(n_diurnal):
+            entry = layout.get(name)
+            if entry is None:
+                blocks.append(np.zeros(1))
+                continue
+            start, length = int(entry["start"]), int(entry["length"])
+            annual_per_param[name] = int(entry["n_annual"])
+            blocks.append(coefficients[start : start + length])
+        return cls(n_diurnal, annual_per_param, np.concatenate(blocks))
+
+    @classmethod
+    def from_pack(cls, station: Mapping[str, object], target: str) -> "ModelEvaluator":
+        """Evaluator of one target of a ``model_pack.read_model_pack`` station."""
+
+        entry = station["targets"][PACK_TARGETS.index(target)]  # type: ignore[index]
+        annual_size = int(station["annual_basis_size"])  # type: ignore[arg-type]
+        block = np.asarray(entry["coefficients"], dtype=np.float64)
+        n_diurnal = int(entry["n_diurnal"])
+        annual_per_param: Dict[str, int] = {}
+        blocks: List[np.ndarray] = []
+        for term, name in enumerate(_parameter_names(n_diurnal)):
+            order = entry["n_annual"][term]
+            if order is None:
+                blocks.append(np.zeros(1))
+                continue
+            annual_per_param[name] = int(order)
+            blocks.append(block[term * annual_size : term * annual_size + 2 * int(order) + 1])
+        return cls(n_diurnal, annual_per_param, np.concatenate(blocks))
+
+    def predict(self, day_solar: np.ndarray, hour_solar: np.ndarray) -> np.ndarray:
+        """Model values at solar (day, hour) pairs, broadcast together."""
+
+        day, hour = np.broadcast_arrays(
+            np.asarray(day_solar, dtype=np.float64), np.asarray(hour_solar, dtype=np.float64)
+        )
+        values = predict_design(self.coefficients, day.ravel(), hour.ravel(), self.params_meta)
+        return values.reshape(day.shape)
+
+    def diurnal_coefficients(self, day_solar: np.ndarray) -> np.ndarray:
+        """Rows ``[c0, a1, b1, ...]`` of the diurnal series at each solar day."""
+
+        day = np.ascontiguousarray(day_solar, dtype=np.float64).ravel()
+        out = np.empty((day.shape[0], len(self.params_meta)), dtype=np.float64)
+        library = native.load_library()
+        if library is not None:
+            native.check(
+                library.hc_design_diurnal(
+                    self.n_diurnal,
+                    _pointer(self.n_annual, ctypes.c_int32),
+                    _pointer(self.coefficients),
+                    _pointer(day),
+                    day.shape[0],
+                    _pointer(out),
+                )
+            )
+            return out
+
+        for p, entry in enumerate(self.params_meta):
+            start, length = int(entry["start"]), int(entry["length"])
+            out[:, p] = build_annual_basis(day, int(entry["n_annual"])) @ self.coefficients[start : start + length]
+        return out
+
+
+def diurnal_extremes_batch(coefficients: np.ndarray) -> np.ndarray:
+    """Exact ``(mean, min, max, hour_of_min, hour_of_max)`` rows, one per row of ``coefficients``.
+
+    ``coefficients`` holds diurnal rows ``[c0, a1, b1, ...]`` as returned by
+    :meth:`ModelEvaluator.diurnal_coefficients`; hours are solar.
+    """
+
+    library = native.load_library()
+    if library is None:
+        raise RuntimeError("diurnal_extremes_batch needs the native helpers.")
+    rows = np.ascontiguousarray(coefficients, dtype=np.float64)
+    if rows.ndim != 2 or rows.shape[1] % 2 != 1:
+        raise ValueError("Expected diurnal rows of 2 * n_diurnal + 1 coefficients.")
+    out = np.empty((rows.shape[0], 5), dtype=np.float64)
+    native.check(library.hc_diurnal_extremes((rows.shape[1] - 1) // 2, _pointer(rows), rows.shape[0], _pointer(out)))
+    return out
+
+
+__all__ = [
+    "PACK_TARGETS",
+    "ModelEvaluator",
+    "available",
+    "diurnal_extremes_batch",
+]
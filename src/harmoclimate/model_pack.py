@@ -0,0 +1,263 @@
+"""Binary model pack bundling many stations for runtime loading.
+
+The pack is a single little-endian file laid out for memory mapping:
+
+* a 64-byte header (magic, format version, station count, basis sizes,
+  section offsets and a ``0x01020304`` byte-order mark, which a big-endian
+  loader reads byte-swapped and refuses);
+* one 256-byte record per station (code, name, coordinates, solar offset,
+  error envelope and the per-target ``params_layout`` orders);
+* an open-addressing hash table of ``uint32`` slots keyed by the FNV-1a hash
+  of the station code (slot value = station index + 1, 0 = empty);
+* the coefficients of every station as ``[target][diurnal term][annual term]``
+  doubles, zero-padded to a common stride and aligned on 64 bytes.
+
+Diurnal terms follow ``c0, a1, b1, a2, b2, ...`` and annual terms
+``constant, cos 1, sin 1, ...``, the same packing as the generated C++
+headers. ``cpp/include/harmoclimat/model_pack.hpp`` is the matching loader.
+"""
+
+from __future__ import annotations
+
+import json
+import math
+import struct
+from pathlib import Path
+from typing import Mapping, Sequence
+
+from .config import MODEL_DIR, MODEL_PACK_PATH
+from .template_cpp import max_harmonics, packed_coefficients
+
+PACK_MAGIC = b"HCPACK\x00\x00"
+PACK_VERSION = 2
+PACK_BYTE_ORDER_MARK = 0x01020304
+
+_HEADER = struct.Struct("<8s6I3QI4x")
+_RECORD = struct.Struct("<16s48s16d48B4I")
+_SLOT = struct.Struct("<I")
+_ALIGNMENT = 64
+
+_TARGET_SUFFIXES = ("_temperature", "_specific_humidity", "_pressure")
+_ENVELOPE_KEYS = ("mae", "bias", "p05", "p95")
+_CODE_BYTES = 16
+_NAME_BYTES = 48
+_MAX_DIURNAL_TERMS = 16
+_MAX_BASIS_SIZE = 33
+_ABSENT = 0xFF
+
+StationBundle = Sequence[Mapping[str, object]]
+
+
+def fnv1a_64(data: bytes) -> int:
+    """64-bit FNV-1a hash, as used by the pack's station index."""
+
+    value = 0xCBF29CE484222325
+    for byte in data:
+        value ^= byte
+        value = (value * 0x100000001B3) & 0xFFFFFFFFFFFFFFFF
+    return value
+
+
+def _align(offset: int) -> int:
+    return (offset + _ALIGNMENT - 1) // _ALIGNMENT * _ALIGNMENT
+
+
+def _encode_text(value: object, size: int, field: str) -> bytes:
+    """UTF-8 encode into a NUL-terminated fixed field; names are truncated, codes are not."""
+
+    raw = str(value).encode("utf-8")
+    if len(raw) < size:
+        return raw
+    if field == "station_code":
+        raise ValueError(f"Station code '{value}' exceeds {size - 1} bytes.")
+    return raw[: size - 1].decode("utf-8", errors="ignore").encode("utf-8")
+
+
+def _annual_orders(payload: Mapping[str, object], n_terms: int) -> list[int]:
+    """Per diurnal term annual order from ``params_layout``; 0xFF marks an absent term."""
+
+    orders = [_ABSENT] * _MAX_DIURNAL_TERMS
+    names = ["c0"]
+    for m in range(1, (n_terms - 1) // 2 + 1):
+        names.extend([f"a{m}", f"b{m}"])
+    layout = {entry["name"]: int(entry["n_annual"]) for entry in payload["model"]["params_layout"]}  # type: ignore[index]
+    for index, name in enumerate(names):
+        if name in layout:
+            orders[index] = layout[name]
+    return orders
+
+
+def _station_record(bundle: StationBundle, n_terms: int) -> bytes:
+    metadata = bundle[0]["metadata"]  # type: ignore[index]
+    envelope: list[float] = []
+    for payload in bundle:
+        target_envelope = payload["metadata"].get("error_envelope") or {}  # type: ignore[index]
+        envelope.extend(float(target_envelope.get(key, math.nan)) for key in _ENVELOPE_KEYS)
+    orders: list[int] = []
+    for payload in bundle:
+        orders.extend(_annual_orders(payload, n_terms))
+    n_diurnal = [int(payload["model"]["n_diurnal"]) for payload in bundle]  # type: ignore[index]
+    return _RECORD.pack(
+        _encode_text(metadata.get("station_code", ""), _CODE_BYTES, "station_code"),
+        _encode_text(metadata.get("station_usual_name", ""), _NAME_BYTES, "station_usual_name"),
+        float(metadata.get("longitude_deg", math.nan)),
+        float(metadata.get("latitude_deg", math.nan)),
+        float(metadata.get("altitude_m", math.nan)),
+        float(metadata.get("delta_utc_solar_h", 0.0)),
+        *envelope,
+        *orders,
+        *n_diurnal,
+        0,
+    )
+
+
+def write_model_pack(bundles: Sequence[StationBundle], output_path: Path) -> Path:
+    """Write ``(temperature, specific humidity, pressure)`` payload triples as a model pack."""
+
+    if not bundles:
+        raise ValueError("A model pack needs at least one station.")
+
+    max_annual, max_diurnal = max_harmonics([payload for bundle in bundles for payload in bundle])
+    annual_size = 2 * max_annual + 1
+    diurnal_size = 2 * max_diurnal + 1
+    if annual_size > _MAX_BASIS_SIZE or diurnal_size > _MAX_DIURNAL_TERMS:
+        raise ValueError(
+            f"The pack format supports at most {(_MAX_BASIS_SIZE - 1) // 2} annual and "
+            f"{(_MAX_DIURNAL_TERMS - 1) // 2} diurnal harmonics."
+        )
+    stride = (annual_size * diurnal_size + 7) // 8 * 8
+
+    count = len(bundles)
+    slots = 1
+    while slots < 2 * count:
+        slots *= 2
+
+    table = [0] * slots
+    seen: set[bytes] = set()
+    for index, bundle in enumerate(bundles):
+        code = str(bundle[0]["metadata"].get("station_code", "")).encode("utf-8")  # type: ignore[index]
+        if code in seen:
+            raise ValueError(f"Duplicate station code '{code.decode()}' in model pack.")
+        seen.add(code)
+        slot = fnv1a_64(code) & (slots - 1)
+        while table[slot]:
+            slot = (slot + 1) & (slots - 1)
+        table[slot] = index + 1
+
+    records_offset = _HEADER.size
+    hash_offset = records_offset + count * _RECORD.size
+    coeffs_offset = _align(hash_offset + slots * _SLOT.size)
+
+    output_path.parent.mkdir(parents=True, exist_ok=True)
+    with open(output_path, "wb") as handle:
+        handle.write(
+            _HEADER.pack(
+                PACK_MAGIC,
+                PACK_VERSION,
+                count,
+                annual_size,
+                diurnal_size,
+                stride,
+                slots,
+                records_offset,
+                hash_offset,
+                coeffs_offset,
+                PACK_BYTE_ORDER_MARK,
+            )
+        )
+        for bundle in bundles:
+            handle.write(_station_record(bundle, diurnal_size))
+        handle.write(struct.pack(f"<{slots}I", *table))
+        handle.write(b"\x00" * (coeffs_offset - handle.tell()))
+        for bundle in bundles:
+            for payload in bundle:
+                row = packed_coefficients(payload, max_annual, max_diurnal)
+                row.extend([0.0] * (stride - len(row)))
+                handle.write(struct.pack(f"<{stride}d", *row))
+
+    print(f"[OK] Model pack written: {output_path} ({count} stations)")
+    return output_path
+
+
+def build_model_pack(model_dir: Path = MODEL_DIR, output_path: Path = MODEL_PACK_PATH) -> Path:
+    """Pack every complete station bundle (T, Q and P JSON) found in ``model_dir``."""
+
+    bundles: list[list[dict]] = []
+    for temperature_path in sorted(model_dir.glob(f"*{_TARGET_SUFFIXES[0]}.json")):
+        basename = temperature_path.name[: -len(f"{_TARGET_SUFFIXES[0]}.json")]
+        paths = [model_dir / f"{basename}{suffix}.json" for suffix in _TARGET_SUFFIXES]
+        if not all(path.exists() for path in paths):
+            continue
+        bundle = []
+        for path in paths:
+            with open(path, "r", encoding="utf-8") as handle:
+                bundle.append(json.load(handle))
+        bundles.append(bundle)
+    if not bundles:
+        raise FileNotFoundError(f"No complete model bundles found in {model_dir}.")
+    return write_model_pack(bundles, output_path)
+
+
+def read_model_pack(path: Path) -> list[dict[str, object]]:
+    """Decode a model pack back into per-station dictionaries (inspection and tests)."""
+
+    data = Path(path).read_bytes()
+    (
+        magic,
+        version,
+        count,
+        annual_size,
+        diurnal_size,
+        stride,
+        _slots,
+        records_offset,
+        _hash_offset,
+        coeffs_offset,
+        byte_order,
+    ) = _HEADER.unpack_from(data, 0)
+    if magic != PACK_MAGIC or version != PACK_VERSION or byte_order != PACK_BYTE_ORDER_MARK:
+        raise ValueError(f"{path} is not a version {PACK_VERSION} HarmoClimate model pack.")
+
+    stations: list[dict[str, object]] = []
+    for index in range(count):
+        fields = _RECORD.unpack_from(data, records_offset + index * _RECORD.size)
+        envelope = fields[6:18]
+        orders = fields[18:66]
+        targets = []
+        for t in range(len(_TARGET_SUFFIXES)):
+            offset = coeffs_offset + (index * len(_TARGET_SUFFIXES) + t) * stride * 8
+            targets.append(
+                {
+                    "n_diurnal": fields[66 + t],
+                    "n_annual": [
+                        order if order != _ABSENT else None
+                        for order in orders[t * _MAX_DIURNAL_TERMS : t * _MAX_DIURNAL_TERMS + diurnal_size]
+                    ],
+                    "error_envelope": dict(zip(_ENVELOPE_KEYS, envelope[4 * t : 4 * t + 4])),
+                    "coefficients": list(struct.unpack_from(f"<{annual_size * diurnal_size}d", data, offset)),
+                }
+            )
+        stations.append(
+            {
+                "station_code": fields[0].rstrip(b"\x00").decode("utf-8"),
+                "station_usual_name": fields[1].rstrip(b"\x00").decode("utf-8"),
+                "longitude_deg": fields[2],
+                "latitude_deg": fields[3],
+                "altitude_m": fields[4],
+                "delta_utc_solar_h": fields[5],
+                "annual_basis_size": annual_size,
+                "diurnal_basis_size": diurnal_size,
+                "targets": targets,
+            }
+        )
+    return stations
+
+
+__all__ = [
+    "PACK_MAGIC",
+    "PACK_VERSION",
+    "build_model_pack",
+    "fnv1a_64",
+    "read_model_pack",
+    "write_model_pack",
+]
@@ -0,0 +1,211 @@
+"""Loader for the optional native helpers in ``cpp/native``.
+
+The sources are compiled once into a shared library under
+``generated/native/``, keyed by a hash of the sources, compiler and flags, and
+loaded through :mod:`ctypes`. ``HARMOCLIMATE_NATIVE_LIB`` points at a prebuilt
+library instead (the CMake target ``harmoclimate_native``), and
+``HARMOCLIMATE_NATIVE=0`` disables the native path. When no library can be
+built, :func:`load_library` returns ``None`` and callers use their NumPy
+implementation.
+"""
+
+from __future__ import annotations
+
+import ctypes
+import hashlib
+import os
+import shlex
+import subprocess
+import sys
+from pathlib import Path
+
+from .bench import resolve_compiler
+from .config import NATIVE_DIR, PROJECT_ROOT
+
+NATIVE_SOURCE_DIR = PROJECT_ROOT / "cpp" / "native"
+NATIVE_SOURCES = tuple(
+    NATIVE_SOURCE_DIR / name
+    for name in ("c_api.cpp", "climatology.cpp", "design_stats.cpp", "evaluate.cpp", "ingest.cpp")
+)
+# Shared headers of cpp/include the sources use (part of the build hash).
+NATIVE_INCLUDE_DIR = PROJECT_ROOT / "cpp" / "include"
+NATIVE_INCLUDES = (NATIVE_INCLUDE_DIR / "harmoclimat" / "civil.hpp",)
+# No FMA contraction: the results do not depend on the build machine.
+NATIVE_FLAGS = "-O3 -std=c++17 -shared -fPIC -pthread -ffp-contract=off"
+NATIVE_LIBS = "-lz"
+
+_DOUBLE_P = ctypes.POINTER(ctypes.c_double)
+_FLOAT_P = ctypes.POINTER(ctypes.c_float)
+_INT32_P = ctypes.POINTER(ctypes.c_int32)
+_INT64_P = ctypes.POINTER(ctypes.c_int64)
+_UINT32_P = ctypes.POINTER(ctypes.c_uint32)
+_UINT64_P = ctypes.POINTER(ctypes.c_uint64)
+_PROTOTYPES = {
+    "hc_last_error": (ctypes.c_char_p, []),
+    "hc_design_accumulator_create": (ctypes.c_void_p, [ctypes.c_int, _INT32_P]),
+    "hc_design_accumulator_destroy": (None, [ctypes.c_void_p]),
+    "hc_design_accumulator_dimension": (ctypes.c_size_t, [ctypes.c_void_p]),
+    "hc_design_accumulator_add": (
+        ctypes.c_int,
+        [ctypes.c_void_p, _DOUBLE_P, _DOUBLE_P, _DOUBLE_P, ctypes.c_size_t, ctypes.c_uint],
+    ),
+    "hc_design_accumulator_result": (
+        ctypes.c_int,
+        [ctypes.c_void_p, _DOUBLE_P, _DOUBLE_P, ctypes.POINTER(ctypes.c_int64)],
+    ),
+    "hc_design_predict": (
+        ctypes.c_int,
+        [ctypes.c_int, _INT32_P, _DOUBLE_P, _DOUBLE_P, _DOUBLE_P, ctypes.c_size_t, _DOUBLE_P],
+    ),
+    "hc_design_diurnal": (
+        ctypes.c_int,
+        [ctypes.c_int, _INT32_P, _DOUBLE_P, _DOUBLE_P, ctypes.c_size_t, _DOUBLE_P],
+    ),
+    "hc_diurnal_extremes": (ctypes.c_int, [ctypes.c_int, _DOUBLE_P, ctypes.c_size_t, _DOUBLE_P]),
+    "hc_climatology_create": (ctypes.c_void_p, []),
+    "hc_climatology_destroy": (None, [ctypes.c_void_p]),
+    "hc_climatology_add_year": (
+        ctypes.c_int,
+        [ctypes.c_void_p, _INT64_P, _INT64_P, _DOUBLE_P, ctypes.c_size_t, ctypes.POINTER(ctypes.c_size_t)],
+    ),
+    "hc_climatology_reference": (
+        ctypes.c_int,
+        [ctypes.c_void_p, ctypes.c_size_t, _INT64_P, _INT64_P, ctypes.c_size_t, _DOUBLE_P],
+    ),
+    "hc_climatology_fold_errors": (
+        ctypes.c_int,
+        [
+            ctypes.c_void_p,
+            ctypes.c_size_t,
+            _INT64_P,
+            _INT64_P,
+            _DOUBLE_P,
+            _DOUBLE_P,
+            ctypes.c_size_t,
+            _DOUBLE_P,
+            _DOUBLE_P,
+            _INT64_P,
+        ],
+    ),
+    "hc_ingest_archives": (
+        ctypes.c_void_p,
+        [
+            ctypes.POINTER(ctypes.c_char_p),
+            ctypes.c_size_t,
+            ctypes.POINTER(ctypes.c_char_p),
+            ctypes.c_size_t,
+            _INT64_P,
+            _INT32_P,
+            ctypes.c_size_t,
+            ctypes.c_uint,
+        ],
+    ),
+    "hc_ingest_free": (None, [ctypes.c_void_p]),
+    "hc_ingest_station_count": (ctypes.c_size_t, [ctypes.c_void_p]),
+    "hc_ingest_station_code": (ctypes.c_char_p, [ctypes.c_void_p, ctypes.c_size_t]),
+    "hc_ingest_rows": (ctypes.c_size_t, [ctypes.c_void_p, ctypes.c_size_t]),
+    "hc_ingest_counts": (None, [ctypes.c_void_p, ctypes.c_size_t, _UINT64_P, _UINT64_P]),
+    "hc_ingest_columns": (
+        None,
+        [
+            ctypes.c_void_p,
+            ctypes.c_size_t,
+            _INT64_P,
+            _FLOAT_P,
+            _FLOAT_P,
+            _FLOAT_P,
+            _FLOAT_P,
+            _FLOAT_P,
+            _FLOAT_P,
+            _UINT32_P,
+        ],
+    ),
+    "hc_ingest_name_count": (ctypes.c_size_t, [ctypes.c_void_p, ctypes.c_size_t]),
+    "hc_ingest_name": (ctypes.c_char_p, [ctypes.c_void_p, ctypes.c_size_t, ctypes.c_size_t]),
+    "hc_ingest_first_name": (ctypes.c_char_p, [ctypes.c_void_p, ctypes.c_size_t]),
+}
+
+_library: ctypes.CDLL | None = None
+_load_attempted = False
+
+
+def _library_suffix() -> str:
+    if sys.platform == "win32":
+        return ".dll"
+    if sys.platform == "darwin":
+        return ".dylib"
+    return ".so"
+
+
+def build_library(compiler: str | None = None, output_dir: Path = NATIVE_DIR) -> Path:
+    """Compile ``cpp/native`` into a shared library (reused while the sources are unchanged)."""
+
+    cxx = resolve_compiler(compiler)
+    digest = hashlib.sha256()
+    digest.update(f"{cxx}\0{NATIVE_FLAGS}\0{NATIVE_LIBS}\0".encode())
+    for source in [*sorted(NATIVE_SOURCE_DIR.glob("*.[ch]pp")), *NATIVE_INCLUDES]:
+        digest.update(source.read_bytes())
+    path = output_dir / f"libharmoclimate_native-{digest.hexdigest()[:16]}{_library_suffix()}"
+    if path.exists():
+        return path
+
+    output_dir.mkdir(parents=True, exist_ok=True)
+    partial = path.with_name(path.name + f".{os.getpid()}.tmp")
+    command = [
+        cxx,
+        *shlex.split(NATIVE_FLAGS),
+        f"-I{NATIVE_INCLUDE_DIR}",
+        *(str(source) for source in NATIVE_SOURCES),
+        "-o",
+        str(partial),
+        *shlex.split(NATIVE_LIBS),
+    ]
+    subprocess.run(command, check=True, capture_output=True, text=True)
+    os.replace(partial, path)
+    print(f"[OK] Built native helpers -> {path}")
+    return path
+
+
+def load_library() -> ctypes.CDLL | None:
+    """The native helper library, or ``None`` when it is disabled or cannot be built."""
+
+    global _library, _load_attempted
+    if _load_attempted:
+        return _library
+    _load_attempted = True
+    if os.environ.get("HARMOCLIMATE_NATIVE", "1").strip().lower() in {"0", "off", "false", "no"}:
+        return None
+
+    try:
+        prebuilt = os.environ.get("HARMOCLIMATE_NATIVE_LIB")
+        path = Path(prebuilt) if prebuilt else build_library()
+        library = ctypes.CDLL(str(path))
+    except (OSError, subprocess.CalledProcessError) as exc:
+        detail = exc.stderr.strip().splitlines()[-1] if isinstance(exc, subprocess.CalledProcessError) and exc.stderr else exc
+        print(f"[Info] Native helpers unavailable ({detail}); using NumPy.")
+        return None
+
+    for name, (restype, argtypes) in _PROTOTYPES.items():
+        function = getattr(library, name)
+        function.restype = restype
+        function.argtypes = argtypes
+    _library = library
+    return _library
+
+
+def check(status: int) -> None:
+    """Raise the library's last error when ``status`` is non-zero."""
+
+    if status != 0:
+        assert _library is not None
+        raise RuntimeError(_library.hc_last_error().decode("utf-8", "replace"))
+
+
+__all__ = [
+    "NATIVE_FLAGS",
+    "NATIVE_LIBS",
+    "NATIVE_SOURCES",
+    "build_library",
+    "check",
+    "load_library",
+]
@@ -0,0 +1,278 @@
+"""Numerical parity between the generated C++ headers and the Python model.
+
+For every station with a T/Q/P bundle in ``generated/models/`` and a header in
+``generated/templates/``, ``cpp/tests/parity_driver.cpp`` evaluates the header
+through each of its code paths on a dense solar grid. The same points are then
+evaluated with :func:`harmoclimate.display.predict_model_solar`.
+
+The grid covers every integer solar day (the Python model floors the day) at
+sub-hourly steps. It adds wrap-boundary cases, where the C++ paths receive the
+same point shifted by whole years and days, including far from the origin.
+Errors are reported per station, path and target. The relative error is
+normalised by the largest Python value of the target on the grid, so it stays
+meaningful for temperatures near 0 degC.
+
+When ``harmoclimat_psychrometrics.hpp`` sits next to the headers (or
+``psychrometrics=True`` generates it for the run), ``predict_full()`` and
+``predict_full_batch()`` are checked as well. Their relative humidity, dew
+point and vapour pressure are compared with :mod:`harmoclimate.psychrometrics`
+applied to the Python T/Q/P, within the limits the companion header is
+generated against.
+"""
+
+from __future__ import annotations
+
+import json
+import math
+import shlex
+import subprocess
+import tempfile
+from pathlib import Path
+from typing import Sequence
+
+import numpy as np
+
+from . import psychrometrics as psy
+from .bench import resolve_compiler, station_headers
+from .config import BENCH_DIR, MODEL_DIR, PROJECT_ROOT, TEMPLATE_DIR
+from .core import SOLAR_YEAR_DAYS
+from .display import load_linear_model, predict_model_solar
+from .template_cpp_psychrometrics import (
+    PSYCHROMETRICS_HEADER_NAME,
+    _E_RELATIVE_TOLERANCE,
+    _RH_TOLERANCE_PERCENT,
+    _TD_TOLERANCE_C,
+    generate_cpp_psychrometrics,
+)
+
+PARITY_SOURCE = PROJECT_ROOT / "cpp" / "tests" / "parity_driver.cpp"
+DEFAULT_STEPS_PER_DAY = 96
+DEFAULT_TOLERANCE = 1e-12
+DEFAULT_FLAGS = "-O2"
+
+_TARGETS = ("temperature", "specific_humidity", "pressure")
+# predict_full() outputs and their limits: RH in %, Td in degC (absolute), E relative.
+_DERIVED = ("relative_humidity_percent", "dew_point_c", "vapor_pressure_hpa")
+_DERIVED_TOLERANCES = (_RH_TOLERANCE_PERCENT, _TD_TOLERANCE_C, _E_RELATIVE_TOLERANCE)
+
+# Wrap-boundary cases: canonical (day, hour) points and the year / day shifts
+# applied to the C++ inputs.
+_EDGE_DAYS = (0, 1, 182, 364, 365)
+_EDGE_HOURS = (0.0, 1e-9, 12.0, 24.0 - 1e-9)
+_YEAR_SHIFTS = (-1000, -1, 0, 1, 1000)
+_DAY_SHIFTS = (-1000, -1, 0, 1, 1000)
+
+
+def parity_grid(steps_per_day: int = DEFAULT_STEPS_PER_DAY) -> tuple[np.ndarray, np.ndarray, np.ndarray, np.ndarray]:
+    """Return ``(day_ref, hour_ref, day_in, hour_in)``: Python points and C++ inputs."""
+
+    days = np.arange(int(math.floor(SOLAR_YEAR_DAYS)) + 1, dtype=np.float64)
+    hours = np.arange(steps_per_day, dtype=np.float64) * (24.0 / steps_per_day)
+    day_ref, hour_ref = (axis.ravel() for axis in np.meshgrid(days, hours, indexing="ij"))
+    day_in, hour_in = day_ref.copy(), hour_ref.copy()
+
+    edge_ref: list[tuple[float, float]] = []
+    edge_in: list[tuple[float, float]] = []
+    for day in _EDGE_DAYS:
+        for hour in _EDGE_HOURS:
+            for years in _YEAR_SHIFTS:
+                for whole_days in _DAY_SHIFTS:
+                    edge_ref.append((float(day), hour))
+                    edge_in.append((day + years * SOLAR_YEAR_DAYS, hour + 24.0 * whole_days))
+    edge_ref.append((0.0, 0.0))
+    edge_in.append((SOLAR_YEAR_DAYS, 24.0))
+
+    ref = np.asarray(edge_ref)
+    inputs = np.asarray(edge_in)
+    return (
+        np.concatenate([day_ref, ref[:, 0]]),
+        np.concatenate([hour_ref, ref[:, 1]]),
+        np.concatenate([day_in, inputs[:, 0]]),
+        np.concatenate([hour_in, inputs[:, 1]]),
+    )
+
+
+def _python_reference(payloads: Sequence[dict], day_ref: np.ndarray, hour_ref: np.ndarray) -> np.ndarray:
+    reference = np.empty((len(payloads), day_ref.size))
+    for t, payload in enumerate(payloads):
+        reference[t] = [predict_model_solar(payload, d, h) for d, h in zip(day_ref, hour_ref)]
+    return reference
+
+
+def _derived_reference(reference: np.ndarray) -> np.ndarray:
+    temperature, specific_humidity, pressure = reference
+    vapor_pressure = psy.vapor_partial_pressure_hpa_from_q_p(specific_humidity, pressure)
+    return np.stack(
+        [
+            psy.relative_humidity_percent_from_specific(temperature, specific_humidity, pressure),
+            psy.dew_point_c_from_e(vapor_pressure),
+            vapor_pressure,
+        ]
+    )
+
+
+def _run_driver(
+    cxx: str,
+    flags: str,
+    header: Path,
+    day_in: np.ndarray,
+    hour_in: np.ndarray,
+    scratch: Path,
+    include_dirs: Sequence[Path] = (),
+) -> tuple[dict[str, np.ndarray], dict[str, np.ndarray]]:
+    """Return the T/Q/P outputs of every path and the RH/Td/E outputs of the derived ones."""
+
+    binary = scratch / f"parity_{header.stem}"
+    subprocess.run(
+        [
+            cxx,
+            "-std=c++20",
+            *shlex.split(flags),
+            f"-I{header.parent}",
+            *(f"-I{path}" for path in include_dirs),
+            f'-DHARMOCLIMAT_PARITY_HEADER="{header.name}"',
+            str(PARITY_SOURCE),
+            "-o",
+            str(binary),
+        ],
+        check=True,
+    )
+    grid_path = scratch / f"{header.stem}_grid.bin"
+    out_path = scratch / f"{header.stem}_out.bin"
+    with open(grid_path, "wb") as handle:
+        np.asarray([day_in.size], dtype=np.uint64).tofile(handle)
+        day_in.astype(np.float64).tofile(handle)
+        hour_in.astype(np.float64).tofile(handle)
+    completed = subprocess.run(
+        [str(binary), str(grid_path), str(out_path)], check=True, capture_output=True, text=True
+    )
+    names = json.loads(completed.stdout)
+    values = np.fromfile(out_path, dtype=np.float64)
+    split = len(names["paths"]) * len(_TARGETS) * day_in.size
+    paths = values[:split].reshape(len(names["paths"]), len(_TARGETS), day_in.size)
+    derived = values[split:].reshape(len(names["derived"]), len(_DERIVED), day_in.size)
+    return dict(zip(names["paths"], paths)), dict(zip(names["derived"], derived))
+
+
+def run_parity(
+    model_dir: Path = MODEL_DIR,
+    template_dir: Path = TEMPLATE_DIR,
+    steps_per_day: int = DEFAULT_STEPS_PER_DAY,
+    tolerance: float = DEFAULT_TOLERANCE,
+    compiler: str | None = None,
+    flags: str = DEFAULT_FLAGS,
+    headers: Sequence[str] | None = None,
+    psychrometrics: bool = False,
+) -> dict[str, object]:
+    """Compare every station header with the Python model and return the report.
+
+    ``report["passed"]`` is False when any path's normalised error exceeds
+    ``tolerance``, or when a derived RH/Td/E output exceeds the limits of the
+    psychrometrics header. ``psychrometrics`` generates that header into the
+    scratch directory when ``template_dir`` has none.
+    """
+
+    cxx = resolve_compiler(compiler)
+    day_ref, hour_ref, day_in, hour_in = parity_grid(steps_per_day)
+    stems = [path.stem for path in station_headers(template_dir)]
+    if headers:
+        wanted = {Path(name).stem for name in headers}
+        stems = [stem for stem in stems if stem in wanted]
+
+    stations: list[dict[str, object]] = []
+    with tempfile.TemporaryDirectory(prefix="harmoclimat_parity_") as scratch:
+        include_dirs: list[Path] = []
+        if psychrometrics and not (template_dir / PSYCHROMETRICS_HEADER_NAME).exists():
+            generate_cpp_psychrometrics(Path(scratch))
+            include_dirs.append(Path(scratch))
+        for stem in stems:
+            model_paths = [model_dir / f"{stem}_{target}.json" for target in _TARGETS]
+            if not all(path.exists() for path in model_paths):
+                continue
+            payloads = [load_linear_model(path) for path in model_paths]
+            reference = _python_reference(payloads, day_ref, hour_ref)
+            outputs, derived_outputs = _run_driver(
+                cxx, flags, template_dir / f"{stem}.hpp", day_in, hour_in, Path(scratch), include_dirs
+            )
+
+            scale = np.max(np.abs(reference), axis=1)
+            paths: dict[str, dict[str, dict[str, float]]] = {}
+            passed = True
+            for name, values in outputs.items():
+                errors = np.abs(values - reference)
+                paths[name] = {}
+                for t, target in enumerate(_TARGETS):
+                    max_abs = float(np.max(errors[t]))
+                    max_rel = float(max_abs / scale[t]) if scale[t] > 0.0 else max_abs
+                    worst = int(np.argmax(errors[t]))
+                    paths[name][target] = {
+                        "max_abs": max_abs,
+                        "max_rel": max_rel,
+                        "worst_day_solar": float(day_in[worst]),
+                        "worst_hour_solar": float(hour_in[worst]),
+                    }
+                    passed = passed and max_rel <= tolerance
+
+            derived: dict[str, dict[str, dict[str, float]]] = {}
+            if derived_outputs:
+                derived_reference = _derived_reference(reference)
+                for name, values in derived_outputs.items():
+                    errors = np.abs(values - derived_reference)
+                    errors[2] /= derived_reference[2]
+                    derived[name] = {}
+                    for k, quantity in enumerate(_DERIVED):
+                        worst = int(np.argmax(errors[k]))
+                        max_error = float(errors[k, worst])
+                        derived[name][quantity] = {
+                            "max_error": max_error,
+                            "limit": _DERIVED_TOLERANCES[k],
+                            "worst_day_solar": float(day_in[worst]),
+                            "worst_hour_solar": float(hour_in[worst]),
+                        }
+                        passed = passed and max_error <= _DERIVED_TOLERANCES[k]
+            stations.append({"station": stem, "passed": passed, "paths": paths, "derived": derived})
+            status = "OK" if passed else "FAIL"
+            worst_rel = max(entry["max_rel"] for path in paths.values() for entry in path.values())
+            message = f"[{status}] {stem}: worst normalised error {worst_rel:.3g} over {len(outputs)} paths"
+            if derived:
+                worst_derived = ", ".join(
+                    f"{quantity} {max(path[quantity]['max_error'] for path in derived.values()):.3g}"
+                    for quantity in _DERIVED
+                )
+                message += f"; predict_full {worst_derived}"
+            print(message)
+
+    if not stations:
+        raise FileNotFoundError(f"No station with both a header in {template_dir} and T/Q/P bundles in {model_dir}.")
+    return {
+        "grid_points": int(day_in.size),
+        "steps_per_day": steps_per_day,
+        "tolerance": tolerance,
+        "flags": flags,
+        "compiler_path": cxx,
+        "psychrometrics": any(station["derived"] for station in stations),
+        "passed": all(station["passed"] for station in stations),
+        "stations": stations,
+    }
+
+
+def write_parity_report(report: dict[str, object], output_path: Path | None = None) -> Path:
+    """Write ``report`` as JSON (default ``generated/bench/parity.json``)."""
+
+    path = output_path or BENCH_DIR / "parity.json"
+    path.parent.mkdir(parents=True, exist_ok=True)
+    with open(path, "w", encoding="utf-8") as handle:
+        json.dump(report, handle, indent=2)
+    print(f"[OK] Parity report written to {path}")
+    return path
+
+
+__all__ = [
+    "DEFAULT_FLAGS",
+    "DEFAULT_STEPS_PER_DAY",
+    "DEFAULT_TOLERANCE",
+    "PARITY_SOURCE",
+    "parity_grid",
+    "run_parity",
+    "write_parity_report",
+]
@@ -18,19 +18,38 @@ from .config import (
     GENERATED_DIR,
     MEDIA_DIR,
     MODEL_DIR,
+    MODEL_PACK_PATH,
     N_DIURNAL_HARMONICS,
     STATION_CODE,
     TEMPLATE_DIR,
     ArtifactPaths,
     build_artifact_paths,
+    build_department_urls,
     build_urls_for_station,
     compute_output_basename,
     slugify_station_name,
 )
+from .bench import DEFAULT_FLAG_SETS, run_template_benchmarks, write_benchmark_report
 from .core import load_parquet_dataset
-from .data_ingest import StationRecord, StreamResult, stream_filter_to_disk
+from .data_ingest import StationRecord, StreamResult, stream_filter_to_disk, stream_stations_to_disk
 from .metadata import StationMetadata, summarize_station
-from .template_cpp import generate_cpp_header
+from .model_pack import build_model_pack
+from .parity import DEFAULT_STEPS_PER_DAY, DEFAULT_TOLERANCE, run_parity, write_parity_report
+from .parity import DEFAULT_FLAGS as PARITY_DEFAULT_FLAGS
+from .sweep import (
+    DEFAULT_SWEEP_DIURNAL_ANNUAL,
+    DEFAULT_SWEEP_LAMBDAS,
+    DEFAULT_SWEEP_MEAN_ANNUAL,
+    DEFAULT_SWEEP_N_DIURNAL,
+    build_sweep_grid,
+    pareto_front,
+    run_sweep,
+    sweep_report,
+    write_sweep_report,
+)
+from .template_cpp import generate_cpp_header, generate_cpp_registry
+from .template_cpp_embedded import NUMERIC_MODES, NUMERIC_SUFFIXES, generate_cpp_embedded_header
+from .template_cpp_psychrometrics import generate_cpp_psychrometrics
 from .evaluation import evaluate_loyo
 from .training import (
     LinearModelFit,
@@ -49,6 +68,9 @@ from .display import (
     plot_intraday,
     plot_year,
 )
+# One year of hourly rows: stations below this are skipped by department runs.
+DEPARTMENT_MIN_ROWS = 8760
+
 _TARGET_SUFFIXES = {
     "T": "_temperature",
     "Q": "_specific_humidity",
@@ -333,6 +355,8 @@ def _finalize_pipeline(
         payloads["P"],
         artifact_paths.cpp_header,
     )
+    generate_cpp_registry(MODEL_DIR, TEMPLATE_DIR)
+    build_model_pack(MODEL_DIR, MODEL_PACK_PATH)
 
     return station_meta
 
@@ -486,10 +510,56 @@ def run_pipeline(station_code: str = STATION_CODE, urls: Sequence[str] | None =
     )
 
 
-def generate_pipeline(station_code: str) -> StationMetadata:
-    """Fetch remote data for a station code and run the end-to-end pipeline."""
+def generate_pipeline(station_code: str, archives: Sequence[str] | None = None) -> StationMetadata:
+    """Fetch remote data (or read local ``archives``) for a station code and run the pipeline."""
+
+    return run_pipeline(station_code=station_code, urls=archives or None)
+
+
+def department_pipeline(
+    department_code: str,
+    station_codes: Sequence[str] | None = None,
+    archives: Sequence[str] | None = None,
+    min_rows: int = DEPARTMENT_MIN_ROWS,
+) -> list[StationMetadata]:
+    """Read a department's archives once and run the pipeline for each station.
+
+    ``station_codes`` restricts the run (every station of the archives by
+    default); stations with fewer than ``min_rows`` kept rows are skipped.
+    """
+
+    ensure_directories()
+
+    resolved_urls = list(archives) if archives else build_department_urls(department_code)
+    stream_results = stream_stations_to_disk(resolved_urls, station_codes=station_codes)
+
+    station_metas: list[StationMetadata] = []
+    for station_code, stream_result in stream_results.items():
+        rows = len(stream_result.station_records)
+        if rows < min_rows:
+            print(f"[Skip] {station_code} ({stream_result.station_name}): {rows:,} rows < {min_rows:,}")
+            continue
+        print(f"[Station] {station_code} ({stream_result.station_name})")
+        artifact_paths = build_artifact_paths(stream_result.station_slug)
+        df = load_parquet_dataset(artifact_paths.parquet)
+        try:
+            station_meta = _finalize_pipeline(
+                df=df,
+                artifact_paths=artifact_paths,
+                station_records=stream_result.station_records,
+                station_name=stream_result.station_name,
+                station_code=station_code,
+            )
+        except (KeyError, ValueError) as exc:
+            print(f"[Skip] {station_code} ({stream_result.station_name}): {exc}")
+            continue
+        station_metas.append(station_meta)
 
-    return run_pipeline(station_code=station_code)
+    missing = sorted(set(station_codes or ()) - set(stream_results))
+    if missing:
+        print(f"[Warn] No data found for station codes: {', '.join(missing)}")
+    print(f"[OK] Generated {len(station_metas)} of {len(stream_results)} stations of department {department_code}")
+    return station_metas
 
 
 def regenerate_pipeline(model_json: str | Path) -> StationMetadata:
@@ -718,8 +788,21 @@ def display_pipeline(
     return media_path
 
 
-def template_pipeline(model_name: str, target_language: str) -> Path:
-    """Generate an embedded template for an existing model bundle."""
+def template_pipeline(
+    model_name: str,
+    target_language: str,
+    numeric: str = "double",
+    embedded_dir: str | Path | None = None,
+    psychrometrics: bool = False,
+) -> Path:
+    """Generate an embedded template for an existing model bundle.
+
+    ``numeric`` selects the arithmetic: ``double`` writes the regular header,
+    ``float``, ``q15`` or ``q31`` write a freestanding variant under
+    ``embedded_dir`` (default ``templates/embedded``). ``psychrometrics`` also
+    writes the ``harmoclimat_psychrometrics.hpp`` companion of the double
+    headers, which needs wsp2p.
+    """
 
     ensure_directories()
 
@@ -728,6 +811,8 @@ def template_pipeline(model_name: str, target_language: str) -> Path:
 
     if language != "cpp":
         raise ValueError(f"Unsupported target language '{target_language}'. Only 'cpp' is available.")
+    if numeric != "double" and numeric not in NUMERIC_MODES:
+        raise ValueError(f"Unsupported numeric mode '{numeric}'. Choose from double, {', '.join(NUMERIC_MODES)}.")
 
     temperature_path = MODEL_DIR / f"{basename}{_TARGET_SUFFIXES['T']}.json"
     specific_humidity_path = MODEL_DIR / f"{basename}{_TARGET_SUFFIXES['Q']}.json"
@@ -744,6 +829,18 @@ def template_pipeline(model_name: str, target_language: str) -> Path:
     specific_humidity_payload = load_linear_model(specific_humidity_path)
     pressure_payload = load_linear_model(pressure_path)
 
+    if numeric != "double":
+        output_dir = Path(embedded_dir) if embedded_dir else TEMPLATE_DIR / "embedded"
+        header_path = output_dir / f"{basename}_{NUMERIC_SUFFIXES[numeric]}.hpp"
+        generate_cpp_embedded_header(
+            temperature_payload,
+            specific_humidity_payload,
+            pressure_payload,
+            header_path,
+            numeric=numeric,
+        )
+        return header_path
+
     header_path = TEMPLATE_DIR / f"{basename}.hpp"
     generate_cpp_header(
         temperature_payload,
@@ -751,16 +848,129 @@ def template_pipeline(model_name: str, target_language: str) -> Path:
         pressure_payload,
         header_path,
     )
+    generate_cpp_registry(MODEL_DIR, TEMPLATE_DIR)
+    if psychrometrics:
+        generate_cpp_psychrometrics(TEMPLATE_DIR)
 
     return header_path
 
 
+def bench_pipeline(
+    flag_sets: Sequence[str] | None = None,
+    compiler: str | None = None,
+    output_path: str | Path | None = None,
+    min_seconds: float = 0.25,
+    headers: Sequence[str] | None = None,
+) -> Path:
+    """Benchmark every generated station header and write the JSON report."""
+
+    report = run_template_benchmarks(
+        TEMPLATE_DIR,
+        flag_sets=flag_sets or DEFAULT_FLAG_SETS,
+        compiler=compiler,
+        min_seconds=min_seconds,
+        headers=headers,
+    )
+    return write_benchmark_report(report, Path(output_path) if output_path else None)
+
+
+def parity_pipeline(
+    steps_per_day: int = DEFAULT_STEPS_PER_DAY,
+    tolerance: float = DEFAULT_TOLERANCE,
+    compiler: str | None = None,
+    flags: str | None = None,
+    output_path: str | Path | None = None,
+    headers: Sequence[str] | None = None,
+    psychrometrics: bool = False,
+) -> bool:
+    """Check every generated station header against the Python model.
+
+    Writes the JSON report and returns True when every station is within
+    ``tolerance``. ``psychrometrics`` also checks predict_full(), generating
+    the companion header for the run when ``generated/templates`` has none.
+    """
+
+    report = run_parity(
+        MODEL_DIR,
+        TEMPLATE_DIR,
+        steps_per_day=steps_per_day,
+        tolerance=tolerance,
+        compiler=compiler,
+        flags=flags or PARITY_DEFAULT_FLAGS,
+        headers=headers,
+        psychrometrics=psychrometrics,
+    )
+    write_parity_report(report, Path(output_path) if output_path else None)
+    return bool(report["passed"])
+
+
+def sweep_pipeline(
+    model_name: str,
+    *,
+    targets: Sequence[str] = ("T", "Q", "P"),
+    n_diurnal_values: Sequence[int] = DEFAULT_SWEEP_N_DIURNAL,
+    mean_annual_values: Sequence[int] = DEFAULT_SWEEP_MEAN_ANNUAL,
+    diurnal_annual_values: Sequence[int] = DEFAULT_SWEEP_DIURNAL_ANNUAL,
+    ridge_lambdas: Sequence[float] = DEFAULT_SWEEP_LAMBDAS,
+    threads: int | None = None,
+    output_path: str | Path | None = None,
+) -> Path:
+    """LOYO sweep of harmonic orders and ridge λ on a station's cached dataset.
+
+    Writes the JSON report (every configuration and the Pareto front of skill
+    against coefficient count per target) and returns its path.
+    """
+
+    ensure_directories()
+
+    basename = _normalize_model_basename(model_name)
+    station_slug = basename[len(f"{COUNTRY_CODE.lower()}_") :]
+    artifact_paths = build_artifact_paths(station_slug)
+    if not artifact_paths.parquet.exists():
+        raise FileNotFoundError(
+            f"Missing cached dataset at {artifact_paths.parquet}. Run the generate pipeline first."
+        )
+
+    prepared = prepare_training_frame(load_parquet_dataset(artifact_paths.parquet))
+    configs = build_sweep_grid(n_diurnal_values, mean_annual_values, diurnal_annual_values, ridge_lambdas)
+    print(f"[Info] Sweeping {len(configs)} configurations for {basename}")
+
+    results_by_target = {}
+    for target in targets:
+        results = run_sweep(prepared, target, configs, threads=threads)
+        results_by_target[target] = results
+        for result in pareto_front(results):
+            config = result.config
+            print(
+                f"  {target} | {config.coefficient_count:3d} coefficients | n_diurnal={config.n_diurnal} "
+                f"c0={config.annual_per_param['c0']} aₘ/bₘ={config.annual_per_param.get('a1', 0)} "
+                f"λ={config.ridge_lambda:g} | "
+                f"skill {result.report.global_skill:+.4f} rmse {result.report.global_rmse:.4f}"
+            )
+
+    report = sweep_report(results_by_target, basename)
+    return write_sweep_report(report, Path(output_path) if output_path else None)
+
+
+def pack_pipeline(output_path: str | Path | None = None) -> Path:
+    """Bundle every station model under the model directory into one binary pack."""
+
+    ensure_directories()
+    target = Path(output_path) if output_path else MODEL_PACK_PATH
+    return build_model_pack(MODEL_DIR, target)
+
+
 __all__ = [
     "ensure_directories",
     "clean_pipeline",
     "run_pipeline",
     "generate_pipeline",
+    "department_pipeline",
     "regenerate_pipeline",
     "display_pipeline",
     "template_pipeline",
+    "pack_pipeline",
+    "sweep_pipeline",
+    "bench_pipeline",
+    "parity_pipeline",
 ]
@@ -0,0 +1,253 @@
+"""Hyperparameter sweep over nested harmonic bases and ridge lambdas.
+
+The design of a smaller configuration is a column subset of the design at the
+largest orders: every parameter block (c0, a1, b1, ...) keeps its annual basis
+``[1, cos kω_a d, sin kω_a d, ...]`` as a prefix. The per-year ``S``/``b`` are
+therefore accumulated once at the maximal configuration, and each grid point
+is evaluated by LOYO on statistics sliced from them. The native accumulator
+sums each entry of ``S`` independently of the other columns, so the slices
+are the exact statistics of the smaller design. Grid points run on a thread
+pool; the native helpers and LAPACK release the GIL. The report ranks the
+configurations by LOYO skill and lists the Pareto front of skill against
+coefficient count.
+"""
+
+from __future__ import annotations
+
+import json
+import math
+import os
+from concurrent.futures import ThreadPoolExecutor
+from dataclasses import dataclass, field, replace
+from datetime import datetime, timezone
+from pathlib import Path
+from typing import Dict, List, Sequence
+
+import numpy as np
+import pandas as pd
+
+from .config import BENCH_DIR
+from .evaluation import ClimatologyBaseline, evaluate_loyo
+from .training import (
+    LeaveOneYearOutReport,
+    YearlyDesignStats,
+    _parameter_names,
+    build_params_meta,
+    compute_sufficient_stats,
+)
+
+DEFAULT_SWEEP_N_DIURNAL = (1, 2, 3, 4)
+DEFAULT_SWEEP_MEAN_ANNUAL = (1, 2, 3, 4, 5)
+DEFAULT_SWEEP_DIURNAL_ANNUAL = (0, 1, 2, 3)
+DEFAULT_SWEEP_LAMBDAS = (0.0, 1.0, 100.0, 10000.0)
+
+
+@dataclass
+class SweepConfig:
+    """One grid point: diurnal order, annual order per parameter, ridge λ."""
+
+    n_diurnal: int
+    annual_per_param: Dict[str, int]
+    ridge_lambda: float
+
+    def params_meta(self) -> List[Dict[str, int]]:
+        return build_params_meta(
+            n_diurnal=self.n_diurnal,
+            annual_per_param=self.annual_per_param,
+            default_n_annual=0,
+        )
+
+    @property
+    def coefficient_count(self) -> int:
+        return sum(int(entry["length"]) for entry in self.params_meta())
+
+    def as_dict(self) -> Dict[str, object]:
+        return {
+            "n_diurnal": int(self.n_diurnal),
+            "annual_per_param": {name: int(value) for name, value in self.annual_per_param.items()},
+            "ridge_lambda": float(self.ridge_lambda),
+            "coefficients": self.coefficient_count,
+        }
+
+
+@dataclass
+class SweepResult:
+    """LOYO outcome of one grid point."""
+
+    config: SweepConfig
+    report: LeaveOneYearOutReport = field(repr=False)
+
+    def as_dict(self) -> Dict[str, object]:
+        return {
+            **self.config.as_dict(),
+            "loyo_rmse": float(self.report.global_rmse),
+            "loyo_skill": float(self.report.global_skill),
+            "observations": int(self.report.total_observations),
+        }
+
+
+def build_sweep_grid(
+    n_diurnal_values: Sequence[int] = DEFAULT_SWEEP_N_DIURNAL,
+    mean_annual_values: Sequence[int] = DEFAULT_SWEEP_MEAN_ANNUAL,
+    diurnal_annual_values: Sequence[int] = DEFAULT_SWEEP_DIURNAL_ANNUAL,
+    ridge_lambdas: Sequence[float] = DEFAULT_SWEEP_LAMBDAS,
+) -> List[SweepConfig]:
+    """Cartesian grid; ``c0`` takes the mean annual order, every aₘ/bₘ the diurnal one."""
+
+    configs: List[SweepConfig] = []
+    for n_diurnal in n_diurnal_values:
+        names = _parameter_names(int(n_diurnal))
+        for mean_annual in mean_annual_values:
+            for diurnal_annual in diurnal_annual_values:
+                annual_per_param = {name: int(diurnal_annual) for name in names[1:]}
+                annual_per_param["c0"] = int(mean_annual)
+                for ridge_lambda in ridge_lambdas:
+                    configs.append(SweepConfig(int(n_diurnal), dict(annual_per_param), float(ridge_lambda)))
+    return configs
+
+
+def maximal_config(configs: Sequence[SweepConfig]) -> SweepConfig:
+    """Smallest configuration whose design contains every design of ``configs``."""
+
+    if not configs:
+        raise ValueError("The sweep grid is empty.")
+    n_diurnal = max(config.n_diurnal for config in configs)
+    annual_per_param: Dict[str, int] = {}
+    for config in configs:
+        for entry in config.params_meta():
+            name = str(entry["name"])
+            annual_per_param[name] = max(annual_per_param.get(name, 0), int(entry["n_annual"]))
+    return SweepConfig(n_diurnal, annual_per_param, 0.0)
+
+
+def sub_columns(full_meta: List[Dict[str, int]], params_meta: List[Dict[str, int]]) -> np.ndarray:
+    """Columns of the ``full_meta`` design that form the ``params_meta`` design."""
+
+    blocks = {str(entry["name"]): entry for entry in full_meta}
+    columns: List[np.ndarray] = []
+    for entry in params_meta:
+        block = blocks.get(str(entry["name"]))
+        if block is None or int(entry["n_annual"]) > int(block["n_annual"]):
+            raise ValueError(f"Parameter {entry['name']} is not nested in the maximal design.")
+        columns.append(int(block["start"]) + np.arange(int(entry["length"])))
+    return np.concatenate(columns)
+
+
+def slice_stats(
+    stats: Sequence[YearlyDesignStats],
+    full_meta: List[Dict[str, int]],
+    params_meta: List[Dict[str, int]],
+) -> List[YearlyDesignStats]:
+    """Per-year statistics of a nested design, sliced from the maximal ones."""
+
+    columns = sub_columns(full_meta, params_meta)
+    grid = np.ix_(columns, columns)
+    return [
+        replace(entry, S=entry.S[grid], b=entry.b[columns], params_meta=[dict(item) for item in params_meta])
+        for entry in stats
+    ]
+
+
+def run_sweep(
+    df: pd.DataFrame,
+    target: str,
+    configs: Sequence[SweepConfig],
+    *,
+    threads: int | None = None,
+) -> List[SweepResult]:
+    """LOYO of every configuration from one maximal accumulation over ``df``.
+
+    ``df`` must come from :func:`prepare_training_frame`. Results keep the
+    order of ``configs``.
+    """
+
+    largest = maximal_config(configs)
+    full_meta = largest.params_meta()
+    stats = compute_sufficient_stats(
+        df,
+        target=target,
+        n_diurnal=largest.n_diurnal,
+        default_n_annual=0,
+        annual_per_param=largest.annual_per_param,
+        threads=threads,
+    )
+    if not stats:
+        raise ValueError(f"No samples available to sweep target '{target}'.")
+    baseline = ClimatologyBaseline(stats)
+
+    def evaluate(config: SweepConfig) -> SweepResult:
+        sliced = slice_stats(stats, full_meta, config.params_meta())
+        report = evaluate_loyo(
+            sliced,
+            ridge_lambda=config.ridge_lambda,
+            reference_spec={},
+            baseline=baseline,
+        )
+        return SweepResult(config=config, report=report)
+
+    workers = max(1, threads or os.cpu_count() or 1)
+    with ThreadPoolExecutor(max_workers=workers) as pool:
+        return list(pool.map(evaluate, configs))
+
+
+def pareto_front(results: Sequence[SweepResult]) -> List[SweepResult]:
+    """Results no other result beats on skill with as few coefficients, by coefficient count."""
+
+    ranked = sorted(
+        (result for result in results if math.isfinite(result.report.global_skill)),
+        key=lambda result: (result.config.coefficient_count, -result.report.global_skill),
+    )
+    front: List[SweepResult] = []
+    for result in ranked:
+        if not front or result.report.global_skill > front[-1].report.global_skill:
+            front.append(result)
+    return front
+
+
+def sweep_report(results_by_target: Dict[str, List[SweepResult]], station: str) -> Dict[str, object]:
+    """JSON-ready report: every configuration ranked by skill, plus the Pareto front."""
+
+    targets: Dict[str, object] = {}
+    for target, results in results_by_target.items():
+        ranked = sorted(
+            results,
+            key=lambda result: -result.report.global_skill if math.isfinite(result.report.global_skill) else math.inf,
+        )
+        targets[target] = {
+            "configurations": [result.as_dict() for result in ranked],
+            "pareto_front": [result.as_dict() for result in pareto_front(results)],
+        }
+    return {
+        "generated_at": datetime.now(timezone.utc).isoformat(),
+        "station": station,
+        "targets": targets,
+    }
+
+
+def write_sweep_report(report: Dict[str, object], output_path: Path | None = None) -> Path:
+    """Write ``report`` as JSON (default ``generated/bench/<station>_sweep.json``)."""
+
+    path = output_path or BENCH_DIR / f"{report['station']}_sweep.json"
+    path.parent.mkdir(parents=True, exist_ok=True)
+    with open(path, "w", encoding="utf-8") as handle:
+        json.dump(report, handle, indent=2)
+    print(f"[OK] Sweep report written to {path}")
+    return path
+
+
+__all__ = [
+    "DEFAULT_SWEEP_DIURNAL_ANNUAL",
+    "DEFAULT_SWEEP_LAMBDAS",
+    "DEFAULT_SWEEP_MEAN_ANNUAL",
+    "DEFAULT_SWEEP_N_DIURNAL",
+    "SweepConfig",
+    "SweepResult",
+    "build_sweep_grid",
+    "maximal_config",
+    "pareto_front",
+    "run_sweep",
+    "slice_stats",
+    "sub_columns",
+    "sweep_report",
+    "write_sweep_report",
+]
@@ -2,10 +2,381 @@
 
 from __future__ import annotations
 
+import json
 import math
+import re
 from pathlib import Path
 from typing import Iterable, Mapping, Sequence
 
+# Lane abstraction shared by the batch kernels. Each lane type exposes the same
+# small vocabulary (load/store/set1, arithmetic, fmadd, floor, comparisons and
+# select) so that `detail::predict_lanes` is written once and instantiated for
+# AVX-512, AVX2+FMA, NEON (AArch64), or the portable one-lane fallback. The
+# one-lane type and the kernels are constexpr, which gives the generated
+# headers a libm-free path that also works in constant expressions.
+_SIMD_CORE = r"""namespace simd {
+struct f64x1 {
+    static constexpr std::size_t width = 1;
+    using mask = bool;
+    double v;
+    static constexpr f64x1 load(const double* p){ return {*p}; }
+    static constexpr f64x1 set1(double x){ return {x}; }
+    constexpr void store(double* p) const { *p = v; }
+    static constexpr f64x1 select(mask m, f64x1 a, f64x1 b){ return m ? a : b; }
+    friend constexpr f64x1 operator+(f64x1 a, f64x1 b){ return {a.v + b.v}; }
+    friend constexpr f64x1 operator-(f64x1 a, f64x1 b){ return {a.v - b.v}; }
+    friend constexpr f64x1 operator*(f64x1 a, f64x1 b){ return {a.v * b.v}; }
+    friend constexpr f64x1 operator/(f64x1 a, f64x1 b){ return {a.v / b.v}; }
+    friend constexpr f64x1 fmadd(f64x1 a, f64x1 b, f64x1 c){ return {a.v * b.v + c.v}; }
+    friend f64x1 ldexp(f64x1 x, f64x1 n){ return {std::ldexp(x.v, static_cast<int>(n.v))}; }
+    friend f64x1 split_exponent(f64x1 x, f64x1& e){
+        int k = 0;
+        const double m = std::frexp(x.v, &k);
+        e = {static_cast<double>(k - 1)};
+        return {2.0 * m};
+    }
+    friend constexpr f64x1 floor(f64x1 a){
+        // Constant-expression floor; beyond 2^52 every double is already integral.
+        if (!(a.v > -4503599627370496.0 && a.v < 4503599627370496.0)) return a;
+        const double t = static_cast<double>(static_cast<long long>(a.v));
+        return {t > a.v ? t - 1.0 : t};
+    }
+    friend constexpr mask ge(f64x1 a, f64x1 b){ return a.v >= b.v; }
+    friend constexpr mask lt(f64x1 a, f64x1 b){ return a.v < b.v; }
+    friend constexpr mask eq(f64x1 a, f64x1 b){ return a.v == b.v; }
+    friend constexpr double reduce_add(f64x1 a){ return a.v; }
+};
+#if defined(__AVX512F__) && !defined(HARMOCLIMAT_DISABLE_SIMD)
+struct f64x8 {
+    static constexpr std::size_t width = 8;
+    using mask = __mmask8;
+    __m512d v;
+    static f64x8 load(const double* p){ return {_mm512_loadu_pd(p)}; }
+    static f64x8 set1(double x){ return {_mm512_set1_pd(x)}; }
+    void store(double* p) const { _mm512_storeu_pd(p, v); }
+    static f64x8 select(mask m, f64x8 a, f64x8 b){ return {_mm512_mask_blend_pd(m, b.v, a.v)}; }
+    friend f64x8 operator+(f64x8 a, f64x8 b){ return {_mm512_add_pd(a.v, b.v)}; }
+    friend f64x8 operator-(f64x8 a, f64x8 b){ return {_mm512_sub_pd(a.v, b.v)}; }
+    friend f64x8 operator*(f64x8 a, f64x8 b){ return {_mm512_mul_pd(a.v, b.v)}; }
+    friend f64x8 operator/(f64x8 a, f64x8 b){ return {_mm512_div_pd(a.v, b.v)}; }
+    friend f64x8 fmadd(f64x8 a, f64x8 b, f64x8 c){ return {_mm512_fmadd_pd(a.v, b.v, c.v)}; }
+    // Full-mask forms: the unmasked intrinsics trip -Wuninitialized on GCC 12.
+    friend f64x8 ldexp(f64x8 x, f64x8 n){ return {_mm512_mask_scalef_pd(x.v, 0xFF, x.v, n.v)}; }
+    friend f64x8 split_exponent(f64x8 x, f64x8& e){
+        e = {_mm512_mask_getexp_pd(x.v, 0xFF, x.v)};
+        return {_mm512_mask_getmant_pd(x.v, 0xFF, x.v, _MM_MANT_NORM_1_2, _MM_MANT_SIGN_src)};
+    }
+    friend f64x8 floor(f64x8 a){ return {_mm512_mask_roundscale_pd(a.v, 0xFF, a.v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC)}; }
+    friend mask ge(f64x8 a, f64x8 b){ return _mm512_cmp_pd_mask(a.v, b.v, _CMP_GE_OQ); }
+    friend mask lt(f64x8 a, f64x8 b){ return _mm512_cmp_pd_mask(a.v, b.v, _CMP_LT_OQ); }
+    friend mask eq(f64x8 a, f64x8 b){ return _mm512_cmp_pd_mask(a.v, b.v, _CMP_EQ_OQ); }
+    friend double reduce_add(f64x8 a){
+        const __m256d half = _mm256_add_pd(_mm512_maskz_extractf64x4_pd(0xFF, a.v, 0), _mm512_maskz_extractf64x4_pd(0xFF, a.v, 1));
+        const __m128d pair = _mm_add_pd(_mm256_castpd256_pd128(half), _mm256_extractf128_pd(half, 1));
+        return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+    }
+};
+using native = f64x8;
+#elif defined(__AVX2__) && defined(__FMA__) && !defined(HARMOCLIMAT_DISABLE_SIMD)
+struct f64x4 {
+    static constexpr std::size_t width = 4;
+    using mask = __m256d;
+    __m256d v;
+    static f64x4 load(const double* p){ return {_mm256_loadu_pd(p)}; }
+    static f64x4 set1(double x){ return {_mm256_set1_pd(x)}; }
+    void store(double* p) const { _mm256_storeu_pd(p, v); }
+    static f64x4 select(mask m, f64x4 a, f64x4 b){ return {_mm256_blendv_pd(b.v, a.v, m)}; }
+    friend f64x4 operator+(f64x4 a, f64x4 b){ return {_mm256_add_pd(a.v, b.v)}; }
+    friend f64x4 operator-(f64x4 a, f64x4 b){ return {_mm256_sub_pd(a.v, b.v)}; }
+    friend f64x4 operator*(f64x4 a, f64x4 b){ return {_mm256_mul_pd(a.v, b.v)}; }
+    friend f64x4 operator/(f64x4 a, f64x4 b){ return {_mm256_div_pd(a.v, b.v)}; }
+    friend f64x4 fmadd(f64x4 a, f64x4 b, f64x4 c){ return {_mm256_fmadd_pd(a.v, b.v, c.v)}; }
+    friend f64x4 ldexp(f64x4 x, f64x4 n){
+        // n + 1.5 * 2^52 holds n in its low mantissa bits; shifted into the
+        // exponent field and added to x, they scale x by 2^n.
+        const __m256i scale = _mm256_slli_epi64(_mm256_castpd_si256(_mm256_add_pd(n.v, _mm256_set1_pd(6755399441055744.0))), 52);
+        return {_mm256_castsi256_pd(_mm256_add_epi64(_mm256_castpd_si256(x.v), scale))};
+    }
+    friend f64x4 split_exponent(f64x4 x, f64x4& e){
+        const __m256i bits = _mm256_castpd_si256(x.v);
+        const __m256d two_52 = _mm256_set1_pd(4503599627370496.0);
+        const __m256i biased = _mm256_or_si256(_mm256_srli_epi64(bits, 52), _mm256_castpd_si256(two_52));
+        e = {_mm256_sub_pd(_mm256_castsi256_pd(biased), _mm256_add_pd(two_52, _mm256_set1_pd(1023.0)))};
+        const __m256i mantissa = _mm256_and_si256(bits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFFLL));
+        return {_mm256_castsi256_pd(_mm256_or_si256(mantissa, _mm256_set1_epi64x(0x3FF0000000000000LL)))};
+    }
+    friend f64x4 floor(f64x4 a){ return {_mm256_floor_pd(a.v)}; }
+    friend mask ge(f64x4 a, f64x4 b){ return _mm256_cmp_pd(a.v, b.v, _CMP_GE_OQ); }
+    friend mask lt(f64x4 a, f64x4 b){ return _mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ); }
+    friend mask eq(f64x4 a, f64x4 b){ return _mm256_cmp_pd(a.v, b.v, _CMP_EQ_OQ); }
+    friend double reduce_add(f64x4 a){
+        const __m128d pair = _mm_add_pd(_mm256_castpd256_pd128(a.v), _mm256_extractf128_pd(a.v, 1));
+        return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+    }
+};
+using native = f64x4;
+#elif defined(__ARM_NEON) && defined(__aarch64__) && !defined(HARMOCLIMAT_DISABLE_SIMD)
+struct f64x2 {
+    static constexpr std::size_t width = 2;
+    using mask = uint64x2_t;
+    float64x2_t v;
+    static f64x2 load(const double* p){ return {vld1q_f64(p)}; }
+    static f64x2 set1(double x){ return {vdupq_n_f64(x)}; }
+    void store(double* p) const { vst1q_f64(p, v); }
+    static f64x2 select(mask m, f64x2 a, f64x2 b){ return {vbslq_f64(m, a.v, b.v)}; }
+    friend f64x2 operator+(f64x2 a, f64x2 b){ return {vaddq_f64(a.v, b.v)}; }
+    friend f64x2 operator-(f64x2 a, f64x2 b){ return {vsubq_f64(a.v, b.v)}; }
+    friend f64x2 operator*(f64x2 a, f64x2 b){ return {vmulq_f64(a.v, b.v)}; }
+    friend f64x2 operator/(f64x2 a, f64x2 b){ return {vdivq_f64(a.v, b.v)}; }
+    friend f64x2 fmadd(f64x2 a, f64x2 b, f64x2 c){ return {vfmaq_f64(c.v, a.v, b.v)}; }
+    friend f64x2 ldexp(f64x2 x, f64x2 n){
+        const int64x2_t scale = vshlq_n_s64(vcvtq_s64_f64(n.v), 52);
+        return {vreinterpretq_f64_s64(vaddq_s64(vreinterpretq_s64_f64(x.v), scale))};
+    }
+    friend f64x2 split_exponent(f64x2 x, f64x2& e){
+        const uint64x2_t bits = vreinterpretq_u64_f64(x.v);
+        e = {vsubq_f64(vcvtq_f64_u64(vshrq_n_u64(bits, 52)), vdupq_n_f64(1023.0))};
+        const uint64x2_t mantissa = vandq_u64(bits, vdupq_n_u64(0x000FFFFFFFFFFFFFULL));
+        return {vreinterpretq_f64_u64(vorrq_u64(mantissa, vdupq_n_u64(0x3FF0000000000000ULL)))};
+    }
+    friend f64x2 floor(f64x2 a){ return {vrndmq_f64(a.v)}; }
+    friend mask ge(f64x2 a, f64x2 b){ return vcgeq_f64(a.v, b.v); }
+    friend mask lt(f64x2 a, f64x2 b){ return vcltq_f64(a.v, b.v); }
+    friend mask eq(f64x2 a, f64x2 b){ return vceqq_f64(a.v, b.v); }
+    friend double reduce_add(f64x2 a){ return vaddvq_f64(a.v); }
+};
+using native = f64x2;
+#else
+using native = f64x1;
+#endif
+} // namespace simd
+// Polynomial sin/cos: Cody-Waite reduction by pi/2 to [-pi/4, pi/4] followed
+// by the fdlibm kernel polynomials. The 33-bit head of pi/2 times the quadrant
+// count stays exact for |x| <= 2^20 * pi/2 (about 1.6e6), negative x included,
+// and there the error is below 2.5e-16. The basis callers pass angles wrapped
+// to [0, 2*pi); past the bound the error grows with |x|.
+template <class V>
+constexpr void sincos_lanes(V x, V& s, V& c){
+    const V one = V::set1(1.0);
+    const V two = V::set1(2.0);
+    const V q = floor(fmadd(x, V::set1(0.63661977236758134308), V::set1(0.5)));
+    V r = fmadd(q, V::set1(-1.57079632673412561417e+00), x);
+    r = fmadd(q, V::set1(-6.07710050650619224932e-11), r);
+    const V z = r * r;
+    V ps = fmadd(z, V::set1(1.58969099521155010221e-10), V::set1(-2.50507602534068634195e-08));
+    ps = fmadd(z, ps, V::set1(2.75573137070700676789e-06));
+    ps = fmadd(z, ps, V::set1(-1.98412698298579493134e-04));
+    ps = fmadd(z, ps, V::set1(8.33333333332248946124e-03));
+    ps = fmadd(z, ps, V::set1(-1.66666666666666324348e-01));
+    const V sr = fmadd(r * z, ps, r);
+    V pc = fmadd(z, V::set1(-1.13596475577881948265e-11), V::set1(2.08757232129817482790e-09));
+    pc = fmadd(z, pc, V::set1(-2.75573143513906633035e-07));
+    pc = fmadd(z, pc, V::set1(2.48015872894767294178e-05));
+    pc = fmadd(z, pc, V::set1(-1.38888888888741095749e-03));
+    pc = fmadd(z, pc, V::set1(4.16666666666666019037e-02));
+    const V cr = fmadd(z * z, pc, fmadd(z, V::set1(-0.5), one));
+    const V quadrant = fmadd(floor(q * V::set1(0.25)), V::set1(-4.0), q);
+    const V half = V::select(ge(quadrant, two), quadrant - two, quadrant);
+    const auto odd = eq(half, one);
+    const V sin_sign = V::select(ge(quadrant, two), V::set1(-1.0), one);
+    V cos_quadrant = quadrant + one;
+    cos_quadrant = V::select(ge(cos_quadrant, V::set1(4.0)), cos_quadrant - V::set1(4.0), cos_quadrant);
+    const V cos_sign = V::select(ge(cos_quadrant, two), V::set1(-1.0), one);
+    s = V::select(odd, cr, sr) * sin_sign;
+    c = V::select(odd, sr, cr) * cos_sign;
+}
+// [1, cos x, sin x, ..., cos Nx, sin Nx] from cos x and sin x by angle addition.
+template <class V, int N>
+constexpr void harmonic_series_lanes(V c, V s, V (&basis)[2 * N + 1]){
+    basis[0] = V::set1(1.0);
+    for(int k = 1; k <= N; ++k){
+        if (k == 1) {
+            basis[1] = c;
+            basis[2] = s;
+            continue;
+        }
+        basis[2*k - 1] = fmadd(basis[2*k - 3], basis[1], V::set1(0.0) - basis[2*k - 2] * basis[2]);
+        basis[2*k] = fmadd(basis[2*k - 2], basis[1], basis[2*k - 3] * basis[2]);
+    }
+}
+// Lane version of harmonic_basis(): [1, cos x, sin x, ..., cos Nx, sin Nx].
+template <class V, int N>
+constexpr void harmonic_basis_lanes(V angle, V (&basis)[2 * N + 1]){
+    V s = V::set1(0.0), c = V::set1(0.0);
+    sincos_lanes(angle, s, c);
+    harmonic_series_lanes<V, N>(c, s, basis);
+}
+// Phasor (c, s) = (cos x, sin x) advanced to x + d, given cos d and sin d.
+template <class V>
+constexpr void rotate_lanes(V& c, V& s, V cos_d, V sin_d){
+    const V next_c = fmadd(c, cos_d, V::set1(0.0) - s * sin_d);
+    s = fmadd(s, cos_d, c * sin_d);
+    c = next_c;
+}
+// One Newton step of 1/sqrt(c^2 + s^2) around 1: pulls the phasor back to unit
+// length, squaring the relative drift, without a division or a square root.
+template <class V>
+constexpr void renormalize_lanes(V& c, V& s){
+    const V scale = fmadd(fmadd(c, c, s * s), V::set1(-0.5), V::set1(1.5));
+    c = c * scale;
+    s = s * scale;
+}
+// sin(x) / x, with its Taylor expansion near 0. x is not wrapped: window means
+// stay inside the exact range of sincos_lanes for windows up to about 90 years
+// at 15 diurnal harmonics, and past it the reduction error is divided by |x|.
+template <class V>
+inline V sinc_lanes(V x){
+    const V x2 = x * x;
+    const auto small = lt(x2, V::set1(1e-8));
+    V s = V::set1(0.0), c = V::set1(0.0);
+    sincos_lanes(x, s, c);
+    return V::select(small, fmadd(x2, V::set1(-1.0 / 6.0), V::set1(1.0)), s / V::select(small, V::set1(1.0), x));
+}
+// One packed coefficient row ([diurnal term][annual term]) against per-lane bases.
+template <class V, int A, int D>
+constexpr V evaluate_packed_lanes(const double* coeffs, const V (&annual)[A], const V (&diurnal)[D]){
+    V result = V::set1(0.0);
+    for(int p = 0; p < D; ++p){
+        V inner = V::set1(0.0);
+        for(int j = 0; j < A; ++j){
+            inner = fmadd(V::set1(coeffs[p * A + j]), annual[j], inner);
+        }
+        result = fmadd(inner, diurnal[p], result);
+    }
+    return result;
+}
+// exp(x) for |x| < 708: Cody-Waite reduction by ln 2 and a degree-13 Taylor
+// polynomial on |r| <= ln(2)/2 (< 1 ulp before the final rounding).
+template <class V>
+inline V exp_lanes(V x){
+    const V n = floor(fmadd(x, V::set1(1.44269504088896340736), V::set1(0.5)));
+    V r = fmadd(n, V::set1(-6.93147180369123816490e-01), x);
+    r = fmadd(n, V::set1(-1.90821492927058770002e-10), r);
+    V p = V::set1(1.0 / 6227020800.0);
+    const double inverse_factorials[] = {1.0 / 479001600.0, 1.0 / 39916800.0, 1.0 / 3628800.0, 1.0 / 362880.0, 1.0 / 40320.0, 1.0 / 5040.0, 1.0 / 720.0, 1.0 / 120.0, 1.0 / 24.0, 1.0 / 6.0, 0.5, 1.0, 1.0};
+    for(double c : inverse_factorials) p = fmadd(p, r, V::set1(c));
+    return ldexp(p, n);
+}
+// log(x) for positive normal x: x = m * 2^e with m in [sqrt(1/2), sqrt(2)), then
+// log(m) = 2 atanh(s), s = (m - 1) / (m + 1), |s| < 0.172, as an odd series.
+template <class V>
+inline V log_lanes(V x){
+    V e = V::set1(0.0);
+    V m = split_exponent(x, e);
+    const auto high = ge(m, V::set1(1.41421356237309504880));
+    m = V::select(high, m * V::set1(0.5), m);
+    e = V::select(high, e + V::set1(1.0), e);
+    const V s = (m - V::set1(1.0)) / (m + V::set1(1.0));
+    const V z = s * s;
+    V p = V::set1(1.0 / 21.0);
+    const double odd_inverses[] = {1.0 / 19.0, 1.0 / 17.0, 1.0 / 15.0, 1.0 / 13.0, 1.0 / 11.0, 1.0 / 9.0, 1.0 / 7.0, 1.0 / 5.0, 1.0 / 3.0};
+    for(double c : odd_inverses) p = fmadd(p, z, V::set1(c));
+    const V log_m = V::set1(2.0) * fmadd(s * z, p, s);
+    return fmadd(e, V::set1(6.93147180369123816490e-01), fmadd(e, V::set1(1.90821492927058770002e-10), log_m));
+}
+template <class V>
+constexpr V wrap_lanes(V x, double period){
+    const V p = V::set1(period);
+    x = fmadd(floor(x * V::set1(1.0 / period)), V::set1(-period), x);
+    x = V::select(ge(x, p), x - p, x);
+    return V::select(lt(x, V::set1(0.0)), x + p, x);
+}"""
+
+
+_EXTREMES_CORE = r"""// Diurnal series c[0] + sum_m c[2m-1] cos(m x) + c[2m] sin(m x) and its first
+// two derivatives in x.
+template <int N>
+inline void diurnal_series(const double (&c)[2 * N + 1], double x, double& f, double& d1, double& d2){
+    double basis[2 * N + 1];
+    harmonic_basis<N>(x, basis);
+    f = c[0];
+    d1 = 0.0;
+    d2 = 0.0;
+    for(int m = 1; m <= N; ++m){
+        const double even = c[2*m - 1] * basis[2*m - 1] + c[2*m] * basis[2*m];
+        const double odd = c[2*m] * basis[2*m - 1] - c[2*m - 1] * basis[2*m];
+        f += even;
+        d1 += m * odd;
+        d2 -= m * m * even;
+    }
+}
+// Critical points of a diurnal series, isolated on [0, 2*pi) with Lipschitz
+// bounds on f'' and f''' instead of a sampling grid.
+template <int N>
+struct ExtremaSearch {
+    const double (&c)[2 * N + 1];
+    double bound_d2;
+    double bound_d3;
+    DailyExtremes out;
+
+    void consider(double x){
+        double f, d1, d2;
+        diurnal_series<N>(c, x, f, d1, d2);
+        if (f < out.min) { out.min = f; out.hour_of_min_utc = x; }
+        if (f > out.max) { out.max = f; out.hour_of_max_utc = x; }
+    }
+    // Safeguarded Newton on f' inside a bracket where f' is monotonic.
+    void refine(double lo, double hi, double d1_lo){
+        double x = 0.5 * (lo + hi);
+        for(int it = 0; it < 100 && hi - lo > 1e-15; ++it){
+            double f, d1, d2;
+            diurnal_series<N>(c, x, f, d1, d2);
+            if (d1 == 0.0) break;
+            if ((d1 < 0.0) == (d1_lo < 0.0)) lo = x; else hi = x;
+            const double next = d2 != 0.0 ? x - d1 / d2 : lo;
+            x = (next > lo && next < hi) ? next : 0.5 * (lo + hi);
+        }
+        consider(x);
+    }
+    // The interval holds no root of f' when |f'| cannot reach zero across it, and
+    // at most one when f' is monotonic; anything else is bisected.
+    void search(double lo, double hi, double d1_lo, double d2_lo, double d1_hi, double d2_hi, int depth){
+        const double width = hi - lo;
+        if (std::fabs(d1_lo) + std::fabs(d1_hi) > bound_d2 * width) return;
+        if (std::fabs(d2_lo) + std::fabs(d2_hi) > bound_d3 * width) {
+            if ((d1_lo < 0.0) != (d1_hi < 0.0) || d1_lo == 0.0 || d1_hi == 0.0) refine(lo, hi, d1_lo);
+            return;
+        }
+        const double mid = 0.5 * (lo + hi);
+        if (depth >= 48) {
+            consider(mid);
+            return;
+        }
+        double f, d1_mid, d2_mid;
+        diurnal_series<N>(c, mid, f, d1_mid, d2_mid);
+        search(lo, mid, d1_lo, d2_lo, d1_mid, d2_mid, depth + 1);
+        search(mid, hi, d1_mid, d2_mid, d1_hi, d2_hi, depth + 1);
+    }
+};
+// Daily mean (the constant term, exact over a full period) and extrema of a
+// diurnal series, with the hours of the extrema converted back to UTC.
+template <int N>
+inline DailyExtremes diurnal_extremes(const double (&c)[2 * N + 1], double delta_utc_solar_h){
+    double f0, d1_lo, d2_lo;
+    diurnal_series<N>(c, 0.0, f0, d1_lo, d2_lo);
+    ExtremaSearch<N> search{c, 0.0, 0.0, {c[0], f0, f0, 0.0, 0.0}};
+    for(int m = 1; m <= N; ++m){
+        const double amplitude = std::sqrt(c[2*m - 1] * c[2*m - 1] + c[2*m] * c[2*m]);
+        search.bound_d2 += m * m * amplitude;
+        search.bound_d3 += m * m * m * amplitude;
+    }
+    if (search.bound_d2 > 0.0) {
+        const int pieces = 8 * N;
+        for(int i = 0; i < pieces; ++i){
+            const double lo = two_pi * i / pieces;
+            const double hi = two_pi * (i + 1) / pieces;
+            double f, d1_hi, d2_hi;
+            diurnal_series<N>(c, hi, f, d1_hi, d2_hi);
+            search.search(lo, hi, d1_lo, d2_lo, d1_hi, d2_hi, 0);
+            d1_lo = d1_hi;
+            d2_lo = d2_hi;
+        }
+    }
+    search.out.hour_of_min_utc = wrap_hour(search.out.hour_of_min_utc / omega_diurnal - delta_utc_solar_h);
+    search.out.hour_of_max_utc = wrap_hour(search.out.hour_of_max_utc / omega_diurnal - delta_utc_solar_h);
+    return search.out;
+}"""
+
 
 def _format_array(values: Sequence[float], indent: str = "    ", per_line: int = 6) -> str:
     formatted = [f"{float(v):.17g}" for v in values]
@@ -55,20 +426,26 @@ def _generate_model_namespace(namespace: str, payload: Mapping[str, object]) ->
         lines.append("};")
 
     lines.append("inline double evaluate(double day_solar, double hour_solar) {")
-    lines.append("    double result = detail::eval_annual(c0_coeffs, c0_coeffs_n_annual, day_solar);")
-    lines.append("    const double ome_d = detail::omega_diurnal;")
+    lines.append("    double annual[detail::annual_basis_size], diurnal[detail::diurnal_basis_size];")
+    lines.append(
+        "    detail::harmonic_basis<detail::max_annual_harmonics>(detail::omega_annual * day_solar, annual);"
+    )
+    lines.append(
+        "    detail::harmonic_basis<detail::max_diurnal_harmonics>(detail::omega_diurnal * hour_solar, diurnal);"
+    )
+    lines.append("    double result = detail::eval_annual(c0_coeffs, c0_coeffs_n_annual, annual);")
     for m in range(1, n_diurnal + 1):
         cos_name = f"a{m}"
         sin_name = f"b{m}"
         if cos_name in entry_map:
             lines.append(
-                f"    result += detail::eval_annual({cos_name}_coeffs, {cos_name}_coeffs_n_annual, day_solar) * "
-                f"std::cos({m} * ome_d * hour_solar);"
+                f"    result += detail::eval_annual({cos_name}_coeffs, {cos_name}_coeffs_n_annual, annual) * "
+                f"diurnal[{2 * m - 1}];"
             )
         if sin_name in entry_map:
             lines.append(
-                f"    result += detail::eval_annual({sin_name}_coeffs, {sin_name}_coeffs_n_annual, day_solar) * "
-                f"std::sin({m} * ome_d * hour_solar);"
+                f"    result += detail::eval_annual({sin_name}_coeffs, {sin_name}_coeffs_n_annual, annual) * "
+                f"diurnal[{2 * m}];"
             )
     lines.append("    return result;")
     lines.append("}")
@@ -76,6 +453,849 @@ def _generate_model_namespace(namespace: str, payload: Mapping[str, object]) ->
     return lines
 
 
+def packed_coefficients(payload: Mapping[str, object], max_annual: int, max_diurnal: int) -> list[float]:
+    """Lay a target out as [diurnal term][annual term], zero-padding missing entries.
+
+    Diurnal terms follow the basis order (c0, a1, b1, a2, b2, ...) and annual
+    terms the coefficient order (constant, cos 1, sin 1, cos 2, sin 2, ...).
+    """
+
+    annual_size = 2 * max_annual + 1
+    entry_map = {entry["name"]: entry for entry in _extract_parameters(payload)}
+    names = ["c0"]
+    for m in range(1, max_diurnal + 1):
+        names.extend([f"a{m}", f"b{m}"])
+
+    packed: list[float] = []
+    for name in names:
+        row = [0.0] * annual_size
+        entry = entry_map.get(name)
+        if entry is not None:
+            coeffs = entry["coefficients"]
+            row[: len(coeffs)] = coeffs
+        packed.extend(row)
+    return packed
+
+
+def max_harmonics(payloads: Sequence[Mapping[str, object]]) -> tuple[int, int]:
+    """Return the largest (annual, diurnal) harmonic orders used across targets."""
+
+    max_annual = 0
+    max_diurnal = 0
+    for payload in payloads:
+        max_diurnal = max(max_diurnal, int(payload["model"]["n_diurnal"]))  # type: ignore[index]
+        for entry in _extract_parameters(payload):
+            max_annual = max(max_annual, int(entry["n_annual"]))
+    return max_annual, max_diurnal
+
+
+def station_namespace(header_path: Path) -> str:
+    """C++ namespace of a station header, derived from its file name (``fr_bourges``)."""
+
+    name = re.sub(r"\W", "_", header_path.stem)
+    if not name or name[0].isdigit():
+        name = f"station_{name}"
+    return name
+
+
+def _generate_day_profile() -> list[str]:
+    """Emit DayProfile, the per-day collapse of the annual series, and its year table."""
+
+    lines: list[str] = []
+    lines.append("namespace detail {")
+    lines.append("static constexpr int year_profile_days = 366;")
+    lines.append("template <class V>")
+    lines.append(
+        "inline void day_profile_lanes(const double (&coeffs)[n_targets][diurnal_basis_size], "
+        "const double* hour_utc, double* temperature_c, double* specific_humidity_kg_kg, double* pressure_hpa){"
+    )
+    lines.append("    const V hour_solar = wrap_lanes(V::load(hour_utc) + V::set1(delta_utc_solar_h), 24.0);")
+    lines.append("    V diurnal[diurnal_basis_size];")
+    lines.append("    harmonic_basis_lanes<V, max_diurnal_harmonics>(hour_solar * V::set1(omega_diurnal), diurnal);")
+    lines.append("    double* outputs[n_targets] = {temperature_c, specific_humidity_kg_kg, pressure_hpa};")
+    lines.append("    for(int t = 0; t < n_targets; ++t){")
+    lines.append("        V value = V::set1(0.0);")
+    lines.append("        for(int p = 0; p < diurnal_basis_size; ++p){")
+    lines.append("            value = fmadd(V::set1(coeffs[t][p]), diurnal[p], value);")
+    lines.append("        }")
+    lines.append("        value.store(outputs[t]);")
+    lines.append("    }")
+    lines.append("}")
+    lines.append("} // namespace detail")
+    lines.append("// Annual series of every target evaluated once for a solar day, leaving the")
+    lines.append("// diurnal Fourier coefficients (c0, a1, b1, a2, b2, ...). Each hour of that day")
+    lines.append("// then costs one diurnal sincos and a short dot product per target.")
+    lines.append("struct DayProfile {")
+    lines.append("    double day_solar = 0.0;")
+    lines.append("    double coeffs[detail::n_targets][detail::diurnal_basis_size] = {};")
+    lines.append("    static DayProfile from_solar_day(double day_solar){")
+    lines.append("        DayProfile profile;")
+    lines.append("        profile.day_solar = day_solar;")
+    lines.append("        double annual[detail::annual_basis_size];")
+    lines.append(
+        "        detail::harmonic_basis<detail::max_annual_harmonics>(detail::omega_annual * day_solar, annual);"
+    )
+    lines.append("        for(int t = 0; t < detail::n_targets; ++t){")
+    lines.append("            for(int p = 0; p < detail::diurnal_basis_size; ++p){")
+    lines.append("                const double* row = detail::packed_coeffs[t] + p * detail::annual_basis_size;")
+    lines.append("                double value = 0.0;")
+    lines.append("                for(int j = 0; j < detail::annual_basis_size; ++j){")
+    lines.append("                    value += row[j] * annual[j];")
+    lines.append("                }")
+    lines.append("                profile.coeffs[t][p] = value;")
+    lines.append("            }")
+    lines.append("        }")
+    lines.append("        return profile;")
+    lines.append("    }")
+    lines.append("    // Same day convention as predict(): only day_utc selects the solar day.")
+    lines.append("    static DayProfile from_utc_day(double day_utc){")
+    lines.append("        return from_solar_day(detail::wrap_day(day_utc + (delta_utc_solar_h / 24.0)));")
+    lines.append("    }")
+    lines.append(
+        "    void predict(double hour_utc, double& temperature_c, double& specific_humidity_kg_kg, "
+        "double& pressure_hpa) const {"
+    )
+    lines.append("        double diurnal[detail::diurnal_basis_size];")
+    lines.append("        const double hour_solar = detail::wrap_hour(hour_utc + delta_utc_solar_h);")
+    lines.append(
+        "        detail::harmonic_basis<detail::max_diurnal_harmonics>(detail::omega_diurnal * hour_solar, diurnal);"
+    )
+    lines.append("        double values[detail::n_targets];")
+    lines.append("        for(int t = 0; t < detail::n_targets; ++t){")
+    lines.append("            double value = 0.0;")
+    lines.append("            for(int p = 0; p < detail::diurnal_basis_size; ++p){")
+    lines.append("                value += coeffs[t][p] * diurnal[p];")
+    lines.append("            }")
+    lines.append("            values[t] = value;")
+    lines.append("        }")
+    lines.append("        temperature_c = values[0];")
+    lines.append("        specific_humidity_kg_kg = values[1];")
+    lines.append("        pressure_hpa = values[2];")
+    lines.append("    }")
+    lines.append(
+        "    void predict_batch(const double* hour_utc, std::size_t count, double* temperature_c, "
+        "double* specific_humidity_kg_kg, double* pressure_hpa) const {"
+    )
+    lines.append("        using V = detail::simd::native;")
+    lines.append("        std::size_t i = 0;")
+    lines.append("        for (; i + V::width <= count; i += V::width) {")
+    lines.append(
+        "            detail::day_profile_lanes<V>(coeffs, hour_utc + i, temperature_c + i, "
+        "specific_humidity_kg_kg + i, pressure_hpa + i);"
+    )
+    lines.append("        }")
+    lines.append("        const std::size_t rem = count - i;  // fewer than V::width left")
+    lines.append("        for (std::size_t k = 0; k < rem; ++k, ++i) {")
+    lines.append(
+        "            detail::day_profile_lanes<detail::simd::f64x1>(coeffs, hour_utc + i, temperature_c + i, "
+        "specific_humidity_kg_kg + i, pressure_hpa + i);"
+    )
+    lines.append("        }")
+    lines.append("    }")
+    lines.append("    // Exact daily mean, min and max of every target for this solar day, with the")
+    lines.append("    // UTC hours of the extrema (see detail::diurnal_extremes).")
+    lines.append("    DailyStats stats() const {")
+    lines.append("        return {")
+    lines.append("            detail::diurnal_extremes<detail::max_diurnal_harmonics>(coeffs[0], delta_utc_solar_h),")
+    lines.append("            detail::diurnal_extremes<detail::max_diurnal_harmonics>(coeffs[1], delta_utc_solar_h),")
+    lines.append("            detail::diurnal_extremes<detail::max_diurnal_harmonics>(coeffs[2], delta_utc_solar_h),")
+    lines.append("        };")
+    lines.append("    }")
+    lines.append("};")
+    lines.append("// DayProfile of every integer solar day 0..365 (the last covers the trailing")
+    lines.append("// 0.24 day of the solar year). Lookups floor the solar day like the Python")
+    lines.append("// display helpers, so results differ from predict() by up to one day of")
+    lines.append("// annual drift. Roughly 64 KiB; build it once and share it.")
+    lines.append("struct YearProfiles {")
+    lines.append("    DayProfile days[detail::year_profile_days];")
+    lines.append("    YearProfiles(){")
+    lines.append("        for(int d = 0; d < detail::year_profile_days; ++d){")
+    lines.append("            days[d] = DayProfile::from_solar_day(static_cast<double>(d));")
+    lines.append("        }")
+    lines.append("    }")
+    lines.append("    const DayProfile& for_utc_day(double day_utc) const {")
+    lines.append("        const double day_solar = detail::wrap_day(day_utc + (delta_utc_solar_h / 24.0));")
+    lines.append("        return days[static_cast<int>(day_solar)];")
+    lines.append("    }")
+    lines.append("};")
+    lines.append("// Daily statistics of every integer solar day 0..365 in one pass over the year;")
+    lines.append("// entry d describes the same day as YearProfiles::days[d].")
+    lines.append("inline void year_daily_stats(DailyStats (&stats)[detail::year_profile_days]){")
+    lines.append("    for(int d = 0; d < detail::year_profile_days; ++d){")
+    lines.append("        stats[d] = DayProfile::from_solar_day(static_cast<double>(d)).stats();")
+    lines.append("    }")
+    lines.append("}")
+    return lines
+
+
+def _generate_time_series_stepper() -> list[str]:
+    """Emit TimeSeriesStepper, the trig-free fixed-step series over rotating phasors."""
+
+    return r"""namespace detail {
+static constexpr std::size_t stepper_renormalize_interval = 256;
+template <class V>
+inline void stepper_lanes(V annual_cos, V annual_sin, V diurnal_cos, V diurnal_sin, double* temperature_c, double* specific_humidity_kg_kg, double* pressure_hpa){
+    V annual[annual_basis_size], diurnal[diurnal_basis_size];
+    harmonic_series_lanes<V, max_annual_harmonics>(annual_cos, annual_sin, annual);
+    harmonic_series_lanes<V, max_diurnal_harmonics>(diurnal_cos, diurnal_sin, diurnal);
+    double* outputs[n_targets] = {temperature_c, specific_humidity_kg_kg, pressure_hpa};
+    for(int t = 0; t < n_targets; ++t){
+        evaluate_packed_lanes(packed_coeffs[t], annual, diurnal).store(outputs[t]);
+    }
+}
+} // namespace detail
+// Fixed-step series: element n is predict(day_utc + n * step_hours / 24,
+// hour_utc + n * step_hours), i.e. continuous time t = day_utc * 24 advanced
+// in step_hours increments. The annual and diurnal phasors advance by one
+// complex multiplication per step, so no trig runs after construction; every
+// detail::stepper_renormalize_interval steps they are pulled back to unit length.
+// Iterate it in a range-for, or use fill() for whole series (SIMD across steps).
+struct TimeSeriesStepper {
+    double annual_angle = 0.0;
+    double diurnal_angle = 0.0;
+    double annual_step = 0.0;
+    double diurnal_step = 0.0;
+    std::size_t count = 0;
+
+    struct iterator {
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Prediction;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Prediction*;
+        using reference = Prediction;
+
+        std::size_t index = 0;
+        double annual_cos = 1.0, annual_sin = 0.0;
+        double diurnal_cos = 1.0, diurnal_sin = 0.0;
+        double annual_step_cos = 1.0, annual_step_sin = 0.0;
+        double diurnal_step_cos = 1.0, diurnal_step_sin = 0.0;
+
+        Prediction operator*() const {
+            using V = detail::simd::f64x1;
+            Prediction out{0.0, 0.0, 0.0};
+            detail::stepper_lanes<V>(V::set1(annual_cos), V::set1(annual_sin), V::set1(diurnal_cos), V::set1(diurnal_sin), &out.temperature_c, &out.specific_humidity_kg_kg, &out.pressure_hpa);
+            return out;
+        }
+        iterator& operator++(){
+            using V = detail::simd::f64x1;
+            V ac = V::set1(annual_cos), as = V::set1(annual_sin);
+            V dc = V::set1(diurnal_cos), ds = V::set1(diurnal_sin);
+            detail::rotate_lanes(ac, as, V::set1(annual_step_cos), V::set1(annual_step_sin));
+            detail::rotate_lanes(dc, ds, V::set1(diurnal_step_cos), V::set1(diurnal_step_sin));
+            if (++index % detail::stepper_renormalize_interval == 0) {
+                detail::renormalize_lanes(ac, as);
+                detail::renormalize_lanes(dc, ds);
+            }
+            annual_cos = ac.v; annual_sin = as.v;
+            diurnal_cos = dc.v; diurnal_sin = ds.v;
+            return *this;
+        }
+        iterator operator++(int){
+            iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+        friend bool operator==(const iterator& a, const iterator& b){ return a.index == b.index; }
+        friend bool operator!=(const iterator& a, const iterator& b){ return a.index != b.index; }
+    };
+
+    TimeSeriesStepper(double day_utc, double hour_utc, double step_hours, std::size_t steps)
+        : annual_angle(detail::omega_annual * detail::wrap_day(day_utc + (delta_utc_solar_h / 24.0))),
+          diurnal_angle(detail::omega_diurnal * detail::wrap_hour(hour_utc + delta_utc_solar_h)),
+          annual_step(detail::omega_annual * (step_hours / 24.0)),
+          diurnal_step(detail::omega_diurnal * step_hours),
+          count(steps) {}
+
+    std::size_t size() const { return count; }
+    iterator begin() const {
+        iterator it;
+        it.annual_cos = std::cos(annual_angle);
+        it.annual_sin = std::sin(annual_angle);
+        it.diurnal_cos = std::cos(diurnal_angle);
+        it.diurnal_sin = std::sin(diurnal_angle);
+        it.annual_step_cos = std::cos(annual_step);
+        it.annual_step_sin = std::sin(annual_step);
+        it.diurnal_step_cos = std::cos(diurnal_step);
+        it.diurnal_step_sin = std::sin(diurnal_step);
+        return it;
+    }
+    iterator end() const {
+        iterator it;
+        it.index = count;
+        return it;
+    }
+
+    // Writes size() values per output. Lane i of each SIMD block starts i steps
+    // ahead and every block rotates all lanes by V::width steps.
+    void fill(double* temperature_c, double* specific_humidity_kg_kg, double* pressure_hpa) const {
+        using V = detail::simd::native;
+        constexpr std::size_t width = V::width;
+        double lane_annual_cos[width], lane_annual_sin[width], lane_diurnal_cos[width], lane_diurnal_sin[width];
+        for(std::size_t i = 0; i < width; ++i){
+            const double lane = static_cast<double>(i);
+            lane_annual_cos[i] = std::cos(annual_angle + lane * annual_step);
+            lane_annual_sin[i] = std::sin(annual_angle + lane * annual_step);
+            lane_diurnal_cos[i] = std::cos(diurnal_angle + lane * diurnal_step);
+            lane_diurnal_sin[i] = std::sin(diurnal_angle + lane * diurnal_step);
+        }
+        V ac = V::load(lane_annual_cos), as = V::load(lane_annual_sin);
+        V dc = V::load(lane_diurnal_cos), ds = V::load(lane_diurnal_sin);
+        const double block = static_cast<double>(width);
+        const V annual_block_cos = V::set1(std::cos(block * annual_step));
+        const V annual_block_sin = V::set1(std::sin(block * annual_step));
+        const V diurnal_block_cos = V::set1(std::cos(block * diurnal_step));
+        const V diurnal_block_sin = V::set1(std::sin(block * diurnal_step));
+        constexpr std::size_t renormalize_blocks = (detail::stepper_renormalize_interval + width - 1) / width;
+        std::size_t i = 0;
+        for (std::size_t blocks = 1; i + width <= count; i += width, ++blocks) {
+            detail::stepper_lanes<V>(ac, as, dc, ds, temperature_c + i, specific_humidity_kg_kg + i, pressure_hpa + i);
+            detail::rotate_lanes(ac, as, annual_block_cos, annual_block_sin);
+            detail::rotate_lanes(dc, ds, diurnal_block_cos, diurnal_block_sin);
+            if (blocks % renormalize_blocks == 0) {
+                detail::renormalize_lanes(ac, as);
+                detail::renormalize_lanes(dc, ds);
+            }
+        }
+        if (i < count) {
+            double tail[detail::n_targets][width];
+            detail::stepper_lanes<V>(ac, as, dc, ds, tail[0], tail[1], tail[2]);
+            const std::size_t rem = count - i;  // fewer than width left
+            for(std::size_t k = 0; k < rem; ++k){
+                temperature_c[i + k] = tail[0][k];
+                specific_humidity_kg_kg[i + k] = tail[1][k];
+                pressure_hpa[i + k] = tail[2][k];
+            }
+        }
+    }
+#if defined(__cpp_lib_span)
+    // Span overload; every span must hold at least size() elements.
+    void fill(std::span<double> temperature_c, std::span<double> specific_humidity_kg_kg, std::span<double> pressure_hpa) const {
+        fill(temperature_c.data(), specific_humidity_kg_kg.data(), pressure_hpa.data());
+    }
+#endif
+};""".splitlines()
+
+
+def _generate_timestamp_api() -> list[str]:
+    """Unix-second and std::chrono overloads on the Python solar-time definition."""
+
+    return [
+        "// Timestamp entry points. These follow harmoclimate.core.compute_solar_time, the",
+        "// definition the model was fitted on, which shifts the day by longitude / 360 of a",
+        "// year rather than by delta_utc_solar_h / 24 as the (day_utc, hour_utc) overloads do.",
+        "// Sub-second parts are dropped, as in the Python path.",
+        "inline SolarTime solar_time(std::int64_t unix_seconds){",
+        "    return detail::solar_time_from_unix(unix_seconds, longitude_deg);",
+        "}",
+        "inline void solar_time_batch(const std::int64_t* unix_seconds, std::size_t count, double* day_solar, double* hour_solar){",
+        "    for (std::size_t i = 0; i < count; ++i) {",
+        "        const SolarTime solar = solar_time(unix_seconds[i]);",
+        "        day_solar[i] = solar.day;",
+        "        hour_solar[i] = solar.hour;",
+        "    }",
+        "}",
+        "inline void predict(std::int64_t unix_seconds, double& temperature_c, double& specific_humidity_kg_kg, "
+        "double& pressure_hpa){",
+        "    const SolarTime solar = solar_time(unix_seconds);",
+        "    double values[detail::n_targets];",
+        "    detail::evaluate_fused(solar.day, solar.hour, values);",
+        "    temperature_c = values[0];",
+        "    specific_humidity_kg_kg = values[1];",
+        "    pressure_hpa = values[2];",
+        "}",
+        "inline void predict_batch(const std::int64_t* unix_seconds, std::size_t count, double* temperature_c, "
+        "double* specific_humidity_kg_kg, double* pressure_hpa){",
+        "    using V = detail::simd::native;",
+        "    alignas(64) double day_solar[V::width], hour_solar[V::width];",
+        "    std::size_t i = 0;",
+        "    for (; i + V::width <= count; i += V::width) {",
+        "        solar_time_batch(unix_seconds + i, V::width, day_solar, hour_solar);",
+        "        detail::predict_solar_lanes(V::load(day_solar), V::load(hour_solar), temperature_c + i, "
+        "specific_humidity_kg_kg + i, pressure_hpa + i);",
+        "    }",
+        "    const std::size_t rem = count - i;  // fewer than V::width left",
+        "    for (std::size_t k = 0; k < rem; ++k, ++i) {",
+        "        const SolarTime solar = solar_time(unix_seconds[i]);",
+        "        detail::predict_solar_lanes(detail::simd::f64x1::set1(solar.day), detail::simd::f64x1::set1(solar.hour), ",
+        "                                    temperature_c + i, specific_humidity_kg_kg + i, pressure_hpa + i);",
+        "    }",
+        "}",
+        "#if __cplusplus >= 202002L",
+        "template <class Duration>",
+        "inline SolarTime solar_time(std::chrono::sys_time<Duration> time){",
+        "    return solar_time(std::chrono::floor<std::chrono::seconds>(time).time_since_epoch().count());",
+        "}",
+        "template <class Duration>",
+        "inline void predict(std::chrono::sys_time<Duration> time, double& temperature_c, double& specific_humidity_kg_kg, "
+        "double& pressure_hpa){",
+        "    predict(std::chrono::floor<std::chrono::seconds>(time).time_since_epoch().count(), temperature_c, "
+        "specific_humidity_kg_kg, pressure_hpa);",
+        "}",
+        "#endif",
+    ]
+
+
+def _generate_score() -> list[str]:
+    """Batched residual scoring of observations against the error envelope."""
+
+    return [
+        "namespace detail {",
+        "// 1.6448536... = Phi^-1(0.95): a Gaussian with the envelope's 90% band has this sigma.",
+        "static constexpr double envelope_z95 = 1.6448536269514722;",
+        "template <class V>",
+        "inline void score_lanes(const std::int64_t* unix_seconds, std::size_t i, const Observations& observations,",
+        "                        const ScoreOutputs& outputs){",
+        "    alignas(64) double day_solar[V::width], hour_solar[V::width];",
+        "    for (std::size_t l = 0; l < V::width; ++l) {",
+        "        const SolarTime solar = solar_time_from_unix(unix_seconds[i + l], longitude_deg);",
+        "        day_solar[l] = solar.day;",
+        "        hour_solar[l] = solar.hour;",
+        "    }",
+        "    alignas(64) double predicted[n_targets][V::width];",
+        "    predict_solar_lanes(V::load(day_solar), V::load(hour_solar), predicted[0], predicted[1], predicted[2]);",
+        "    const double* observed[n_targets] = {observations.temperature_c, observations.specific_humidity_kg_kg,",
+        "                                         observations.pressure_hpa};",
+        "    std::uint8_t flags[V::width] = {};",
+        "    for(int t = 0; t < n_targets; ++t){",
+        "        if (!observed[t]) continue;",
+        "        const ErrorEnvelope& envelope = error_envelope[t];",
+        "        const V residual = V::load(observed[t] + i) - V::load(predicted[t]);",
+        "        if (outputs.residual[t]) residual.store(outputs.residual[t] + i);",
+        "        if (outputs.standardized[t]) {",
+        "            const double center = 0.5 * (envelope.p05 + envelope.p95);",
+        "            const double inverse_sigma = 2.0 * envelope_z95 / (envelope.p95 - envelope.p05);",
+        "            ((residual - V::set1(center)) * V::set1(inverse_sigma)).store(outputs.standardized[t] + i);",
+        "        }",
+        "        if (outputs.out_of_band) {",
+        "            alignas(64) double lanes[V::width];",
+        "            residual.store(lanes);",
+        "            for (std::size_t l = 0; l < V::width; ++l) {",
+        "                const bool outside = lanes[l] < envelope.p05 || lanes[l] > envelope.p95;",
+        "                flags[l] = static_cast<std::uint8_t>(flags[l] | (outside ? 1u << t : 0u));",
+        "            }",
+        "        }",
+        "    }",
+        "    if (outputs.out_of_band) {",
+        "        for (std::size_t l = 0; l < V::width; ++l) outputs.out_of_band[i + l] = flags[l];",
+        "    }",
+        "}",
+        "} // namespace detail",
+        "// Scores observations taken at Unix timestamps against the model and its",
+        "// error_envelope in one vectorised pass. The residual is observed - predicted,",
+        "// on the same solar-time definition as training. The standardized score centres it",
+        "// on the [p05, p95] band and divides by that band's Gaussian sigma, so up to",
+        "// rounding at the edges |score| > 1.645 exactly when the out-of-band bit is set.",
+        "// NaN observations give NaN residuals and no flag.",
+        "inline void score(const Observations& observations, const std::int64_t* unix_seconds, std::size_t count,",
+        "                  const ScoreOutputs& outputs){",
+        "    using V = detail::simd::native;",
+        "    std::size_t i = 0;",
+        "    for (; i + V::width <= count; i += V::width) {",
+        "        detail::score_lanes<V>(unix_seconds, i, observations, outputs);",
+        "    }",
+        "    const std::size_t rem = count - i;  // fewer than V::width left",
+        "    for (std::size_t k = 0; k < rem; ++k, ++i) {",
+        "        detail::score_lanes<detail::simd::f64x1>(unix_seconds, i, observations, outputs);",
+        "    }",
+        "}",
+    ]
+
+
+def _generate_constexpr_api() -> list[str]:
+    """Emit the constant-expression entry points built on the one-lane kernels."""
+
+    lines: list[str] = []
+    lines.append("// Same model as predict(), through the libm-free one-lane kernels, so it can run")
+    lines.append("// in constant expressions; at runtime it agrees with predict() up to rounding.")
+    lines.append("constexpr Prediction predict_constexpr(double day_utc, double hour_utc){")
+    lines.append("    Prediction out{0.0, 0.0, 0.0};")
+    lines.append(
+        "    detail::predict_lanes<detail::simd::f64x1>(&day_utc, &hour_utc, &out.temperature_c, "
+        "&out.specific_humidity_kg_kg, &out.pressure_hpa);"
+    )
+    lines.append("    return out;")
+    lines.append("}")
+    lines.append("#if defined(__cpp_consteval)")
+    lines.append("// Compile-time table for ROM images, e.g. 8760 hourly values:")
+    lines.append("//   static constexpr auto table = year_grid();")
+    lines.append("// The annual series are collapsed once per day and the diurnal basis once per step.")
+    lines.append("template <int Days = 365, int StepsPerDay = 24>")
+    lines.append("consteval YearGrid<Days, StepsPerDay> year_grid(){")
+    lines.append("    using V = detail::simd::f64x1;")
+    lines.append("    YearGrid<Days, StepsPerDay> grid{};")
+    lines.append("    double diurnal[StepsPerDay][detail::diurnal_basis_size] = {};")
+    lines.append("    for(int step = 0; step < StepsPerDay; ++step){")
+    lines.append(
+        "        const V hour_solar = detail::wrap_lanes(V::set1(step * (24.0 / StepsPerDay) + delta_utc_solar_h), 24.0);"
+    )
+    lines.append("        V basis[detail::diurnal_basis_size] = {};")
+    lines.append(
+        "        detail::harmonic_basis_lanes<V, detail::max_diurnal_harmonics>("
+        "hour_solar * V::set1(detail::omega_diurnal), basis);"
+    )
+    lines.append("        for(int p = 0; p < detail::diurnal_basis_size; ++p) diurnal[step][p] = basis[p].v;")
+    lines.append("    }")
+    lines.append("    // Plain doubles below: constant evaluation cost is what limits the grid size.")
+    lines.append("    for(int day = 0; day < Days; ++day){")
+    lines.append(
+        "        const V day_solar = detail::wrap_lanes(V::set1(day + delta_utc_solar_h / 24.0), "
+        "detail::solar_year_days);"
+    )
+    lines.append("        V annual[detail::annual_basis_size] = {};")
+    lines.append(
+        "        detail::harmonic_basis_lanes<V, detail::max_annual_harmonics>("
+        "day_solar * V::set1(detail::omega_annual), annual);"
+    )
+    lines.append("        double day_coeffs[detail::n_targets][detail::diurnal_basis_size] = {};")
+    lines.append("        for(int t = 0; t < detail::n_targets; ++t){")
+    lines.append("            for(int p = 0; p < detail::diurnal_basis_size; ++p){")
+    lines.append("                const double* row = detail::packed_coeffs[t] + p * detail::annual_basis_size;")
+    lines.append("                double inner = 0.0;")
+    lines.append("                for(int j = 0; j < detail::annual_basis_size; ++j) inner += row[j] * annual[j].v;")
+    lines.append("                day_coeffs[t][p] = inner;")
+    lines.append("            }")
+    lines.append("        }")
+    lines.append("        for(int step = 0; step < StepsPerDay; ++step){")
+    lines.append("            double values[detail::n_targets] = {};")
+    lines.append("            for(int t = 0; t < detail::n_targets; ++t){")
+    lines.append("                for(int p = 0; p < detail::diurnal_basis_size; ++p){")
+    lines.append("                    values[t] += day_coeffs[t][p] * diurnal[step][p];")
+    lines.append("                }")
+    lines.append("            }")
+    lines.append("            const std::size_t index = static_cast<std::size_t>(day) * StepsPerDay + step;")
+    lines.append("            grid.temperature_c[index] = values[0];")
+    lines.append("            grid.specific_humidity_kg_kg[index] = values[1];")
+    lines.append("            grid.pressure_hpa[index] = values[2];")
+    lines.append("        }")
+    lines.append("    }")
+    lines.append("    return grid;")
+    lines.append("}")
+    lines.append("#endif")
+    return lines
+
+
+def _generate_window_integrals() -> list[str]:
+    """Closed-form integrals and means of T, Q and P over time windows."""
+
+    return [
+        "namespace detail {",
+        "// Window mean of every target. Each packed term is a product of an annual and a",
+        "// diurnal sinusoid, i.e. two sinusoids of frequencies k*omega_d +/- m*omega_a/24",
+        "// (per hour); over a window of half-length h a sinusoid averages to its midpoint",
+        "// value times sinc(frequency * h). Regrouped on the midpoint bases, with S and D the",
+        "// half sum and half difference of the two sinc factors:",
+        "//   cos cos -> S cos cos - D sin sin     cos sin -> S cos sin + D sin cos",
+        "//   sin cos -> S sin cos + D cos sin     sin sin -> S sin sin - D cos cos",
+        "template <class V>",
+        "inline void window_mean_lanes(V day_utc, V hour_utc, V duration_hours, V (&means)[n_targets]){",
+        "    const V half = duration_hours * V::set1(0.5);",
+        "    const V day_mid = wrap_lanes(fmadd(half, V::set1(1.0 / 24.0), day_utc + V::set1(delta_utc_solar_h / 24.0)), solar_year_days);",
+        "    const V hour_mid = wrap_lanes(hour_utc + V::set1(delta_utc_solar_h) + half, 24.0);",
+        "    V annual[annual_basis_size] = {}, diurnal[diurnal_basis_size] = {};",
+        "    harmonic_basis_lanes<V, max_annual_harmonics>(day_mid * V::set1(omega_annual), annual);",
+        "    harmonic_basis_lanes<V, max_diurnal_harmonics>(hour_mid * V::set1(omega_diurnal), diurnal);",
+        "    V sum[max_diurnal_harmonics + 1][max_annual_harmonics + 1] = {};",
+        "    V difference[max_diurnal_harmonics + 1][max_annual_harmonics + 1] = {};",
+        "    for(int k = 0; k <= max_diurnal_harmonics; ++k){",
+        "        for(int m = 0; m <= max_annual_harmonics; ++m){",
+        "            const V plus = sinc_lanes(half * V::set1(k * omega_diurnal + m * omega_annual / 24.0));",
+        "            const V minus = m == 0 ? plus : sinc_lanes(half * V::set1(k * omega_diurnal - m * omega_annual / 24.0));",
+        "            sum[k][m] = (plus + minus) * V::set1(0.5);",
+        "            difference[k][m] = (plus - minus) * V::set1(0.5);",
+        "        }",
+        "    }",
+        "    for(int t = 0; t < n_targets; ++t) means[t] = V::set1(0.0);",
+        "    for(int p = 0; p < diurnal_basis_size; ++p){",
+        "        const int k = (p + 1) / 2;",
+        "        for(int j = 0; j < annual_basis_size; ++j){",
+        "            const int m = (j + 1) / 2;",
+        "            V term = sum[k][m] * diurnal[p] * annual[j];",
+        "            if (k > 0 && m > 0) {",
+        "                const V partner = diurnal[p % 2 ? p + 1 : p - 1] * annual[j % 2 ? j + 1 : j - 1];",
+        "                const V d = p % 2 == j % 2 ? V::set1(0.0) - difference[k][m] : difference[k][m];",
+        "                term = fmadd(d, partner, term);",
+        "            }",
+        "            for(int t = 0; t < n_targets; ++t){",
+        "                means[t] = fmadd(V::set1(packed_coeffs[t][p * annual_basis_size + j]), term, means[t]);",
+        "            }",
+        "        }",
+        "    }",
+        "}",
+        "template <class V>",
+        "inline void integrate_lanes(const double* day_utc, const double* hour_utc, const double* duration_hours,",
+        "                            double* temperature_c, double* specific_humidity_kg_kg, double* pressure_hpa){",
+        "    const V duration = V::load(duration_hours);",
+        "    V means[n_targets];",
+        "    window_mean_lanes(V::load(day_utc), V::load(hour_utc), duration, means);",
+        "    (means[0] * duration).store(temperature_c);",
+        "    (means[1] * duration).store(specific_humidity_kg_kg);",
+        "    (means[2] * duration).store(pressure_hpa);",
+        "}",
+        "} // namespace detail",
+        "// Exact integrals (value x hours) of T, Q and P over duration_hours starting at",
+        "// (day_utc, hour_utc), along the continuous timeline of TimeSeriesStepper: the point",
+        "// s hours in is predict(day_utc + s / 24, hour_utc + s). Constant cost for any",
+        "// window length; a negative duration integrates backwards.",
+        "inline Prediction integrate(double day_utc, double hour_utc, double duration_hours){",
+        "    Prediction out{};",
+        "    detail::integrate_lanes<detail::simd::f64x1>(&day_utc, &hour_utc, &duration_hours, &out.temperature_c,",
+        "                                                 &out.specific_humidity_kg_kg, &out.pressure_hpa);",
+        "    return out;",
+        "}",
+        "// integrate() divided by the duration; a zero duration gives the point value.",
+        "inline Prediction window_mean(double day_utc, double hour_utc, double duration_hours){",
+        "    using V = detail::simd::f64x1;",
+        "    V means[detail::n_targets];",
+        "    detail::window_mean_lanes(V::set1(day_utc), V::set1(hour_utc), V::set1(duration_hours), means);",
+        "    return {means[0].v, means[1].v, means[2].v};",
+        "}",
+        "// integrate() for many windows at once, vectorised across windows.",
+        "inline void integrate_batch(const double* day_utc, const double* hour_utc, const double* duration_hours,",
+        "                            std::size_t count, double* temperature_c, double* specific_humidity_kg_kg,",
+        "                            double* pressure_hpa){",
+        "    using V = detail::simd::native;",
+        "    std::size_t i = 0;",
+        "    for (; i + V::width <= count; i += V::width) {",
+        "        detail::integrate_lanes<V>(day_utc + i, hour_utc + i, duration_hours + i, temperature_c + i,",
+        "                                   specific_humidity_kg_kg + i, pressure_hpa + i);",
+        "    }",
+        "    const std::size_t rem = count - i;  // fewer than V::width left",
+        "    for (std::size_t k = 0; k < rem; ++k, ++i) {",
+        "        detail::integrate_lanes<detail::simd::f64x1>(day_utc + i, hour_utc + i, duration_hours + i, temperature_c + i,",
+        "                                                     specific_humidity_kg_kg + i, pressure_hpa + i);",
+        "    }",
+        "}",
+    ]
+
+
+def _generate_full_prediction() -> list[str]:
+    """predict() plus RH, dew point and vapour pressure from the psychrometrics header."""
+
+    return [
+        "#if defined(HARMOCLIMAT_PSYCHROMETRICS)",
+        "// predict() plus relative humidity, dew point and vapour pressure derived as in",
+        "// harmoclimate.psychrometrics; tolerances are listed in harmoclimat_psychrometrics.hpp.",
+        "inline FullPrediction predict_full(double day_utc, double hour_utc){",
+        "    double values[detail::n_targets];",
+        "    double derived[3];",
+        "    predict(day_utc, hour_utc, values[0], values[1], values[2]);",
+        "    psychrometrics::detail::derive_lanes<detail::simd::f64x1>(values, values + 1, values + 2,",
+        "                                                              derived, derived + 1, derived + 2);",
+        "    return {values[0], values[1], values[2], derived[0], derived[1], derived[2]};",
+        "}",
+        "// Fused batch: each SIMD block is predicted and converted before moving on, so the",
+        "// T/Q/P lanes are still in L1 when RH, Td and E are derived from them.",
+        "inline void predict_full_batch(const double* day_utc, const double* hour_utc, std::size_t count,",
+        "                               double* temperature_c, double* specific_humidity_kg_kg, double* pressure_hpa,",
+        "                               double* relative_humidity_percent, double* dew_point_c, double* vapor_pressure_hpa){",
+        "    using V = detail::simd::native;",
+        "    std::size_t i = 0;",
+        "    for (; i + V::width <= count; i += V::width) {",
+        "        detail::predict_lanes<V>(day_utc + i, hour_utc + i, temperature_c + i, specific_humidity_kg_kg + i, pressure_hpa + i);",
+        "        psychrometrics::detail::derive_lanes<V>(temperature_c + i, specific_humidity_kg_kg + i, pressure_hpa + i,",
+        "                                                relative_humidity_percent + i, dew_point_c + i, vapor_pressure_hpa + i);",
+        "    }",
+        "    const std::size_t rem = count - i;  // fewer than V::width left",
+        "    for (std::size_t k = 0; k < rem; ++k, ++i) {",
+        "        detail::predict_lanes<detail::simd::f64x1>(day_utc + i, hour_utc + i, temperature_c + i,",
+        "                                                   specific_humidity_kg_kg + i, pressure_hpa + i);",
+        "        psychrometrics::detail::derive_lanes<detail::simd::f64x1>(temperature_c + i, specific_humidity_kg_kg + i,",
+        "                                                                  pressure_hpa + i, relative_humidity_percent + i,",
+        "                                                                  dew_point_c + i, vapor_pressure_hpa + i);",
+        "    }",
+        "}",
+        "#endif",
+    ]
+
+
+def shared_includes() -> list[str]:
+    """Standard and intrinsic includes needed by the shared core."""
+
+    lines: list[str] = []
+    lines.append("#include <cmath>")
+    lines.append("#include <cstddef>")
+    lines.append("#include <cstdint>")
+    lines.append("#include <limits>")
+    lines.append("#if __cplusplus >= 202002L")
+    lines.append("#include <chrono>")
+    lines.append("#endif")
+    lines.append("#if __cplusplus >= 202002L && defined(__has_include)")
+    lines.append("#if __has_include(<span>)")
+    lines.append("#include <span>")
+    lines.append("#endif")
+    lines.append("#endif")
+    lines.append("#include <iterator>")
+    lines.append("#if defined(__cpp_consteval)")
+    lines.append("#include <array>")
+    lines.append("#endif")
+    lines.append("#if !defined(HARMOCLIMAT_DISABLE_SIMD)")
+    lines.append("#if defined(__AVX512F__) || (defined(__AVX2__) && defined(__FMA__))")
+    lines.append("#include <immintrin.h>")
+    lines.append("#elif defined(__ARM_NEON) && defined(__aarch64__)")
+    lines.append("#include <arm_neon.h>")
+    lines.append("#endif")
+    lines.append("#endif")
+    return lines
+
+
+def shared_core() -> list[str]:
+    """Guarded ``harmoclimat`` core shared by every generated double header."""
+
+    lines: list[str] = []
+    lines.append("// Station-independent helpers, shared by every station header in a translation unit.")
+    lines.append("#if !defined(HARMOCLIMAT_DETAIL_CORE)")
+    lines.append("#define HARMOCLIMAT_DETAIL_CORE")
+    lines.append("struct Prediction {")
+    lines.append("    double temperature_c;")
+    lines.append("    double specific_humidity_kg_kg;")
+    lines.append("    double pressure_hpa;")
+    lines.append("};")
+    lines.append("// Training residuals (observed - model) of one target.")
+    lines.append("struct ErrorEnvelope {")
+    lines.append("    double mae;")
+    lines.append("    double bias;")
+    lines.append("    double p05;")
+    lines.append("    double p95;")
+    lines.append("};")
+    lines.append("// Structure-of-arrays observations for score(); a null target is skipped.")
+    lines.append("struct Observations {")
+    lines.append("    const double* temperature_c;")
+    lines.append("    const double* specific_humidity_kg_kg;")
+    lines.append("    const double* pressure_hpa;")
+    lines.append("};")
+    lines.append("// Outputs of score(), indexed by target (T, Q, P); null pointers are not written.")
+    lines.append("// Bit t of out_of_band is set when residual t lies outside [p05, p95].")
+    lines.append("struct ScoreOutputs {")
+    lines.append("    double* residual[3];")
+    lines.append("    double* standardized[3];")
+    lines.append("    std::uint8_t* out_of_band;")
+    lines.append("};")
+    lines.append("// Solar day in [0, solar_year_days] and solar hour in [0, 24], as used by the fit.")
+    lines.append("struct SolarTime {")
+    lines.append("    double day;")
+    lines.append("    double hour;")
+    lines.append("};")
+    lines.append("// One target over one solar day; hours are UTC, like predict() arguments.")
+    lines.append("struct DailyExtremes {")
+    lines.append("    double mean;")
+    lines.append("    double min;")
+    lines.append("    double max;")
+    lines.append("    double hour_of_min_utc;")
+    lines.append("    double hour_of_max_utc;")
+    lines.append("};")
+    lines.append("struct DailyStats {")
+    lines.append("    DailyExtremes temperature_c;")
+    lines.append("    DailyExtremes specific_humidity_kg_kg;")
+    lines.append("    DailyExtremes pressure_hpa;")
+    lines.append("};")
+    lines.append("#if defined(__cpp_consteval)")
+    lines.append("// Days x StepsPerDay table; entry [day * StepsPerDay + step] is the prediction")
+    lines.append("// for day_utc = day and hour_utc = step * 24 / StepsPerDay.")
+    lines.append("template <int Days, int StepsPerDay>")
+    lines.append("struct YearGrid {")
+    lines.append("    static constexpr int days = Days;")
+    lines.append("    static constexpr int steps_per_day = StepsPerDay;")
+    lines.append("    static constexpr std::size_t size = static_cast<std::size_t>(Days) * StepsPerDay;")
+    lines.append("    std::array<double, size> temperature_c;")
+    lines.append("    std::array<double, size> specific_humidity_kg_kg;")
+    lines.append("    std::array<double, size> pressure_hpa;")
+    lines.append("};")
+    lines.append("#endif")
+    lines.append("namespace detail {")
+    lines.append("static constexpr double two_pi = 6.2831853071795864769;")
+    lines.append("static constexpr double solar_year_days = 365.242189;")
+    lines.append("static constexpr double omega_annual = two_pi / solar_year_days;")
+    lines.append("static constexpr double omega_diurnal = two_pi / 24.0;")
+    lines.append(
+        "// Harmonic basis [1, cos x, sin x, ..., cos Nx, sin Nx] from a single sincos by\n"
+        "// angle addition. For N <= 3 and angle in [0, 2*pi) each entry stays within 4e-15\n"
+        "// (18 ulp of 1.0) of direct std::cos/std::sin(k*angle), whose own k*angle\n"
+        "// rounding dominates.\n"
+        "template <int N>\n"
+        "inline void harmonic_basis(double angle, double (&basis)[2 * N + 1]){\n"
+        "    basis[0] = 1.0;\n"
+        "    for(int k = 1; k <= N; ++k){\n"
+        "        if (k == 1) {\n"
+        "            basis[1] = std::cos(angle);\n"
+        "            basis[2] = std::sin(angle);\n"
+        "            continue;\n"
+        "        }\n"
+        "        basis[2*k - 1] = basis[2*k - 3] * basis[1] - basis[2*k - 2] * basis[2];\n"
+        "        basis[2*k] = basis[2*k - 2] * basis[1] + basis[2*k - 3] * basis[2];\n"
+        "    }\n"
+        "}\n"
+        "inline double eval_annual(const double* coeffs, int n_annual, const double* annual){\n"
+        "    double value = coeffs[0];\n"
+        "    for(int j = 1; j <= 2 * n_annual; ++j){\n"
+        "        value += coeffs[j] * annual[j];\n"
+        "    }\n"
+        "    return value;\n"
+        "}"
+    )
+    lines.append("// numpy's float modulo: std::fmod is exact, so this is constant time and loses")
+    lines.append("// nothing however far x is from zero; only the final + period rounds.")
+    lines.append("inline double mod_positive(double x, double period){")
+    lines.append("    const double r = std::fmod(x, period);")
+    lines.append("    return r < 0.0 ? r + period : r;")
+    lines.append("}")
+    lines.append("inline double wrap_day(double d){")
+    lines.append("    d = mod_positive(d, solar_year_days);")
+    lines.append("    return d >= solar_year_days ? 0.0 : d;  // rounding up to the period; NaN passes through")
+    lines.append("}")
+    lines.append("inline double wrap_hour(double h){")
+    lines.append("    h = mod_positive(h, 24.0);")
+    lines.append("    return h >= 24.0 ? 0.0 : h;")
+    lines.append("}")
+    lines.append("// mod_positive for x in [-period, 2 * period): fmod reduces to one subtraction,")
+    lines.append("// exact by Sterbenz, so the result is bit-identical without the fmod.")
+    lines.append("inline double mod_positive_near(double x, double period){")
+    lines.append("    const double r = x >= period ? x - period : x;")
+    lines.append("    return r < 0.0 ? r + period : r;")
+    lines.append("}")
+    lines.append("// mod_positive(day, solar_year_days) for an integer day. The remainder is a")
+    lines.append("// multiple of ulp(solar_year_days) = 2^-44 below 2^9, so one fused multiply-add")
+    lines.append("// forms it exactly and matches std::fmod bit for bit; without hardware FMA")
+    lines.append("// std::fma is a library call, so fmod stays.")
+    lines.append("inline double mod_year_day(std::int64_t day){")
+    lines.append("    const double d = static_cast<double>(day);")
+    lines.append("#if defined(FP_FAST_FMA) || defined(__FP_FAST_FMA)")
+    lines.append("    double k = std::floor(d / solar_year_days);")
+    lines.append("    double r = std::fma(-k, solar_year_days, d);")
+    lines.append("    if (r < 0.0 || r >= solar_year_days) {")
+    lines.append("        k += r < 0.0 ? -1.0 : 1.0;")
+    lines.append("        r = std::fma(-k, solar_year_days, d);")
+    lines.append("    }")
+    lines.append("    return r;")
+    lines.append("#else")
+    lines.append("    return mod_positive(d, solar_year_days);")
+    lines.append("#endif")
+    lines.append("}")
+    lines.append("static constexpr std::int64_t seconds_per_day = 86400;")
+    lines.append("static constexpr std::int64_t solar_epoch_unix_day = 10957; // 2000-01-01T00:00:00Z")
+    lines.append("// harmoclimate.core.compute_solar_time for one Unix timestamp, operation for")
+    lines.append("// operation (before its float32 storage cast): the floored UTC day since the epoch")
+    lines.append("// modulo the tropical year, shifted by longitude / 360 of a year, and the UTC")
+    lines.append("// hour from whole hours, minutes and seconds shifted by longitude / 15.")
+    lines.append("inline SolarTime solar_time_from_unix(std::int64_t unix_seconds, double longitude_deg){")
+    lines.append("    std::int64_t day = unix_seconds / seconds_per_day;")
+    lines.append("    std::int64_t second = unix_seconds % seconds_per_day;")
+    lines.append("    if (second < 0) {")
+    lines.append("        second += seconds_per_day;")
+    lines.append("        --day;")
+    lines.append("    }")
+    lines.append("    const double year_day = mod_year_day(day - solar_epoch_unix_day);")
+    lines.append("    const double hour_utc = static_cast<double>(second / 3600) + static_cast<double>(second % 3600 / 60) / 60.0")
+    lines.append("                          + static_cast<double>(second % 60) / 3600.0;")
+    lines.append("    return {mod_positive_near(year_day + (longitude_deg / 360.0) * solar_year_days, solar_year_days),")
+    lines.append("            mod_positive_near(hour_utc + longitude_deg / 15.0, 24.0)};")
+    lines.append("}")
+    lines.append(_EXTREMES_CORE)
+    lines.append(_SIMD_CORE)
+    lines.append("} // namespace detail")
+    lines.append("#endif")
+    return lines
+
+
 def generate_cpp_header(
     temperature_payload: Mapping[str, object],
     specific_humidity_payload: Mapping[str, object],
@@ -91,6 +1311,7 @@ def generate_cpp_header(
     longitude_deg = float(metadata.get("longitude_deg", float("nan")))
     latitude_deg = float(metadata.get("latitude_deg", float("nan")))
     delta_utc_solar_h = float(metadata.get("delta_utc_solar_h", 0.0))
+    namespace = station_namespace(output_path)
 
     output_path.parent.mkdir(parents=True, exist_ok=True)
 
@@ -98,47 +1319,84 @@ def generate_cpp_header(
     lines.append("// Auto-generated linear harmonic climate model")
     lines.append(f"// Station name : {station_name}")
     lines.append(f"// Station code : {station_code}")
+    max_annual, max_diurnal = max_harmonics(
+        (temperature_payload, specific_humidity_payload, pressure_payload)
+    )
+
     lines.append("#pragma once")
-    lines.append("#include <cmath>")
+    lines.extend(shared_includes())
+    lines.append("// Optional companion emitted next to the station headers; enables predict_full().")
+    lines.append("#if defined(__has_include) && !defined(HARMOCLIMAT_DISABLE_PSYCHROMETRICS)")
+    lines.append("#if __has_include(\"harmoclimat_psychrometrics.hpp\")")
+    lines.append("#include \"harmoclimat_psychrometrics.hpp\"")
+    lines.append("#endif")
+    lines.append("#endif")
     lines.append("namespace harmoclimat {")
+    lines.extend(shared_core())
 
+    lines.append(f"namespace {namespace} {{")
     lines.append(f"static constexpr double longitude_deg = {longitude_deg:.17g};")
     if not math.isnan(latitude_deg):
         lines.append(f"static constexpr double latitude_deg = {latitude_deg:.17g};")
     lines.append(f"static constexpr double delta_utc_solar_h = {delta_utc_solar_h:.17g};")
-
+    lines.append("// Temperature, specific humidity and pressure, from the bundles' error_envelope.")
+    lines.append("static constexpr ErrorEnvelope error_envelope[3] = {")
+    for payload in (temperature_payload, specific_humidity_payload, pressure_payload):
+        envelope = payload["metadata"].get("error_envelope") or {}  # type: ignore[index]
+        fields = ", ".join(_cpp_double(envelope.get(key)) for key in ("mae", "bias", "p05", "p95"))
+        lines.append(f"    {{{fields}}},")
+    lines.append("};")
     lines.append("namespace detail {")
-    lines.append("static constexpr double two_pi = 6.2831853071795864769;")
-    lines.append("static constexpr double solar_year_days = 365.242189;")
-    lines.append("static constexpr double omega_annual = two_pi / solar_year_days;")
-    lines.append("static constexpr double omega_diurnal = two_pi / 24.0;")
-    lines.append(
-        "inline double eval_annual(const double* coeffs, int n_annual, double day){\n"
-        "    double value = coeffs[0];\n"
-        "    for(int k = 1; k <= n_annual; ++k){\n"
-        "        double angle = k * omega_annual * day;\n"
-        "        value += coeffs[2*k - 1] * std::cos(angle);\n"
-        "        value += coeffs[2*k] * std::sin(angle);\n"
-        "    }\n"
-        "    return value;\n"
-        "}"
-    )
-    lines.append("inline double wrap_day(double d){")
-    lines.append("    while (d >= solar_year_days) d -= solar_year_days;")
-    lines.append("    while (d < 0.0)   d += solar_year_days;")
-    lines.append("    return d;")
-    lines.append("}")
-    lines.append("inline double wrap_hour(double h){")
-    lines.append("    while (h >= 24.0) h -= 24.0;")
-    lines.append("    while (h < 0.0)   h += 24.0;")
-    lines.append("    return h;")
-    lines.append("}")
+    lines.append("using namespace ::harmoclimat::detail;")
+    lines.append(f"static constexpr int max_annual_harmonics = {max_annual};")
+    lines.append(f"static constexpr int max_diurnal_harmonics = {max_diurnal};")
+    lines.append("static constexpr int annual_basis_size = 2 * max_annual_harmonics + 1;")
+    lines.append("static constexpr int diurnal_basis_size = 2 * max_diurnal_harmonics + 1;")
     lines.append("} // namespace detail")
 
     lines.extend(_generate_model_namespace("temperature_model", temperature_payload))
     lines.extend(_generate_model_namespace("specific_humidity_model", specific_humidity_payload))
     lines.extend(_generate_model_namespace("pressure_model", pressure_payload))
 
+    packed_size = (2 * max_annual + 1) * (2 * max_diurnal + 1)
+    packed_stride = (packed_size + 7) // 8 * 8
+    lines.append("namespace detail {")
+    lines.append("static constexpr int n_targets = 3;")
+    lines.append("static constexpr int packed_size = annual_basis_size * diurnal_basis_size;")
+    lines.append("static constexpr int packed_stride = (packed_size + 7) / 8 * 8;")
+    lines.append("// Rows: temperature, specific humidity, pressure; each laid out as")
+    lines.append("// [diurnal term][annual term] and zero-padded to packed_stride.")
+    lines.append("alignas(64) static constexpr double packed_coeffs[n_targets][packed_stride] = {")
+    for payload in (temperature_payload, specific_humidity_payload, pressure_payload):
+        row = packed_coefficients(payload, max_annual, max_diurnal)
+        row.extend([0.0] * (packed_stride - packed_size))
+        lines.append("    {")
+        lines.append(_format_array(row, indent="        ", per_line=7))
+        lines.append("    },")
+    lines.append("};")
+    lines.append("// Every target from one shared basis: the outer product of the diurnal and")
+    lines.append("// annual bases is built once, then dotted with each packed coefficient row.")
+    lines.append("inline void evaluate_fused(double day_solar, double hour_solar, double (&values)[n_targets]){")
+    lines.append("    double annual[annual_basis_size], diurnal[diurnal_basis_size];")
+    lines.append("    harmonic_basis<max_annual_harmonics>(omega_annual * day_solar, annual);")
+    lines.append("    harmonic_basis<max_diurnal_harmonics>(omega_diurnal * hour_solar, diurnal);")
+    lines.append("    alignas(64) double basis[packed_stride] = {};")
+    lines.append("    for(int p = 0; p < diurnal_basis_size; ++p){")
+    lines.append("        for(int j = 0; j < annual_basis_size; ++j){")
+    lines.append("            basis[p * annual_basis_size + j] = diurnal[p] * annual[j];")
+    lines.append("        }")
+    lines.append("    }")
+    lines.append("    using V = simd::native;")
+    lines.append("    for(int t = 0; t < n_targets; ++t){")
+    lines.append("        V acc = V::set1(0.0);")
+    lines.append("        for(int i = 0; i < packed_stride; i += static_cast<int>(V::width)){")
+    lines.append("            acc = fmadd(V::load(packed_coeffs[t] + i), V::load(basis + i), acc);")
+    lines.append("        }")
+    lines.append("        values[t] = reduce_add(acc);")
+    lines.append("    }")
+    lines.append("}")
+    lines.append("} // namespace detail")
+
     lines.append("inline double predict_temperature(double day_utc, double hour_utc){")
     lines.append("    double hour_solar = detail::wrap_hour(hour_utc + delta_utc_solar_h);")
     lines.append("    double day_solar  = detail::wrap_day(day_utc + (delta_utc_solar_h / 24.0));")
@@ -163,11 +1421,86 @@ def generate_cpp_header(
     )
     lines.append("    double hour_solar = detail::wrap_hour(hour_utc + delta_utc_solar_h);")
     lines.append("    double day_solar  = detail::wrap_day(day_utc + (delta_utc_solar_h / 24.0));")
-    lines.append("    temperature_c = temperature_model::evaluate(day_solar, hour_solar);")
-    lines.append("    specific_humidity_kg_kg = specific_humidity_model::evaluate(day_solar, hour_solar);")
-    lines.append("    pressure_hpa = pressure_model::evaluate(day_solar, hour_solar);")
+    lines.append("    double values[detail::n_targets];")
+    lines.append("    detail::evaluate_fused(day_solar, hour_solar, values);")
+    lines.append("    temperature_c = values[0];")
+    lines.append("    specific_humidity_kg_kg = values[1];")
+    lines.append("    pressure_hpa = values[2];")
     lines.append("}")
 
+    lines.append("namespace detail {")
+    lines.append("template <class V>")
+    lines.append(
+        "constexpr void predict_solar_lanes(V day_solar, V hour_solar, double* temperature_c, "
+        "double* specific_humidity_kg_kg, double* pressure_hpa){"
+    )
+    lines.append("    V annual[annual_basis_size] = {}, diurnal[diurnal_basis_size] = {};")
+    lines.append("    harmonic_basis_lanes<V, max_annual_harmonics>(day_solar * V::set1(omega_annual), annual);")
+    lines.append("    harmonic_basis_lanes<V, max_diurnal_harmonics>(hour_solar * V::set1(omega_diurnal), diurnal);")
+    lines.append("    double* outputs[n_targets] = {temperature_c, specific_humidity_kg_kg, pressure_hpa};")
+    lines.append("    for(int t = 0; t < n_targets; ++t){")
+    lines.append("        evaluate_packed_lanes(packed_coeffs[t], annual, diurnal).store(outputs[t]);")
+    lines.append("    }")
+    lines.append("}")
+    lines.append("template <class V>")
+    lines.append(
+        "constexpr void predict_lanes(const double* day_utc, const double* hour_utc, double* temperature_c, "
+        "double* specific_humidity_kg_kg, double* pressure_hpa){"
+    )
+    lines.append(
+        "    const V day_solar  = wrap_lanes(V::load(day_utc) + V::set1(delta_utc_solar_h / 24.0), solar_year_days);"
+    )
+    lines.append("    const V hour_solar = wrap_lanes(V::load(hour_utc) + V::set1(delta_utc_solar_h), 24.0);")
+    lines.append("    predict_solar_lanes(day_solar, hour_solar, temperature_c, specific_humidity_kg_kg, pressure_hpa);")
+    lines.append("}")
+    lines.append("} // namespace detail")
+
+    lines.append("// Structure-of-arrays batch evaluation; results match predict() up to rounding.")
+    lines.append(
+        "inline void predict_batch(const double* day_utc, const double* hour_utc, std::size_t count, "
+        "double* temperature_c, double* specific_humidity_kg_kg, double* pressure_hpa){"
+    )
+    lines.append("    using V = detail::simd::native;")
+    lines.append("    std::size_t i = 0;")
+    lines.append("    for (; i + V::width <= count; i += V::width) {")
+    lines.append(
+        "        detail::predict_lanes<V>(day_utc + i, hour_utc + i, temperature_c + i, "
+        "specific_humidity_kg_kg + i, pressure_hpa + i);"
+    )
+    lines.append("    }")
+    lines.append("    const std::size_t rem = count - i;  // fewer than V::width left")
+    lines.append("    for (std::size_t k = 0; k < rem; ++k, ++i) {")
+    lines.append(
+        "        detail::predict_lanes<detail::simd::f64x1>(day_utc + i, hour_utc + i, temperature_c + i, "
+        "specific_humidity_kg_kg + i, pressure_hpa + i);"
+    )
+    lines.append("    }")
+    lines.append("}")
+    lines.append("#if defined(__cpp_lib_span)")
+    lines.append("// Span overload; every span must hold at least day_utc.size() elements.")
+    lines.append(
+        "inline void predict_batch(std::span<const double> day_utc, std::span<const double> hour_utc, "
+        "std::span<double> temperature_c, std::span<double> specific_humidity_kg_kg, "
+        "std::span<double> pressure_hpa){"
+    )
+    lines.append(
+        "    predict_batch(day_utc.data(), hour_utc.data(), day_utc.size(), temperature_c.data(), "
+        "specific_humidity_kg_kg.data(), pressure_hpa.data());"
+    )
+    lines.append("}")
+    lines.append("#endif")
+    lines.extend(_generate_timestamp_api())
+    lines.extend(_generate_score())
+    lines.extend(_generate_constexpr_api())
+    lines.extend(_generate_day_profile())
+    lines.extend(_generate_time_series_stepper())
+    lines.extend(_generate_window_integrals())
+    lines.extend(_generate_full_prediction())
+    lines.append(f"}} // namespace {namespace}")
+    lines.append("// Keeps harmoclimat::predict() and friends working when a single station header")
+    lines.append(f"// is included; with several, name the station (harmoclimat::{namespace}::predict).")
+    lines.append(f"using namespace {namespace};")
+
     lines.append("} // namespace harmoclimat")
 
     with open(output_path, "w", encoding="utf-8") as handle:
@@ -175,4 +1508,100 @@ def generate_cpp_header(
     print(f"[OK] C++ header generated: {output_path}")
 
 
-__all__ = ["generate_cpp_header"]
+REGISTRY_HEADER_NAME = "harmoclimat_stations.hpp"
+
+
+def _cpp_double(value: object) -> str:
+    number = math.nan if value is None else float(value)  # type: ignore[arg-type]
+    return "std::numeric_limits<double>::quiet_NaN()" if math.isnan(number) else f"{number:.17g}"
+
+
+def _cpp_string(value: object) -> str:
+    return '"' + str(value).replace("\\", "\\\\").replace('"', '\\"') + '"'
+
+
+def generate_cpp_registry(model_dir: Path, template_dir: Path) -> Path:
+    """Render an aggregate header including every station header in ``template_dir``.
+
+    Stations are paired with their temperature bundle in ``model_dir`` for the
+    metadata; headers without a bundle are skipped.
+    """
+
+    stations: list[tuple[str, Mapping[str, object]]] = []
+    for header_path in sorted(template_dir.glob("*.hpp")):
+        if header_path.name == REGISTRY_HEADER_NAME:
+            continue
+        model_path = model_dir / f"{header_path.stem}_temperature.json"
+        if not model_path.exists():
+            continue
+        with open(model_path, "r", encoding="utf-8") as handle:
+            metadata = json.load(handle)["metadata"]
+        stations.append((header_path.name, metadata))
+
+    lines: list[str] = []
+    lines.append("// Auto-generated registry of the HarmoClimate station headers")
+    lines.append(f"// Stations : {len(stations)}")
+    lines.append("#pragma once")
+    lines.append("#include <cstddef>")
+    lines.append("#include <cstdint>")
+    lines.append("#include <limits>")
+    lines.append("#include <string_view>")
+    for header_name, _ in stations:
+        lines.append(f'#include "{header_name}"')
+    lines.append("namespace harmoclimat {")
+    lines.append("// One row per station. Calling a station namespace directly")
+    lines.append("// (harmoclimat::fr_bourges::predict) is a plain inline call; the function")
+    lines.append("// pointers here serve runtime selection by station code.")
+    lines.append("struct StationEntry {")
+    lines.append("    std::string_view code;")
+    lines.append("    std::string_view name;")
+    lines.append("    double longitude_deg;")
+    lines.append("    double latitude_deg;")
+    lines.append("    double delta_utc_solar_h;")
+    lines.append("    void (*predict)(double, double, double&, double&, double&);")
+    lines.append("    void (*predict_batch)(const double*, const double*, std::size_t, double*, double*, double*);")
+    lines.append("    void (*predict_batch_unix)(const std::int64_t*, std::size_t, double*, double*, double*);")
+    lines.append("};")
+    lines.append("inline constexpr StationEntry stations[] = {")
+    for header_name, metadata in stations:
+        namespace = station_namespace(Path(header_name))
+        latitude_deg = float(metadata.get("latitude_deg", float("nan")))
+        latitude = (
+            "std::numeric_limits<double>::quiet_NaN()" if math.isnan(latitude_deg) else f"{latitude_deg:.17g}"
+        )
+        lines.append(
+            f"    {{{_cpp_string(metadata.get('station_code', ''))}, "
+            f"{_cpp_string(metadata.get('station_usual_name', ''))}, "
+            f"{namespace}::longitude_deg, {latitude}, {namespace}::delta_utc_solar_h, "
+            f"&{namespace}::predict, &{namespace}::predict_batch, &{namespace}::predict_batch}},"
+        )
+    lines.append("};")
+    lines.append("inline constexpr std::size_t station_count = sizeof(stations) / sizeof(stations[0]);")
+    lines.append("// Station with the given code, or nullptr. Usable in constant expressions:")
+    lines.append('//   constexpr const StationEntry* bourges = find_station("18033001");')
+    lines.append("constexpr const StationEntry* find_station(std::string_view code){")
+    lines.append("    for (std::size_t i = 0; i < station_count; ++i) {")
+    lines.append("        if (stations[i].code == code) return &stations[i];")
+    lines.append("    }")
+    lines.append("    return nullptr;")
+    lines.append("}")
+    lines.append("} // namespace harmoclimat")
+
+    output_path = template_dir / REGISTRY_HEADER_NAME
+    output_path.parent.mkdir(parents=True, exist_ok=True)
+    with open(output_path, "w", encoding="utf-8") as handle:
+        handle.write("\n".join(lines))
+    print(f"[OK] C++ station registry generated: {output_path}")
+    return output_path
+
+
+__all__ = [
+    "REGISTRY_HEADER_NAME",
+    "generate_cpp_header",
+    "generate_cpp_registry",
+    "max_harmonics",
+    "packed_coefficients",
+    "shared_core",
+    "shared_includes",
+    "station_namespace",
+]
@@ -0,0 +1,502 @@
+"""Freestanding float / fixed-point C++ header variants for microcontrollers.
+
+The emitted headers include only ``<stdint.h>`` (no ``<cmath>``, no libm) and
+evaluate the same packed ``[diurnal term][annual term]`` model as the double
+header. Both annual and diurnal angles are carried as 32-bit phases where
+``2^32`` is one period, so wrapping is free (unsigned overflow) and every
+harmonic ``k`` is simply ``k * phase``.
+
+* ``float``: single precision arithmetic, sine/cosine from an octant-reduced
+  polynomial (cephes ``sinf``/``cosf`` kernels).
+* ``q15`` / ``q31``: 16- or 32-bit coefficients and basis values, integer
+  arithmetic only, sine from a 257-point quarter-wave table with linear
+  interpolation. Outputs are raw integers with a per-target number of
+  fractional bits.
+
+The generator replays the emitted arithmetic with numpy over a full-year grid
+and writes the worst-case deviation from the double model into the header.
+"""
+
+from __future__ import annotations
+
+import math
+from pathlib import Path
+from typing import Mapping
+
+import numpy as np
+
+from .template_cpp import max_harmonics, packed_coefficients, station_namespace
+
+NUMERIC_MODES = ("float", "q15", "q31")
+NUMERIC_SUFFIXES = {"float": "f32", "q15": "q15", "q31": "q31"}
+
+_SOLAR_YEAR_DAYS = 365.242189
+_TARGETS = ("temperature", "specific_humidity", "pressure")
+_UNITS = ("degC", "kg/kg", "hPa")
+_TABLE_SEGMENTS = 256
+_GRID_DAYS = 366
+_GRID_STEPS = 96
+
+# cephes sinf/cosf kernels on [0, pi/4].
+_SIN_POLY = (-1.9515295891e-4, 8.3321608736e-3, -1.6666654611e-1)
+_COS_POLY = (2.443315711809948e-5, -1.388731625493765e-3, 4.166664568298827e-2)
+
+
+def _float_literal(value: float) -> str:
+    text = f"{float(np.float32(value)):.9g}"
+    if "e" not in text and "." not in text:
+        text += ".0"
+    return f"{text}f"
+
+
+def _format_values(values, indent: str = "        ", per_line: int = 7) -> str:
+    lines = []
+    for idx in range(0, len(values), per_line):
+        lines.append(indent + ", ".join(values[idx : idx + per_line]))
+    return ",\n".join(lines)
+
+
+# ----------------------------- Reference model -----------------------------
+
+
+def _reference(packed: np.ndarray, annual_size: int, diurnal_size: int, day: np.ndarray, hour: np.ndarray, delta: float):
+    """Double precision evaluation matching the generated double header."""
+
+    day_solar = np.mod(day + delta / 24.0, _SOLAR_YEAR_DAYS)
+    hour_solar = np.mod(hour + delta, 24.0)
+    annual = _basis(2.0 * math.pi / _SOLAR_YEAR_DAYS * day_solar, annual_size)
+    diurnal = _basis(2.0 * math.pi / 24.0 * hour_solar, diurnal_size)
+    return np.einsum("tpj,jn,pn->tn", packed.reshape(3, diurnal_size, annual_size), annual, diurnal)
+
+
+def _basis(angle: np.ndarray, size: int) -> np.ndarray:
+    rows = [np.ones_like(angle)]
+    for k in range(1, (size - 1) // 2 + 1):
+        rows.extend([np.cos(k * angle), np.sin(k * angle)])
+    return np.stack(rows)
+
+
+# ----------------------------- float variant -----------------------------
+
+
+def _f32(value) -> np.ndarray:
+    return np.asarray(value, dtype=np.float32)
+
+
+def _float_phase(x: np.ndarray, inv_period: np.float32) -> np.ndarray:
+    turns = _f32(x) * inv_period
+    whole = np.trunc(turns).astype(np.int32)
+    whole = np.where(whole.astype(np.float32) > turns, whole - 1, whole)
+    frac = turns - whole.astype(np.float32)
+    scaled = frac * np.float32(4294967296.0)
+    return np.where(scaled >= np.float32(4294967296.0), 0, scaled).astype(np.uint64)
+
+
+def _float_sincos(phase: np.ndarray):
+    octant = (phase >> 29) & 7
+    r = phase & 0x1FFFFFFF
+    r = np.where(octant & 1, 0x20000000 - r, r)
+    x = r.astype(np.float32) * np.float32(math.pi / 4.0 / 2**29)
+    z = x * x
+    s3, s2, s1 = (np.float32(v) for v in _SIN_POLY)
+    c3, c2, c1 = (np.float32(v) for v in _COS_POLY)
+    sx = ((s3 * z + s2) * z + s1) * z * x + x
+    cx = ((c3 * z + c2) * z + c1) * z * z - np.float32(0.5) * z + np.float32(1.0)
+    swap = ((octant + 1) & 2) != 0
+    sv = np.where(swap, cx, sx)
+    cv = np.where(swap, sx, cx)
+    return np.where(octant & 4, -sv, sv), np.where((octant + 2) & 4, -cv, cv)
+
+
+def _float_basis(phase: np.ndarray, size: int) -> list[np.ndarray]:
+    basis = [np.ones(phase.shape, dtype=np.float32)]
+    for k in range(1, (size - 1) // 2 + 1):
+        s, c = _float_sincos((phase * k) & 0xFFFFFFFF)
+        basis.extend([c, s])
+    return basis
+
+
+def _simulate_float(model: dict, day: np.ndarray, hour: np.ndarray) -> np.ndarray:
+    annual_phase = _float_phase(_f32(day) + np.float32(model["delta"] / 24.0), np.float32(1.0 / _SOLAR_YEAR_DAYS))
+    diurnal_phase = _float_phase(_f32(hour) + np.float32(model["delta"]), np.float32(1.0 / 24.0))
+    annual = _float_basis(annual_phase, model["annual_size"])
+    diurnal = _float_basis(diurnal_phase, model["diurnal_size"])
+    outputs = []
+    for t in range(3):
+        coeffs = model["float_coeffs"][t]
+        value = np.zeros(day.shape, dtype=np.float32)
+        for p in range(model["diurnal_size"]):
+            inner = np.zeros(day.shape, dtype=np.float32)
+            for j in range(model["annual_size"]):
+                inner = inner + coeffs[p * model["annual_size"] + j] * annual[j]
+            value = value + inner * diurnal[p]
+        outputs.append(value + model["float_offsets"][t])
+    return np.stack(outputs).astype(np.float64)
+
+
+# ----------------------------- fixed-point variants -----------------------------
+
+
+def _sine_table(bits: int) -> list[int]:
+    full = (1 << bits) - 1
+    table = [round(math.sin(i / _TABLE_SEGMENTS * math.pi / 2.0) * full) for i in range(_TABLE_SEGMENTS + 1)]
+    table.append(table[-1])  # read, with a zero weight, when the mirrored index lands on the last point
+    return table
+
+
+def _rshift_round(x: np.ndarray, shift: int) -> np.ndarray:
+    return (x + (1 << (shift - 1))) >> shift
+
+
+def _fixed_sin(phase: np.ndarray, bits: int, table: np.ndarray) -> np.ndarray:
+    quadrant = (phase >> 30) & 3
+    r = phase & 0x3FFFFFFF
+    r = np.where(quadrant & 1, 0x40000000 - r, r)
+    index = (r >> 22).astype(np.int64)
+    frac = (r & 0x3FFFFF).astype(np.int64)
+    lo = table[index]
+    hi = table[index + 1]
+    if bits == 15:
+        value = lo + (((hi - lo) * (frac >> 7)) >> 15)
+    else:
+        value = lo + (((hi - lo) * frac) >> 22)
+    return np.where(quadrant & 2, -value, value)
+
+
+def _fixed_basis(phase: np.ndarray, size: int, bits: int, table: np.ndarray) -> list[np.ndarray]:
+    basis = [np.full(phase.shape, (1 << bits) - 1, dtype=np.int64)]
+    for k in range(1, (size - 1) // 2 + 1):
+        harmonic = (phase * k) & 0xFFFFFFFF
+        basis.append(_fixed_sin((harmonic + 0x40000000) & 0xFFFFFFFF, bits, table))
+        basis.append(_fixed_sin(harmonic, bits, table))
+    return basis
+
+
+def _simulate_fixed(model: dict, day: np.ndarray, seconds: np.ndarray) -> np.ndarray:
+    bits = model["bits"]
+    table = np.asarray(model["table"], dtype=np.int64)
+    annual_phase = (day.astype(np.uint64) * model["annual_step"] + model["annual_offset"]) & 0xFFFFFFFF
+    diurnal_phase = (seconds.astype(np.uint64) * model["diurnal_step"] + model["diurnal_offset"]) & 0xFFFFFFFF
+    annual = _fixed_basis(annual_phase.astype(np.int64), model["annual_size"], bits, table)
+    diurnal = _fixed_basis(diurnal_phase.astype(np.int64), model["diurnal_size"], bits, table)
+    outputs = []
+    for t in range(3):
+        coeffs = model["fixed_coeffs"][t]
+        acc = np.zeros(day.shape, dtype=np.int64)
+        for p in range(model["diurnal_size"]):
+            inner = np.zeros(day.shape, dtype=np.int64)
+            for j in range(model["annual_size"]):
+                inner = inner + coeffs[p * model["annual_size"] + j] * annual[j]
+            acc = acc + _rshift_round(inner, bits) * diurnal[p]
+        raw = model["fixed_offsets"][t] + _rshift_round(acc, model["shifts"][t])
+        outputs.append(raw.astype(np.float64) / float(1 << model["out_frac_bits"][t]))
+    return np.stack(outputs)
+
+
+def _quantize_target(row: list[float], bits: int) -> tuple[list[int], int, int, int, int]:
+    """Integer coefficients, coefficient/output fractional bits, offset and final shift."""
+
+    constant = row[0]
+    rest = [0.0] + row[1:]
+    total = sum(abs(value) for value in rest)
+    limit = (1 << bits) - len(rest)
+    coeff_frac = bits if total == 0.0 else math.floor(math.log2(limit / total))
+    coeffs = [round(value * 2.0**coeff_frac) for value in rest]
+    magnitude = abs(constant) + total
+    out_frac = coeff_frac if magnitude == 0.0 else min(coeff_frac, 30 - math.ceil(math.log2(magnitude * 1.0001)))
+    offset = round(constant * 2.0**out_frac)
+    shift = coeff_frac + bits - out_frac
+    return coeffs, coeff_frac, out_frac, offset, shift
+
+
+# ----------------------------- Emission -----------------------------
+
+
+def _prepare(payloads, numeric: str) -> dict:
+    max_annual, max_diurnal = max_harmonics(payloads)
+    annual_size = 2 * max_annual + 1
+    diurnal_size = 2 * max_diurnal + 1
+    rows = [packed_coefficients(payload, max_annual, max_diurnal) for payload in payloads]
+    metadata = payloads[0]["metadata"]
+    model: dict = {
+        "annual_size": annual_size,
+        "diurnal_size": diurnal_size,
+        "packed": np.asarray(rows, dtype=np.float64),
+        "delta": float(metadata.get("delta_utc_solar_h", 0.0)),
+    }
+    if numeric == "float":
+        model["float_coeffs"] = [np.asarray([0.0] + row[1:], dtype=np.float32) for row in rows]
+        model["float_offsets"] = [np.float32(row[0]) for row in rows]
+        return model
+
+    bits = 15 if numeric == "q15" else 31
+    quantized = [_quantize_target(row, bits) for row in rows]
+    delta_turns = model["delta"] / 24.0
+    model.update(
+        {
+            "bits": bits,
+            "table": _sine_table(bits),
+            "fixed_coeffs": [np.asarray(q[0], dtype=np.int64) for q in quantized],
+            "coeff_frac_bits": [q[1] for q in quantized],
+            "out_frac_bits": [q[2] for q in quantized],
+            "fixed_offsets": [q[3] for q in quantized],
+            "shifts": [q[4] for q in quantized],
+            "annual_step": round(2.0**32 / _SOLAR_YEAR_DAYS),
+            "annual_offset": round(delta_turns / _SOLAR_YEAR_DAYS * 2.0**32) % 2**32,
+            "diurnal_step": round(2.0**32 / 86400.0),
+            "diurnal_offset": round(delta_turns * 2.0**32) % 2**32,
+        }
+    )
+    return model
+
+
+def _worst_errors(model: dict, numeric: str) -> list[float]:
+    days = np.repeat(np.arange(_GRID_DAYS, dtype=np.int64), _GRID_STEPS)
+    seconds = np.tile(np.arange(_GRID_STEPS, dtype=np.int64) * (86400 // _GRID_STEPS), _GRID_DAYS)
+    hours = seconds / 3600.0
+    reference = _reference(
+        model["packed"], model["annual_size"], model["diurnal_size"], days.astype(np.float64), hours, model["delta"]
+    )
+    if numeric == "float":
+        simulated = _simulate_float(model, days.astype(np.float64), hours)
+    else:
+        simulated = _simulate_fixed(model, days, seconds)
+    return [float(np.max(np.abs(simulated[t] - reference[t]))) for t in range(3)]
+
+
+def _emit_float(lines: list[str], model: dict) -> None:
+    lines.append(f"static constexpr float delta_utc_solar_h = {_float_literal(model['delta'])};")
+    lines.append("namespace detail {")
+    lines.append(f"static constexpr int annual_basis_size = {model['annual_size']};")
+    lines.append(f"static constexpr int diurnal_basis_size = {model['diurnal_size']};")
+    lines.append(f"static constexpr float inv_solar_year_days = {_float_literal(1.0 / _SOLAR_YEAR_DAYS)};")
+    lines.append(f"static constexpr float quarter_pi_per_unit = {_float_literal(math.pi / 4.0 / 2**29)};")
+    lines.append("// Constant term of each target; packed_coeffs holds the rest with a zero in its place.")
+    offsets = ", ".join(_float_literal(value) for value in model["float_offsets"])
+    lines.append(f"static constexpr float offsets[3] = {{{offsets}}};")
+    lines.append("static constexpr float packed_coeffs[3][annual_basis_size * diurnal_basis_size] = {")
+    for row in model["float_coeffs"]:
+        lines.append("    {")
+        lines.append(_format_values([_float_literal(value) for value in row]))
+        lines.append("    },")
+    lines.append("};")
+    lines.append("// Fraction of a period as a 32-bit phase (2^32 = one period).")
+    lines.append("inline uint32_t phase_of(float x, float inv_period){")
+    lines.append("    const float turns = x * inv_period;")
+    lines.append("    int32_t whole = static_cast<int32_t>(turns);")
+    lines.append("    if (static_cast<float>(whole) > turns) --whole;")
+    lines.append("    const float scaled = (turns - static_cast<float>(whole)) * 4294967296.0f;")
+    lines.append("    return scaled >= 4294967296.0f ? 0u : static_cast<uint32_t>(scaled);")
+    lines.append("}")
+    lines.append("// Octant reduction to [0, pi/4] and the cephes sinf/cosf kernels.")
+    lines.append("inline void sincos_phase(uint32_t phase, float& s, float& c){")
+    lines.append("    const uint32_t octant = phase >> 29;")
+    lines.append("    uint32_t r = phase & 0x1FFFFFFFu;")
+    lines.append("    if (octant & 1u) r = 0x20000000u - r;")
+    lines.append("    const float x = static_cast<float>(r) * quarter_pi_per_unit;")
+    lines.append("    const float z = x * x;")
+    s3, s2, s1 = (_float_literal(v) for v in _SIN_POLY)
+    c3, c2, c1 = (_float_literal(v) for v in _COS_POLY)
+    lines.append(f"    const float sx = (({s3} * z + {s2}) * z + {s1}) * z * x + x;")
+    lines.append(f"    const float cx = (({c3} * z + {c2}) * z + {c1}) * z * z - 0.5f * z + 1.0f;")
+    lines.append("    const bool swap = ((octant + 1u) & 2u) != 0u;")
+    lines.append("    const float sv = swap ? cx : sx;")
+    lines.append("    const float cv = swap ? sx : cx;")
+    lines.append("    s = (octant & 4u) ? -sv : sv;")
+    lines.append("    c = ((octant + 2u) & 4u) ? -cv : cv;")
+    lines.append("}")
+    lines.append("template <int Size>")
+    lines.append("inline void harmonic_basis(uint32_t phase, float (&basis)[Size]){")
+    lines.append("    basis[0] = 1.0f;")
+    lines.append("    for(int k = 1; 2 * k < Size; ++k){")
+    lines.append("        sincos_phase(phase * static_cast<uint32_t>(k), basis[2*k], basis[2*k - 1]);")
+    lines.append("    }")
+    lines.append("}")
+    lines.append("inline float evaluate(int target, const float (&annual)[annual_basis_size], "
+                 "const float (&diurnal)[diurnal_basis_size]){")
+    lines.append("    const float* coeffs = packed_coeffs[target];")
+    lines.append("    float value = 0.0f;")
+    lines.append("    for(int p = 0; p < diurnal_basis_size; ++p){")
+    lines.append("        float inner = 0.0f;")
+    lines.append("        for(int j = 0; j < annual_basis_size; ++j){")
+    lines.append("            inner += coeffs[p * annual_basis_size + j] * annual[j];")
+    lines.append("        }")
+    lines.append("        value += inner * diurnal[p];")
+    lines.append("    }")
+    lines.append("    return value + offsets[target];")
+    lines.append("}")
+    lines.append("inline void bases(float day_utc, float hour_utc, float (&annual)[annual_basis_size], "
+                 "float (&diurnal)[diurnal_basis_size]){")
+    lines.append("    harmonic_basis(phase_of(day_utc + delta_utc_solar_h / 24.0f, inv_solar_year_days), annual);")
+    lines.append("    harmonic_basis(phase_of(hour_utc + delta_utc_solar_h, 1.0f / 24.0f), diurnal);")
+    lines.append("}")
+    lines.append("} // namespace detail")
+    for index, target in enumerate(_TARGETS):
+        lines.append(f"inline float predict_{target}(float day_utc, float hour_utc){{")
+        lines.append("    float annual[detail::annual_basis_size], diurnal[detail::diurnal_basis_size];")
+        lines.append("    detail::bases(day_utc, hour_utc, annual, diurnal);")
+        lines.append(f"    return detail::evaluate({index}, annual, diurnal);")
+        lines.append("}")
+    lines.append(
+        "inline void predict(float day_utc, float hour_utc, float& temperature_c, "
+        "float& specific_humidity_kg_kg, float& pressure_hpa){"
+    )
+    lines.append("    float annual[detail::annual_basis_size], diurnal[detail::diurnal_basis_size];")
+    lines.append("    detail::bases(day_utc, hour_utc, annual, diurnal);")
+    lines.append("    temperature_c = detail::evaluate(0, annual, diurnal);")
+    lines.append("    specific_humidity_kg_kg = detail::evaluate(1, annual, diurnal);")
+    lines.append("    pressure_hpa = detail::evaluate(2, annual, diurnal);")
+    lines.append("}")
+
+
+def _emit_fixed(lines: list[str], model: dict) -> None:
+    bits = model["bits"]
+    value_type = "int16_t" if bits == 15 else "int32_t"
+    acc_type = "int32_t" if bits == 15 else "int64_t"
+    frac_bits = ", ".join(str(value) for value in model["out_frac_bits"])
+    lines.append("// Outputs are raw integers: physical value = raw / 2^frac_bits[target]")
+    lines.append("// (targets: temperature degC, specific humidity kg/kg, pressure hPa).")
+    lines.append(f"static constexpr int frac_bits[3] = {{{frac_bits}}};")
+    lines.append("namespace detail {")
+    lines.append(f"static constexpr int annual_basis_size = {model['annual_size']};")
+    lines.append(f"static constexpr int diurnal_basis_size = {model['diurnal_size']};")
+    lines.append(f"static constexpr int value_bits = {bits};")
+    lines.append("// 32-bit phases (2^32 = one period); the solar offset is folded into the phase offsets.")
+    lines.append(f"static constexpr uint32_t annual_phase_per_day = {model['annual_step']}u;")
+    lines.append(f"static constexpr uint32_t annual_phase_offset = {model['annual_offset']}u;")
+    lines.append(f"static constexpr uint32_t diurnal_phase_per_second = {model['diurnal_step']}u;")
+    lines.append(f"static constexpr uint32_t diurnal_phase_offset = {model['diurnal_offset']}u;")
+    offsets = ", ".join(f"{value}" for value in model["fixed_offsets"])
+    shifts = ", ".join(str(value) for value in model["shifts"])
+    lines.append("// Constant term of each target in output units, and the shift from the")
+    lines.append("// accumulator format to the output format.")
+    lines.append(f"static constexpr int32_t offsets[3] = {{{offsets}}};")
+    lines.append(f"static constexpr int shifts[3] = {{{shifts}}};")
+    coeff_frac = ", ".join(str(value) for value in model["coeff_frac_bits"])
+    lines.append(f"// Coefficient fractional bits per target: {coeff_frac}.")
+    lines.append(f"static constexpr {value_type} packed_coeffs[3][annual_basis_size * diurnal_basis_size] = {{")
+    for row in model["fixed_coeffs"]:
+        lines.append("    {")
+        lines.append(_format_values([str(int(value)) for value in row]))
+        lines.append("    },")
+    lines.append("};")
+    lines.append(f"// Quarter-wave sine, {_TABLE_SEGMENTS} segments; the last point is repeated.")
+    lines.append(f"static constexpr {value_type} sine_table[{_TABLE_SEGMENTS + 2}] = {{")
+    lines.append(_format_values([str(value) for value in model["table"]], indent="    ", per_line=8))
+    lines.append("};")
+    lines.append(f"inline {value_type} sin_phase(uint32_t phase){{")
+    lines.append("    const uint32_t quadrant = phase >> 30;")
+    lines.append("    uint32_t r = phase & 0x3FFFFFFFu;")
+    lines.append("    if (quadrant & 1u) r = 0x40000000u - r;")
+    lines.append("    const uint32_t index = r >> 22;")
+    lines.append("    const uint32_t frac = r & 0x3FFFFFu;")
+    lines.append(f"    const {acc_type} lo = sine_table[index];")
+    lines.append(f"    const {acc_type} hi = sine_table[index + 1];")
+    if bits == 15:
+        lines.append("    const int32_t value = lo + (((hi - lo) * static_cast<int32_t>(frac >> 7)) >> 15);")
+    else:
+        lines.append("    const int64_t value = lo + (((hi - lo) * static_cast<int64_t>(frac)) >> 22);")
+    lines.append(f"    return static_cast<{value_type}>((quadrant & 2u) ? -value : value);")
+    lines.append("}")
+    lines.append("template <int Size>")
+    lines.append(f"inline void harmonic_basis(uint32_t phase, {value_type} (&basis)[Size]){{")
+    lines.append(f"    basis[0] = static_cast<{value_type}>((static_cast<{acc_type}>(1) << value_bits) - 1);")
+    lines.append("    for(int k = 1; 2 * k < Size; ++k){")
+    lines.append("        const uint32_t harmonic = phase * static_cast<uint32_t>(k);")
+    lines.append("        basis[2*k - 1] = sin_phase(harmonic + 0x40000000u);")
+    lines.append("        basis[2*k] = sin_phase(harmonic);")
+    lines.append("    }")
+    lines.append("}")
+    lines.append(f"inline {acc_type} round_shift({acc_type} x, int shift){{")
+    lines.append(f"    return (x + (static_cast<{acc_type}>(1) << (shift - 1))) >> shift;")
+    lines.append("}")
+    lines.append("// Coefficient magnitudes are bounded at generation time so that no sum overflows.")
+    lines.append(f"inline int32_t evaluate(int target, const {value_type} (&annual)[annual_basis_size], "
+                 f"const {value_type} (&diurnal)[diurnal_basis_size]){{")
+    lines.append(f"    const {value_type}* coeffs = packed_coeffs[target];")
+    lines.append(f"    {acc_type} acc = 0;")
+    lines.append("    for(int p = 0; p < diurnal_basis_size; ++p){")
+    lines.append(f"        {acc_type} inner = 0;")
+    lines.append("        for(int j = 0; j < annual_basis_size; ++j){")
+    lines.append(f"            inner += static_cast<{acc_type}>(coeffs[p * annual_basis_size + j]) * annual[j];")
+    lines.append("        }")
+    lines.append("        acc += round_shift(inner, value_bits) * diurnal[p];")
+    lines.append("    }")
+    lines.append("    return offsets[target] + static_cast<int32_t>(round_shift(acc, shifts[target]));")
+    lines.append("}")
+    lines.append(f"inline void bases(uint32_t day_utc, uint32_t second_of_day_utc, "
+                 f"{value_type} (&annual)[annual_basis_size], {value_type} (&diurnal)[diurnal_basis_size]){{")
+    lines.append("    harmonic_basis(day_utc * annual_phase_per_day + annual_phase_offset, annual);")
+    lines.append("    harmonic_basis(second_of_day_utc * diurnal_phase_per_second + diurnal_phase_offset, diurnal);")
+    lines.append("}")
+    lines.append("} // namespace detail")
+    lines.append("// day_utc counts whole days from the model epoch; second_of_day_utc is 0..86399.")
+    for index, target in enumerate(_TARGETS):
+        lines.append(f"inline int32_t predict_{target}_raw(uint32_t day_utc, uint32_t second_of_day_utc){{")
+        lines.append(f"    {value_type} annual[detail::annual_basis_size], diurnal[detail::diurnal_basis_size];")
+        lines.append("    detail::bases(day_utc, second_of_day_utc, annual, diurnal);")
+        lines.append(f"    return detail::evaluate({index}, annual, diurnal);")
+        lines.append("}")
+    lines.append(
+        "inline void predict_raw(uint32_t day_utc, uint32_t second_of_day_utc, int32_t& temperature, "
+        "int32_t& specific_humidity, int32_t& pressure){"
+    )
+    lines.append(f"    {value_type} annual[detail::annual_basis_size], diurnal[detail::diurnal_basis_size];")
+    lines.append("    detail::bases(day_utc, second_of_day_utc, annual, diurnal);")
+    lines.append("    temperature = detail::evaluate(0, annual, diurnal);")
+    lines.append("    specific_humidity = detail::evaluate(1, annual, diurnal);")
+    lines.append("    pressure = detail::evaluate(2, annual, diurnal);")
+    lines.append("}")
+
+
+def generate_cpp_embedded_header(
+    temperature_payload: Mapping[str, object],
+    specific_humidity_payload: Mapping[str, object],
+    pressure_payload: Mapping[str, object],
+    output_path: Path,
+    numeric: str = "float",
+) -> list[float]:
+    """Render a freestanding ``float``/``q15``/``q31`` header; returns the worst errors (T, Q, P)."""
+
+    if numeric not in NUMERIC_MODES:
+        raise ValueError(f"Unsupported numeric mode '{numeric}'. Choose from {', '.join(NUMERIC_MODES)}.")
+
+    payloads = (temperature_payload, specific_humidity_payload, pressure_payload)
+    model = _prepare(payloads, numeric)
+    errors = _worst_errors(model, numeric)
+
+    metadata = temperature_payload["metadata"]  # type: ignore[index]
+    namespace = station_namespace(output_path)
+    arithmetic = (
+        "float arithmetic, polynomial sine"
+        if numeric == "float"
+        else f"Q{model['bits']} coefficients, integer arithmetic, table sine"
+    )
+    lines: list[str] = []
+    lines.append("// Auto-generated linear harmonic climate model (freestanding embedded variant)")
+    lines.append(f"// Station name : {metadata.get('station_usual_name', '')}")
+    lines.append(f"// Station code : {metadata.get('station_code', '')}")
+    lines.append(f"// Numeric      : {numeric} ({arithmetic}; no <cmath>)")
+    lines.append(f"// Worst-case |error| against the double model, {_GRID_DAYS} days x {_GRID_STEPS} steps:")
+    for target, unit, error in zip(_TARGETS, _UNITS, errors):
+        lines.append(f"//   {target:<17}: {error:.3g} {unit}")
+    lines.append("#pragma once")
+    lines.append("#include <stdint.h>")
+    lines.append("namespace harmoclimat {")
+    lines.append(f"namespace {namespace} {{")
+    if numeric == "float":
+        _emit_float(lines, model)
+    else:
+        _emit_fixed(lines, model)
+    lines.append(f"}} // namespace {namespace}")
+    lines.append("} // namespace harmoclimat")
+
+    output_path.parent.mkdir(parents=True, exist_ok=True)
+    with open(output_path, "w", encoding="utf-8") as handle:
+        handle.write("\n".join(lines))
+    summary = ", ".join(f"{target} {error:.3g}" for target, error in zip(_TARGETS, errors))
+    print(f"[OK] {numeric} C++ header generated: {output_path} (worst error: {summary})")
+    return errors
+
+
+__all__ = ["NUMERIC_MODES", "NUMERIC_SUFFIXES", "generate_cpp_embedded_header"]
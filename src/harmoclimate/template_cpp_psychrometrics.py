@@ -0,0 +1,286 @@
+"""Native C++ companion header for the derived humidity variables.
+
+``harmoclimat_psychrometrics.hpp`` mirrors :mod:`harmoclimate.psychrometrics`
+(Buck enhancement factor, vapour pressure from specific humidity, relative
+humidity and dew point) so C++ callers no longer round-trip through Python
+for RH, Td and E. The two transcendental pieces of ``wsp2p`` are replaced by
+Chebyshev fits generated here:
+
+* ``ln Es(T)`` over the saturation range, evaluated then exponentiated;
+* ``Td(ln e)``, the inverse, over the matching vapour-pressure range.
+
+Everything is written once over the shared SIMD lane types, so the scalar
+functions and the batch kernels run the same arithmetic. The generator
+replays that arithmetic with numpy against the Python reference and records
+the worst deviations in the header (and refuses to write a header that misses
+the tolerances below).
+"""
+
+from __future__ import annotations
+
+from pathlib import Path
+
+import numpy as np
+
+from . import psychrometrics as psy
+from .template_cpp import shared_core, shared_includes
+
+PSYCHROMETRICS_HEADER_NAME = "harmoclimat_psychrometrics.hpp"
+
+# Saturation fit range (degC); the dew point fit covers ln Es over the same range.
+SATURATION_MIN_C = -80.0
+SATURATION_MAX_C = 70.0
+
+_MAX_DEGREE = 64
+_FIT_SAMPLES = 8193
+_LOG_ESAT_TOLERANCE = 1e-13
+_DEW_POINT_TOLERANCE_C = 1e-10
+
+# Acceptance limits against harmoclimate.psychrometrics on the check grid.
+_RH_TOLERANCE_PERCENT = 1e-9
+_TD_TOLERANCE_C = 1e-9
+_E_RELATIVE_TOLERANCE = 1e-12
+
+# Buck (1981) Eq. 6, Table 3 (f_ws), as in psychrometrics.buck_enhancement_factor_water_eq6.
+_BUCK = (4.1e-4, 3.48e-6, 7.4e-10, 30.6, -3.8e-2)
+
+
+def _fit(func, lo: float, hi: float, tolerance: float) -> tuple[np.ndarray, float]:
+    """Lowest-degree Chebyshev interpolant of ``func`` on ``[lo, hi]`` within ``tolerance``."""
+
+    x = np.linspace(lo, hi, _FIT_SAMPLES)
+    reference = func(x)
+    for degree in range(8, _MAX_DEGREE + 1):
+        series = np.polynomial.Chebyshev.interpolate(func, degree, domain=[lo, hi])
+        error = float(np.max(np.abs(_clenshaw(series.coef, x, lo, hi) - reference)))
+        if error <= tolerance:
+            return series.coef, error
+    raise RuntimeError(
+        f"Chebyshev fit on [{lo}, {hi}] did not reach {tolerance:g} below degree {_MAX_DEGREE}."
+    )
+
+
+def _clenshaw(coeffs: np.ndarray, x: np.ndarray, lo: float, hi: float) -> np.ndarray:
+    """numpy replay of ``detail::chebyshev_lanes`` (argument clamped to the fit range)."""
+
+    t = np.clip(np.asarray(x, dtype=np.float64) * (2.0 / (hi - lo)) - (hi + lo) / (hi - lo), -1.0, 1.0)
+    b1 = np.zeros_like(t)
+    b2 = np.zeros_like(t)
+    for c in coeffs[:0:-1]:
+        b1, b2 = 2.0 * t * b1 + (c - b2), b1
+    return t * b1 + (coeffs[0] - b2)
+
+
+def _replay(
+    log_esat: np.ndarray,
+    dew_point: np.ndarray,
+    log_e_range: tuple[float, float],
+    T: np.ndarray,
+    q: np.ndarray,
+    p: np.ndarray,
+) -> tuple[np.ndarray, np.ndarray, np.ndarray]:
+    """numpy replay of ``detail::derive_lanes``: returns ``(RH, Td, E)``."""
+
+    q = np.clip(q, 0.0, psy.MAX_Q_KG_PER_KG)
+    denom = np.maximum(psy.EPS + psy.ONE_MINUS_EPS * q, psy.MIN_DENOM)
+    e = np.minimum(np.maximum(q * p / denom, psy.MIN_E_HPA), p)
+    A, B, C, D, E = _BUCK
+    f = 1.0 + A + p * (B + C * (T + D + E * p) ** 2)
+    es = np.exp(_clenshaw(log_esat, T, SATURATION_MIN_C, SATURATION_MAX_C))
+    rh = np.clip(100.0 * e / np.maximum(f * es, psy.MIN_DENOM), 0.0, 100.0)
+    td = _clenshaw(dew_point, np.log(np.maximum(e, psy.MIN_E_HPA)), *log_e_range)
+    return rh, td, e
+
+
+def _format_coefficients(name: str, coeffs: np.ndarray) -> list[str]:
+    lines = [f"static constexpr double {name}[{len(coeffs)}] = {{"]
+    for start in range(0, len(coeffs), 4):
+        chunk = ", ".join(f"{value:.17g}" for value in coeffs[start:start + 4])
+        lines.append(f"    {chunk},")
+    lines.append("};")
+    return lines
+
+
+def generate_cpp_psychrometrics(template_dir: Path) -> Path:
+    """Write ``harmoclimat_psychrometrics.hpp`` into ``template_dir`` and return its path."""
+
+    log_esat, log_esat_error = _fit(
+        lambda t: np.log(psy.esat_water_hpa(t)), SATURATION_MIN_C, SATURATION_MAX_C, _LOG_ESAT_TOLERANCE
+    )
+    log_e_min = float(np.log(psy.esat_water_hpa(SATURATION_MIN_C)))
+    log_e_max = float(np.log(psy.esat_water_hpa(SATURATION_MAX_C)))
+    dew_point, dew_point_error = _fit(
+        lambda u: psy.dew_point_c_from_e(np.exp(u)), log_e_min, log_e_max, _DEW_POINT_TOLERANCE_C
+    )
+
+    # Check grid: every (T, q, P) the station models can plausibly produce,
+    # restricted to vapour pressures inside the dew point fit range.
+    T, q, p = (
+        axis.ravel()
+        for axis in np.meshgrid(
+            np.linspace(-40.0, 50.0, 181),
+            np.geomspace(1e-5, 0.035, 121),
+            np.linspace(700.0, 1080.0, 39),
+            indexing="ij",
+        )
+    )
+    rh, td, e = _replay(log_esat, dew_point, (log_e_min, log_e_max), T, q, p)
+    e_reference = psy.vapor_partial_pressure_hpa_from_q_p(q, p)
+    inside = np.log(e_reference) <= log_e_max
+    rh_error = float(np.max(np.abs(rh - psy.relative_humidity_percent_from_specific(T, q, p))))
+    td_error = float(np.max(np.abs(td - psy.dew_point_c_from_e(e_reference))[inside]))
+    e_error = float(np.max(np.abs(e / e_reference - 1.0)))
+    if rh_error > _RH_TOLERANCE_PERCENT or td_error > _TD_TOLERANCE_C or e_error > _E_RELATIVE_TOLERANCE:
+        raise RuntimeError(
+            f"Psychrometrics header out of tolerance: RH {rh_error:.3g} %, Td {td_error:.3g} degC, "
+            f"E relative {e_error:.3g}."
+        )
+
+    lines: list[str] = []
+    lines.append("// Auto-generated psychrometrics companion for the HarmoClimat station headers")
+    lines.append("// Mirrors harmoclimate.psychrometrics: Buck (1981) enhancement factor and the")
+    lines.append("// wsp2p saturation pressure, replaced by Chebyshev fits of ln Es(T) and Td(ln e).")
+    lines.append(
+        f"// ln Es(T)  : degree {len(log_esat) - 1} on [{SATURATION_MIN_C:g}, {SATURATION_MAX_C:g}] degC, "
+        f"max |error| {log_esat_error:.2g}"
+    )
+    lines.append(
+        f"// Td(ln e)  : degree {len(dew_point) - 1} on ln Es over the same range, "
+        f"max |error| {dew_point_error:.2g} degC"
+    )
+    lines.append("// Against harmoclimate.psychrometrics for T in [-40, 50] degC, q in [1e-5, 0.035],")
+    lines.append(
+        f"// P in [700, 1080] hPa: RH {rh_error:.2g} %, Td {td_error:.2g} degC, E relative {e_error:.2g}."
+    )
+    lines.append("// Outside the fit range Es and Td saturate at the range bounds.")
+    lines.append("#pragma once")
+    lines.extend(shared_includes())
+    lines.append("#define HARMOCLIMAT_PSYCHROMETRICS")
+    lines.append("namespace harmoclimat {")
+    lines.extend(shared_core())
+    lines.append("struct FullPrediction {")
+    lines.append("    double temperature_c;")
+    lines.append("    double specific_humidity_kg_kg;")
+    lines.append("    double pressure_hpa;")
+    lines.append("    double relative_humidity_percent;")
+    lines.append("    double dew_point_c;")
+    lines.append("    double vapor_pressure_hpa;")
+    lines.append("};")
+    lines.append("namespace psychrometrics {")
+    lines.append(f"static constexpr double eps = {psy.EPS:.17g};")
+    lines.append(f"static constexpr double min_e_hpa = {psy.MIN_E_HPA:.17g};")
+    lines.append(f"static constexpr double min_denominator = {psy.MIN_DENOM:.17g};")
+    lines.append(f"static constexpr double max_q_kg_per_kg = {psy.MAX_Q_KG_PER_KG:.17g};")
+    lines.append(f"static constexpr double saturation_min_c = {SATURATION_MIN_C:.17g};")
+    lines.append(f"static constexpr double saturation_max_c = {SATURATION_MAX_C:.17g};")
+    lines.append("namespace detail {")
+    lines.append("using namespace ::harmoclimat::detail;")
+    lines.append(f"static constexpr double log_e_min = {log_e_min:.17g};")
+    lines.append(f"static constexpr double log_e_max = {log_e_max:.17g};")
+    lines.extend(_format_coefficients("log_esat_coeffs", log_esat))
+    lines.extend(_format_coefficients("dew_point_coeffs", dew_point))
+    A, B, C, D, E = _BUCK
+    lines.append(
+        f"""template <class V>
+inline V min_lanes(V a, V b){{ return V::select(lt(a, b), a, b); }}
+template <class V>
+inline V max_lanes(V a, V b){{ return V::select(lt(a, b), b, a); }}
+// Clenshaw recurrence on [lo, hi]; x is clamped to the range first.
+template <class V, int N>
+inline V chebyshev_lanes(const double (&c)[N], V x, double lo, double hi){{
+    V t = fmadd(x, V::set1(2.0 / (hi - lo)), V::set1(-(hi + lo) / (hi - lo)));
+    t = max_lanes(min_lanes(t, V::set1(1.0)), V::set1(-1.0));
+    const V t2 = t + t;
+    V b1 = V::set1(0.0), b2 = V::set1(0.0);
+    for(int k = N - 1; k >= 1; --k){{
+        const V b0 = fmadd(t2, b1, V::set1(c[k]) - b2);
+        b2 = b1;
+        b1 = b0;
+    }}
+    return fmadd(t, b1, V::set1(c[0]) - b2);
+}}
+template <class V>
+inline V buck_enhancement_lanes(V t, V p){{
+    const V x = fmadd(V::set1({E:.17g}), p, t + V::set1({D:.17g}));
+    return fmadd(p, fmadd(V::set1({C:.17g}), x * x, V::set1({B:.17g})), V::set1(1.0 + {A:.17g}));
+}}
+template <class V>
+inline V esat_water_lanes(V t){{
+    return exp_lanes(chebyshev_lanes(log_esat_coeffs, t, saturation_min_c, saturation_max_c));
+}}
+template <class V>
+inline V vapor_pressure_lanes(V q, V p){{
+    q = max_lanes(min_lanes(q, V::set1(max_q_kg_per_kg)), V::set1(0.0));
+    const V denom = max_lanes(fmadd(V::set1(1.0 - eps), q, V::set1(eps)), V::set1(min_denominator));
+    return min_lanes(max_lanes(q * p / denom, V::set1(min_e_hpa)), p);
+}}
+template <class V>
+inline V relative_humidity_lanes(V t, V e, V p){{
+    const V saturated = max_lanes(buck_enhancement_lanes(t, p) * esat_water_lanes(t), V::set1(min_denominator));
+    return max_lanes(min_lanes(V::set1(100.0) * e / saturated, V::set1(100.0)), V::set1(0.0));
+}}
+template <class V>
+inline V dew_point_lanes(V e){{
+    return chebyshev_lanes(dew_point_coeffs, log_lanes(max_lanes(e, V::set1(min_e_hpa))), log_e_min, log_e_max);
+}}
+template <class V>
+inline void derive_lanes(const double* temperature_c, const double* specific_humidity_kg_kg, const double* pressure_hpa,
+                         double* relative_humidity_percent, double* dew_point_c, double* vapor_pressure_hpa){{
+    const V t = V::load(temperature_c);
+    const V p = V::load(pressure_hpa);
+    const V e = vapor_pressure_lanes(V::load(specific_humidity_kg_kg), p);
+    relative_humidity_lanes(t, e, p).store(relative_humidity_percent);
+    dew_point_lanes(e).store(dew_point_c);
+    e.store(vapor_pressure_hpa);
+}}
+}} // namespace detail
+inline double buck_enhancement_factor(double temperature_c, double pressure_hpa){{
+    using V = detail::simd::f64x1;
+    return detail::buck_enhancement_lanes(V::set1(temperature_c), V::set1(pressure_hpa)).v;
+}}
+inline double esat_water_hpa(double temperature_c){{
+    return detail::esat_water_lanes(detail::simd::f64x1::set1(temperature_c)).v;
+}}
+inline double vapor_partial_pressure_hpa_from_q_p(double specific_humidity_kg_kg, double pressure_hpa){{
+    using V = detail::simd::f64x1;
+    return detail::vapor_pressure_lanes(V::set1(specific_humidity_kg_kg), V::set1(pressure_hpa)).v;
+}}
+inline double relative_humidity_percent_from_specific(double temperature_c, double specific_humidity_kg_kg, double pressure_hpa){{
+    using V = detail::simd::f64x1;
+    const V p = V::set1(pressure_hpa);
+    const V e = detail::vapor_pressure_lanes(V::set1(specific_humidity_kg_kg), p);
+    return detail::relative_humidity_lanes(V::set1(temperature_c), e, p).v;
+}}
+inline double dew_point_c_from_e(double vapor_pressure_hpa){{
+    return detail::dew_point_lanes(detail::simd::f64x1::set1(vapor_pressure_hpa)).v;
+}}
+// RH, dew point and vapour pressure for every (T, q, P) triple.
+inline void derive_batch(const double* temperature_c, const double* specific_humidity_kg_kg, const double* pressure_hpa,
+                         std::size_t count, double* relative_humidity_percent, double* dew_point_c, double* vapor_pressure_hpa){{
+    using V = detail::simd::native;
+    std::size_t i = 0;
+    for (; i + V::width <= count; i += V::width) {{
+        detail::derive_lanes<V>(temperature_c + i, specific_humidity_kg_kg + i, pressure_hpa + i,
+                                relative_humidity_percent + i, dew_point_c + i, vapor_pressure_hpa + i);
+    }}
+    const std::size_t rem = count - i;  // fewer than V::width left
+    for (std::size_t k = 0; k < rem; ++k, ++i) {{
+        detail::derive_lanes<detail::simd::f64x1>(temperature_c + i, specific_humidity_kg_kg + i, pressure_hpa + i,
+                                                  relative_humidity_percent + i, dew_point_c + i, vapor_pressure_hpa + i);
+    }}
+}}"""
+    )
+    lines.append("} // namespace psychrometrics")
+    lines.append("} // namespace harmoclimat")
+
+    template_dir.mkdir(parents=True, exist_ok=True)
+    output_path = template_dir / PSYCHROMETRICS_HEADER_NAME
+    output_path.write_text("\n".join(lines), encoding="utf-8")
+    print(f"[OK] C++ psychrometrics header generated: {output_path}")
+    return output_path
+
+
+__all__ = [
+    "PSYCHROMETRICS_HEADER_NAME",
+    "generate_cpp_psychrometrics",
+]
@@ -2,6 +2,7 @@
 
 from __future__ import annotations
 
+import ctypes
 import math
 from dataclasses import dataclass
 from typing import Dict, Iterable, List, Optional, Tuple
@@ -9,6 +10,7 @@ from typing import Dict, Iterable, List, Optional, Tuple
 import numpy as np
 import pandas as pd
 
+from . import native
 from .config import AUTHOR_NAME, COUNTRY_CODE, MODEL_VERSION
 from .core import SOLAR_YEAR_DAYS, prepare_dataset
 
@@ -42,10 +44,15 @@ class ErrorMetrics:
 
 @dataclass
 class YearlyDesignStats:
-    """Per-year sufficient statistics for a given target variable."""
+    """Per-year sufficient statistics for a given target variable.
+
+    The design matrix is not stored: ``day``/``hour`` are the solar features of
+    each row, from which :meth:`predict` evaluates ``X @ beta`` directly.
+    """
 
     year: int
-    X: np.ndarray
+    day: np.ndarray
+    hour: np.ndarray
     y: np.ndarray
     S: np.ndarray
     b: np.ndarray
@@ -54,6 +61,17 @@ class YearlyDesignStats:
     utc_hour: np.ndarray
     params_meta: List[Dict[str, int]]
 
+    def predict(self, coefficients: np.ndarray) -> np.ndarray:
+        """Model values ``X @ coefficients`` for this year's rows."""
+
+        return predict_design(coefficients, self.day, self.hour, self.params_meta)
+
+    @property
+    def X(self) -> np.ndarray:
+        """Dense design matrix, rebuilt on demand."""
+
+        return build_design_block(self.day, self.hour, self.params_meta)
+
 
 @dataclass
 class YearlyValidationMetrics:
@@ -222,59 +240,203 @@ def _role_for_parameter(name: str) -> str:
     raise ValueError(f"Unknown parameter name '{name}'")
 
 
-def build_global_linear_matrix(
-    df: pd.DataFrame,
+def _parameter_names(n_diurnal: int) -> List[str]:
+    names: List[str] = ["c0"]
+    for m in range(1, n_diurnal + 1):
+        names.extend([f"a{m}", f"b{m}"])
+    return names
+
+
+def build_params_meta(
     *,
     n_diurnal: int,
     annual_per_param: Dict[str, int],
     default_n_annual: int,
-    target: str,
-) -> tuple[
-    np.ndarray,
-    np.ndarray,
-    List[Dict[str, int]],
-    np.ndarray,
-    np.ndarray,
-]:
-    """Construct the design matrix for the factorized linear model.
+) -> List[Dict[str, int]]:
+    """Column layout of the design matrix: one block per parameter c0, a1, b1, ..."""
 
-    UTC no-leap calendar for evaluation keys: Feb 29 samples are excluded from
-    `(utc_day_index, utc_hour)`.
+    params_meta: List[Dict[str, int]] = []
+    start_idx = 0
+    for name in _parameter_names(n_diurnal):
+        n_annual_param = int(annual_per_param.get(name, default_n_annual))
+        length = 2 * n_annual_param + 1
+        params_meta.append(
+            {"name": name, "n_annual": n_annual_param, "start": start_idx, "length": length}
+        )
+        start_idx += length
+    return params_meta
 
-    Returns:
-        (
-            X,
-            y,
-            params_meta,
-            utc_day_index,
-            utc_hour,
+
+def build_design_block(
+    day: np.ndarray,
+    hour: np.ndarray,
+    params_meta: List[Dict[str, int]],
+) -> np.ndarray:
+    """Dense design rows for solar ``day`` and ``hour`` (hour already wrapped to [0, 24))."""
+
+    omega = 2.0 * math.pi / 24.0
+    X_blocks: List[np.ndarray] = []
+    for entry in params_meta:
+        name = entry["name"]
+        annual_basis = build_annual_basis(day, int(entry["n_annual"]))
+
+        if name == "c0":
+            block = annual_basis
+        elif name.startswith("a"):
+            harmonic = int(name[1:])
+            block = annual_basis * np.cos(harmonic * omega * hour)[:, None]
+        elif name.startswith("b"):
+            harmonic = int(name[1:])
+            block = annual_basis * np.sin(harmonic * omega * hour)[:, None]
+        else:
+            raise ValueError(f"Unhandled parameter name '{name}'")
+        X_blocks.append(block)
+    return np.concatenate(X_blocks, axis=1)
+
+
+def _native_layout(params_meta: List[Dict[str, int]]) -> Tuple[int, np.ndarray]:
+    n_diurnal = (len(params_meta) - 1) // 2
+    expected = _parameter_names(n_diurnal)
+    if [entry["name"] for entry in params_meta] != expected:
+        raise ValueError("Parameter layout must follow the c0, a1, b1, ... order.")
+    return n_diurnal, np.array([int(entry["n_annual"]) for entry in params_meta], dtype=np.int32)
+
+
+def _pointer(array: np.ndarray, ctype=ctypes.c_double):
+    return array.ctypes.data_as(ctypes.POINTER(ctype))
+
+
+def predict_design(
+    coefficients: np.ndarray,
+    day: np.ndarray,
+    hour: np.ndarray,
+    params_meta: List[Dict[str, int]],
+    *,
+    chunk_rows: int = 65536,
+) -> np.ndarray:
+    """Evaluate ``X @ coefficients`` row by row without materialising ``X``."""
+
+    coefficients = np.ascontiguousarray(coefficients, dtype=float)
+    day = np.ascontiguousarray(day, dtype=float)
+    hour = np.ascontiguousarray(hour, dtype=float)
+    out = np.empty(day.shape[0], dtype=float)
+
+    library = native.load_library()
+    if library is not None:
+        n_diurnal, n_annual = _native_layout(params_meta)
+        native.check(
+            library.hc_design_predict(
+                n_diurnal,
+                _pointer(n_annual, ctypes.c_int32),
+                _pointer(coefficients),
+                _pointer(day),
+                _pointer(hour),
+                day.shape[0],
+                _pointer(out),
+            )
         )
+        return out
+
+    for start in range(0, day.shape[0], chunk_rows):
+        stop = start + chunk_rows
+        out[start:stop] = build_design_block(day[start:stop], hour[start:stop], params_meta) @ coefficients
+    return out
+
+
+class DesignAccumulator:
+    """Streams (day, hour, y) rows into ``S = XᵀX`` and ``b = Xᵀy``.
+
+    Uses the native accumulator of ``cpp/native/design_stats.cpp`` when it is
+    available: pairwise summation over fixed 256-row blocks, identical results
+    for any thread count or chunking of :meth:`add` calls. The NumPy fallback
+    builds the design matrix one chunk at a time. Rows with a non-finite value
+    are skipped in both cases.
     """
 
-    required_cols = {"yday_frac_solar", "hour_solar", target}
-    missing = required_cols - set(df.columns)
-    if missing:
-        raise KeyError(f"Missing required columns for training: {sorted(missing)}")
+    def __init__(
+        self,
+        params_meta: List[Dict[str, int]],
+        *,
+        threads: int | None = None,
+        chunk_rows: int = 65536,
+    ) -> None:
+        self.params_meta = [dict(entry) for entry in params_meta]
+        self.dimension = sum(int(entry["length"]) for entry in self.params_meta)
+        self.threads = 0 if threads is None else int(threads)
+        self.chunk_rows = chunk_rows
+        self._library = native.load_library()
+        self._handle = None
+        if self._library is not None:
+            n_diurnal, n_annual = _native_layout(self.params_meta)
+            self._handle = self._library.hc_design_accumulator_create(
+                n_diurnal, _pointer(n_annual, ctypes.c_int32)
+            )
+            if not self._handle:
+                native.check(-1)
+        else:
+            self._S = np.zeros((self.dimension, self.dimension), dtype=float)
+            self._b = np.zeros(self.dimension, dtype=float)
+            self._n = 0
+
+    @property
+    def backend(self) -> str:
+        return "native" if self._handle is not None else "numpy"
+
+    def add(self, day: np.ndarray, hour: np.ndarray, y: np.ndarray) -> None:
+        day = np.ascontiguousarray(day, dtype=float)
+        hour = np.ascontiguousarray(hour, dtype=float)
+        y = np.ascontiguousarray(y, dtype=float)
+        if not (day.shape == hour.shape == y.shape) or day.ndim != 1:
+            raise ValueError("day, hour and y must be 1-D arrays of equal length.")
+
+        if self._handle is not None:
+            native.check(
+                self._library.hc_design_accumulator_add(
+                    self._handle, _pointer(day), _pointer(hour), _pointer(y), day.shape[0], self.threads
+                )
+            )
+            return
+
+        for start in range(0, day.shape[0], self.chunk_rows):
+            stop = start + self.chunk_rows
+            keep = np.isfinite(day[start:stop]) & np.isfinite(hour[start:stop]) & np.isfinite(y[start:stop])
+            X = build_design_block(day[start:stop][keep], hour[start:stop][keep], self.params_meta)
+            self._S += X.T @ X
+            self._b += X.T @ y[start:stop][keep]
+            self._n += int(np.count_nonzero(keep))
+
+    def result(self) -> Tuple[np.ndarray, np.ndarray, int]:
+        """Return ``(S, b, n)``; the accumulator can keep receiving rows."""
+
+        if self._handle is not None:
+            S = np.empty((self.dimension, self.dimension), dtype=float)
+            b = np.empty(self.dimension, dtype=float)
+            count = ctypes.c_int64(0)
+            native.check(
+                self._library.hc_design_accumulator_result(
+                    self._handle, _pointer(S), _pointer(b), ctypes.byref(count)
+                )
+            )
+            return S, b, int(count.value)
+        return self._S.copy(), self._b.copy(), self._n
 
-    local = df.copy()
-    local = local.dropna(subset=["yday_frac_solar", "hour_solar", target])
+    def __del__(self) -> None:
+        if getattr(self, "_handle", None) is not None:
+            self._library.hc_design_accumulator_destroy(self._handle)
+            self._handle = None
 
-    local["day"] = local["yday_frac_solar"].astype(float)
-    local["hour"] = np.mod(local["hour_solar"].astype(float), 24.0)
 
-    day = local["day"].to_numpy(dtype=float)
-    hour = local["hour"].to_numpy(dtype=float)
-    y = local[target].to_numpy(dtype=float)
+_UTC_REQUIREMENT_MSG = (
+    "LOYO evaluation runs in UTC and requires hourly UTC timestamps (`DT_UTC` at whole hours)."
+)
 
-    utc_requirement_msg = (
-        "LOYO evaluation runs in UTC and requires hourly UTC timestamps (`DT_UTC` at whole hours)."
-    )
-    if "DT_UTC" not in local.columns:
-        raise KeyError(utc_requirement_msg)
-    utc_series = pd.to_datetime(local["DT_UTC"], utc=True, errors="coerce")
+
+def _utc_grid_keys(utc_values: pd.Series) -> tuple[np.ndarray, np.ndarray]:
+    """No-leap UTC day index (Feb 29 → -1) and UTC hour for each timestamp."""
+
+    utc_series = pd.to_datetime(utc_values, utc=True, errors="coerce")
     if utc_series.isna().any() or not utc_series.equals(utc_series.dt.floor("h")):
-        raise ValueError(utc_requirement_msg)
-    local["DT_UTC"] = utc_series
+        raise ValueError(_UTC_REQUIREMENT_MSG)
     month = np.asarray(utc_series.dt.month, dtype=int)
     day_of_month = np.asarray(utc_series.dt.day, dtype=int)
     hour_utc = np.asarray(utc_series.dt.hour, dtype=int)
@@ -287,39 +449,75 @@ def build_global_linear_matrix(
     feb29_mask = (month == 2) & (day_of_month == 29)
     utc_day_index[feb29_mask] = -1
     utc_hour = hour_utc.astype(int, copy=True)
+    return utc_day_index, utc_hour
 
-    omega = 2.0 * math.pi / 24.0
-    param_names: List[str] = ["c0"]
-    for m in range(1, n_diurnal + 1):
-        param_names.extend([f"a{m}", f"b{m}"])
 
-    X_blocks: List[np.ndarray] = []
-    params_meta: List[Dict[str, int]] = []
-    start_idx = 0
+def _design_inputs(
+    df: pd.DataFrame,
+    target: str,
+) -> tuple[np.ndarray, np.ndarray, np.ndarray, np.ndarray, np.ndarray, np.ndarray]:
+    """Solar day, wrapped solar hour, target, UTC keys and the kept-row mask.
 
-    for name in param_names:
-        n_annual_param = annual_per_param.get(name, default_n_annual)
-        annual_basis = build_annual_basis(day, n_annual_param)
+    Rows with a missing or infinite solar feature or target are dropped, as
+    the native DesignAccumulator skips them, without copying the frame.
+    """
 
-        if name == "c0":
-            block = annual_basis
-        elif name.startswith("a"):
-            harmonic = int(name[1:])
-            block = annual_basis * np.cos(harmonic * omega * hour)[:, None]
-        elif name.startswith("b"):
-            harmonic = int(name[1:])
-            block = annual_basis * np.sin(harmonic * omega * hour)[:, None]
-        else:
-            raise ValueError(f"Unhandled parameter name '{name}'")
+    required_cols = {"yday_frac_solar", "hour_solar", target}
+    missing = required_cols - set(df.columns)
+    if missing:
+        raise KeyError(f"Missing required columns for training: {sorted(missing)}")
 
-        X_blocks.append(block)
-        length = annual_basis.shape[1]
-        params_meta.append(
-            {"name": name, "n_annual": n_annual_param, "start": start_idx, "length": length}
+    day = df["yday_frac_solar"].to_numpy(dtype=float, na_value=np.nan)
+    hour = df["hour_solar"].to_numpy(dtype=float, na_value=np.nan)
+    y = df[target].to_numpy(dtype=float, na_value=np.nan)
+    keep = np.isfinite(day) & np.isfinite(hour) & np.isfinite(y)
+    day = day[keep]
+    hour = np.mod(hour[keep], 24.0)
+    y = y[keep]
+
+    if "DT_UTC" not in df.columns:
+        raise KeyError(_UTC_REQUIREMENT_MSG)
+    utc_day_index, utc_hour = _utc_grid_keys(df["DT_UTC"][keep])
+    return day, hour, y, utc_day_index, utc_hour, keep
+
+
+def build_global_linear_matrix(
+    df: pd.DataFrame,
+    *,
+    n_diurnal: int,
+    annual_per_param: Dict[str, int],
+    default_n_annual: int,
+    target: str,
+) -> tuple[
+    np.ndarray,
+    np.ndarray,
+    List[Dict[str, int]],
+    np.ndarray,
+    np.ndarray,
+]:
+    """Construct the design matrix for the factorized linear model.
+
+    UTC no-leap calendar for evaluation keys: Feb 29 samples are excluded from
+    `(utc_day_index, utc_hour)`. Training itself streams rows through
+    :class:`DesignAccumulator` and never builds this matrix.
+
+    Returns:
+        (
+            X,
+            y,
+            params_meta,
+            utc_day_index,
+            utc_hour,
         )
-        start_idx += length
+    """
 
-    X = np.concatenate(X_blocks, axis=1)
+    day, hour, y, utc_day_index, utc_hour, _ = _design_inputs(df, target)
+    params_meta = build_params_meta(
+        n_diurnal=n_diurnal,
+        annual_per_param=annual_per_param,
+        default_n_annual=default_n_annual,
+    )
+    X = build_design_block(day, hour, params_meta)
     return X, y, params_meta, utc_day_index, utc_hour
 
 
@@ -350,8 +548,13 @@ def compute_sufficient_stats(
     n_diurnal: int,
     default_n_annual: int,
     annual_per_param: Dict[str, int] | None,
+    threads: int | None = None,
 ) -> List[YearlyDesignStats]:
-    """Compute per-year design matrices and sufficient statistics."""
+    """Compute per-year sufficient statistics ``S = XᵀX`` and ``b = Xᵀy``.
+
+    Rows are streamed through :class:`DesignAccumulator`; only the solar
+    features, the target and the UTC keys are kept per year.
+    """
 
     if target not in df.columns:
         raise KeyError(f"Target column '{target}' is missing from the training frame.")
@@ -359,45 +562,42 @@ def compute_sufficient_stats(
         raise KeyError("Training frame is missing the 'year' column; call prepare_training_frame.")
 
     annual_per_param = dict(annual_per_param or {})
-    stats: List[YearlyDesignStats] = []
+    params_meta = build_params_meta(
+        n_diurnal=n_diurnal,
+        annual_per_param=annual_per_param,
+        default_n_annual=default_n_annual,
+    )
+    day, hour, y, utc_day_index, utc_hour, keep = _design_inputs(df, target)
+    years = df["year"].to_numpy()[keep].astype(int)
 
-    for year, group in df.groupby("year"):
-        if group.empty:
-            continue
+    # Stable sort: each year keeps its rows in frame order.
+    order = np.argsort(years, kind="stable")
+    unique_years, starts = np.unique(years[order], return_index=True)
+    bounds = list(starts) + [order.size]
 
-        (
-            X,
-            y,
-            meta,
-            utc_day_index,
-            utc_hour,
-        ) = build_global_linear_matrix(
-            group,
-            n_diurnal=n_diurnal,
-            annual_per_param=annual_per_param,
-            default_n_annual=default_n_annual,
-            target=target,
-        )
-        if y.size == 0 or X.size == 0:
+    stats: List[YearlyDesignStats] = []
+    for index, year in enumerate(unique_years):
+        rows = order[bounds[index] : bounds[index + 1]]
+        if rows.size == 0:
             continue
+        year_day, year_hour, year_y = day[rows], hour[rows], y[rows]
 
-        X = np.asarray(X, dtype=float)
-        y = np.asarray(y, dtype=float)
-
-        S = X.T @ X
-        b = X.T @ y
+        accumulator = DesignAccumulator(params_meta, threads=threads)
+        accumulator.add(year_day, year_hour, year_y)
+        S, b, n = accumulator.result()
 
         stats.append(
             YearlyDesignStats(
                 year=int(year),
-                X=X,
-                y=y,
+                day=year_day,
+                hour=year_hour,
+                y=year_y,
                 S=S,
                 b=b,
-                n=int(y.size),
-                utc_day_index=utc_day_index.astype(int, copy=False),
-                utc_hour=utc_hour.astype(int, copy=False),
-                params_meta=[dict(entry) for entry in meta],
+                n=int(n),
+                utc_day_index=utc_day_index[rows],
+                utc_hour=utc_hour[rows],
+                params_meta=[dict(entry) for entry in params_meta],
             )
         )
 
@@ -427,7 +627,7 @@ def fit_from_stats(
 
     residuals: List[np.ndarray] = []
     for entry in stats:
-        y_pred = entry.X @ coefficients
+        y_pred = entry.predict(coefficients)
         valid_mask = np.isfinite(entry.y) & np.isfinite(y_pred)
         if np.any(valid_mask):
             residuals.append(entry.y[valid_mask] - y_pred[valid_mask])
@@ -581,15 +781,19 @@ __all__ = [
     "ErrorMetrics",
     "LeaveOneYearOutReport",
     "LinearModelFit",
+    "DesignAccumulator",
     "ParameterLayout",
     "TrainingResult",
     "YearlyDesignStats",
     "YearlyValidationMetrics",
     "build_annual_basis",
+    "build_design_block",
     "build_global_linear_matrix",
     "build_parameter_payload",
+    "build_params_meta",
     "compute_sufficient_stats",
     "fit_from_stats",
+    "predict_design",
     "prepare_training_frame",
     "solve_normal_equations",
     "train_models",